@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# Runs AdvancedSettings several times per --page-loading mode and prints the
+# median first overlay frame time and resident memory of each mode, and for
+# preload the median time and resident memory once all pages are created.
+#
+# Usage: measure_startup.sh <AdvancedSettings binary> [runs] [extra args...]
+#
+# SteamVR (or the OpenVR stub through LD_LIBRARY_PATH) has to be running
+# the overlay for the first frame to be submitted. Each run is stopped once
+# the last line it waits for is logged, or after STARTUP_TIMEOUT seconds.
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <AdvancedSettings binary> [runs] [extra args...]"
+    exit 1
+fi
+binary=$1
+runs=${2:-5}
+shift $(( $# < 2 ? $# : 2 ))
+timeout=${STARTUP_TIMEOUT:-60}
+
+median() {
+    sort -n | awk '{ v[NR] = $1 } END {
+        if ( NR == 0 ) { print "-"; exit }
+        if ( NR % 2 ) { print v[( NR + 1 ) / 2] }
+        else { print ( v[NR / 2] + v[NR / 2 + 1] ) / 2 } }'
+}
+
+# Prints "<ms> <MiB>" of the first log line matching $2 in file $1.
+extract() {
+    grep -m 1 "$2" "$1" \
+        | sed -n 's/.* \([0-9]*\) ms after start, resident memory \([0-9]*\) MiB.*/\1 \2/p'
+}
+
+printf '%-8s %5s %14s %14s %14s %14s\n' mode runs "first ms" "first MiB" \
+    "preloaded ms" "preloaded MiB"
+
+for mode in eager lazy preload; do
+    waitFor="First overlay frame submitted"
+    if [ "$mode" = preload ]; then
+        waitFor="Dashboard pages preloaded"
+    fi
+    firstMs=(); firstMib=(); preMs=(); preMib=()
+    for (( run = 0; run < runs; ++run )); do
+        log=$(mktemp)
+        "$binary" --page-loading "$mode" "$@" > "$log" 2>&1 &
+        pid=$!
+        for (( waited = 0; waited < timeout * 10; ++waited )); do
+            if grep -q "$waitFor" "$log" || ! kill -0 $pid 2> /dev/null; then
+                break
+            fi
+            sleep 0.1
+        done
+        kill $pid 2> /dev/null || true
+        wait $pid 2> /dev/null || true
+
+        read -r ms mib <<< "$(extract "$log" "First overlay frame submitted")"
+        if [ -z "$ms" ]; then
+            echo "$mode run $run: no first overlay frame logged, see $log"
+            continue
+        fi
+        firstMs+=("$ms"); firstMib+=("$mib")
+        read -r ms mib <<< "$(extract "$log" "Dashboard pages preloaded")"
+        if [ -n "$ms" ]; then
+            preMs+=("$ms"); preMib+=("$mib")
+        fi
+        rm -f "$log"
+    done
+
+    printf '%-8s %5s %14s %14s %14s %14s\n' "$mode" "${#firstMs[@]}" \
+        "$(printf '%s\n' "${firstMs[@]}" | grep . | median)" \
+        "$(printf '%s\n' "${firstMib[@]}" | grep . | median)" \
+        "$(printf '%s\n' "${preMs[@]}" | grep . | median)" \
+        "$(printf '%s\n' "${preMib[@]}" | grep . | median)"
+done
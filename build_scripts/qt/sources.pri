@@ -18,6 +18,7 @@ SOURCES += src/main.cpp\
 	src/openvr/ovr_system_wrapper.cpp \
 	src/openvr/lh_console_util.cpp \
 	src/openvr/ovr_application_wrapper.cpp \
+    src/openvr/ovr_recorded_queries.cpp \
     src/utils/setup.cpp \
     src/utils/paths.cpp \
     src/utils/FrameRateUtils.cpp \
@@ -27,6 +28,23 @@ SOURCES += src/main.cpp\
     src/settings/settings_object.cpp \
     src/alarm_clock/vr_alarm.cpp \
     src/utils/update_rate.cpp \
+    src/utils/vsync_tick_thread.cpp \
+    src/utils/frame_profiler.cpp \
+    src/utils/tick_recording.cpp \
+    src/utils/background_worker.cpp \
+    src/utils/frame_budget_governor.cpp \
+    src/utils/frame_context.cpp \
+    src/utils/controller_roles.cpp \
+    src/utils/startup_metrics.cpp \
+    src/utils/overlay_renderer.cpp \
+    src/utils/render_throttle.cpp \
+    src/utils/startup_trace.cpp \
+    src/utils/overlay_image_cache.cpp \
+    src/utils/dashboard_benchmark.cpp \
+    src/utils/scheduling_policy.cpp \
+    src/utils/scheduling_benchmark.cpp \
+    src/utils/chaperone_segments.cpp \
+    src/utils/chaperone_segment_tree.cpp \
 
 
 
@@ -58,6 +76,7 @@ HEADERS += src/overlaycontroller.h \
 	src/openvr/ovr_system_wrapper.h \
 	src/openvr/ovr_application_wrapper.h \
 	src/openvr/lh_console_util.h \
+    src/openvr/ovr_recorded_queries.h \
     src/utils/setup.h \
     src/utils/paths.h \
     src/utils/FrameRateUtils.h \
@@ -74,6 +93,27 @@ HEADERS += src/overlaycontroller.h \
     src/settings/internal/settings_object_data.h \
     src/settings/internal/settings_object_data.h \
     src/utils/update_rate.h \
+    src/utils/vsync_tick_thread.h \
+    src/utils/frame_profiler.h \
+    src/utils/tick_recording.h \
+    src/utils/spsc_queue.h \
+    src/utils/background_worker.h \
+    src/utils/frame_budget_governor.h \
+    src/utils/frame_context.h \
+    src/utils/controller_roles.h \
+    src/utils/startup_metrics.h \
+    src/utils/overlay_renderer.h \
+    src/utils/overlay_render_control.h \
+    src/utils/render_throttle.h \
+    src/utils/startup_trace.h \
+    src/utils/overlay_image_cache.h \
+    src/utils/dashboard_benchmark.h \
+    src/utils/change_coalescer.h \
+    src/utils/mouse_move_coalescer.h \
+    src/utils/scheduling_policy.h \
+    src/utils/scheduling_benchmark.h \
+    src/utils/chaperone_segments.h \
+    src/utils/chaperone_segment_tree.h \
 
 
 win32 {
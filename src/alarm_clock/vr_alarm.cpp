@@ -3,6 +3,7 @@
 #include "vr_alarm.h"
 #include "../openvr/ovr_overlay_wrapper.h"
 #include "../utils/update_rate.h"
+#include "../utils/scheduling_policy.h"
 
 namespace alarm_clock
 {
@@ -37,8 +38,7 @@ VrAlarm::VrAlarm()
 
 void VrAlarm::eventLoopTick()
 {
-    if ( updateRate.shouldSubjectNotRun(
-             UpdateSubject::UtilitiesTabController ) )
+    if ( updateRate.shouldSubjectNotRun( UpdateSubject::AlarmClock ) )
     {
         return;
     }
@@ -83,6 +83,7 @@ void VrAlarm::checkAlarmStatus()
 
         std::thread t(
             []( vr::VROverlayHandle_t overlayHandle ) {
+                utils::applyThreadRole( utils::ThreadRole::Background );
                 // This will freeze the overlay for 3 seconds
                 std::this_thread::sleep_for( std::chrono::seconds( 3 ) );
                 ovr_overlay_wrapper::hideOverlay( overlayHandle );
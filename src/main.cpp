@@ -1,4 +1,9 @@
 #include "utils/setup.h"
+#include "utils/startup_metrics.h"
+#include "utils/startup_trace.h"
+#include "utils/dashboard_benchmark.h"
+#include "utils/scheduling_benchmark.h"
+#include "utils/scheduling_policy.h"
 #include "settings/settings.h"
 #include "openvr/ovr_settings_wrapper.h"
 #ifdef _WIN64
@@ -12,13 +17,34 @@ INITIALIZE_EASYLOGGINGPP
 
 int main( int argc, char* argv[] )
 {
+    utils::markProcessStart();
+    // Collected before the command line is parsed, only written if
+    // --trace-startup was given.
+    utils::StartupSpan startupSpan( "startup" );
+    utils::StartupSpan stageSpan( "setUpLogging" );
     setUpLogging();
 
+    stageSpan.next( "settings::initializeAndGetSettingsPath" );
     LOG( INFO ) << "Settings File: "
                 << settings::initializeAndGetSettingsPath();
 
     LOG( INFO ) << settings::getSettingsAndValues();
 
+    // Before QApplication, so every thread inherits the CPU mask.
+    const auto lowPriorityCpus = utils::parseCpuList( settings::getSetting(
+        settings::StringSetting::APPLICATION_lowPriorityCpus ) );
+    if ( !lowPriorityCpus )
+    {
+        LOG( ERROR ) << "Invalid low priority CPU list, not pinning.";
+    }
+    if ( settings::getSetting(
+             settings::BoolSetting::APPLICATION_lowPriorityMode ) )
+    {
+        utils::enableLowPriorityMode(
+            lowPriorityCpus.value_or( std::vector<unsigned>{} ) );
+    }
+
+    stageSpan.next( "QApplication" );
     QCoreApplication::setAttribute( Qt::AA_Use96Dpi );
     QCoreApplication::setAttribute( Qt::AA_UseDesktopOpenGL );
     MyQApplication mainEventLoop( argc, argv );
@@ -32,8 +58,28 @@ int main( int argc, char* argv[] )
 
     qInstallMessageHandler( mainQtMessageHandler );
 
+    stageSpan.next( "argument::returnCommandLineParser" );
     const auto commandLineArgs
         = argument::returnCommandLineParser( mainEventLoop );
+    stageSpan.end();
+
+    if ( commandLineArgs.benchmarkSchedulingSeconds > 0 )
+    {
+        return utils::runSchedulingBenchmark(
+                   commandLineArgs.benchmarkSchedulingSeconds,
+                   lowPriorityCpus.value_or( std::vector<unsigned>{} ),
+                   commandLineArgs.benchmarkCsvPath )
+                   ? ReturnErrorCode::SUCCESS
+                   : ReturnErrorCode::GENERAL_FAILURE;
+    }
+
+    const bool benchmarkDashboard
+        = commandLineArgs.benchmarkDashboardFrames > 0;
+    if ( benchmarkDashboard )
+    {
+        // Has to be chosen before the first QQuickWindow is created.
+        QQuickWindow::setSceneGraphBackend( QSGRendererInterface::Software );
+    }
 
     // It is important that either install_manifest or remove_manifest are true,
     // otherwise the handleManifests function will not behave properly.
@@ -44,16 +90,20 @@ int main( int argc, char* argv[] )
                                    commandLineArgs.forceRemoveManifest );
     }
 
+    stageSpan.next( "openvr_init::initializeOpenVR" );
     openvr_init::initializeOpenVR(
         openvr_init::OpenVrInitializationType::Overlay );
 
     try
     {
+        stageSpan.next( "QQmlEngine" );
         QQmlEngine qmlEngine;
 
-        advsettings::OverlayController controller( commandLineArgs.desktopMode,
-                                                   commandLineArgs.forceNoSound,
-                                                   qmlEngine );
+        stageSpan.next( "OverlayController" );
+        advsettings::OverlayController controller(
+            commandLineArgs.desktopMode || benchmarkDashboard,
+            commandLineArgs.forceNoSound,
+            qmlEngine );
 
         constexpr auto widgetPath = "res/qml/common/mainwidget.qml";
         const auto path = paths::binaryDirectoryFindFile( widgetPath );
@@ -68,6 +118,7 @@ int main( int argc, char* argv[] )
         const auto url
             = QUrl::fromLocalFile( QString::fromStdString( ( *path ) ) );
 
+        stageSpan.next( "QQmlComponent load" );
         QQmlComponent component( &qmlEngine, url );
         auto errors = component.errors();
         for ( auto& e : errors )
@@ -75,12 +126,40 @@ int main( int argc, char* argv[] )
             LOG( ERROR ) << "QML Error: " << e.toString().toStdString()
                          << std::endl;
         }
-        auto quickObj = component.create();
+        stageSpan.next( "QQmlComponent create" );
+        auto quickObj = component.beginCreate( qmlEngine.rootContext() );
+        if ( quickObj )
+        {
+            quickObj->setProperty(
+                "pageLoading",
+                QString::fromStdString( commandLineArgs.pageLoading ) );
+            component.completeCreate();
+        }
+
+        if ( benchmarkDashboard )
+        {
+            // The pages show what the controllers read from the runtime,
+            // the overlay itself and the tick are never started.
+            controller.initTabControllers();
+            const auto root = qobject_cast<QQuickItem*>( quickObj );
+            if ( !root
+                 || !utils::runDashboardBenchmark(
+                     *root,
+                     commandLineArgs.benchmarkDashboardFrames,
+                     commandLineArgs.benchmarkCsvPath ) )
+            {
+                return ReturnErrorCode::GENERAL_FAILURE;
+            }
+            return ReturnErrorCode::SUCCESS;
+        }
+
+        stageSpan.next( "OverlayController::SetWidget" );
         controller.SetWidget( qobject_cast<QQuickItem*>( quickObj ),
                               application_strings::applicationDisplayName,
                               application_strings::applicationKey );
 
         // Attempts to install the application manifest on all "regular" starts.
+        stageSpan.next( "manifest::installApplicationManifest" );
         if ( !commandLineArgs.forceNoManifest )
         {
             try
@@ -103,6 +182,8 @@ int main( int argc, char* argv[] )
             }
         }
 
+        stageSpan.end();
+
         if ( commandLineArgs.desktopMode
              || settings::getSetting(
                  settings::BoolSetting::APPLICATION_desktopModeToggle ) )
@@ -125,6 +206,34 @@ int main( int argc, char* argv[] )
             ovr_settings_wrapper::resetAllSettings();
         }
 
+        if ( !commandLineArgs.recordTicksPath.empty() )
+        {
+            utils::tickRecording.startRecording(
+                commandLineArgs.recordTicksPath );
+        }
+        else if ( !commandLineArgs.replayTicksPath.empty()
+                  && !controller.startTickReplay(
+                      commandLineArgs.replayTicksPath ) )
+        {
+            return ReturnErrorCode::GENERAL_FAILURE;
+        }
+
+        startupSpan.end();
+        if ( commandLineArgs.traceStartupPath.empty() )
+        {
+            utils::discardStartupTrace();
+        }
+        else if ( utils::writeStartupTrace( commandLineArgs.traceStartupPath ) )
+        {
+            LOG( INFO ) << "Startup trace written to '"
+                        << commandLineArgs.traceStartupPath << "'.";
+        }
+        else
+        {
+            LOG( ERROR ) << "Could not write startup trace to '"
+                         << commandLineArgs.traceStartupPath << "'.";
+        }
+
         return mainEventLoop.exec();
     }
     catch ( const std::exception& e )
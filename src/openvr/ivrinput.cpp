@@ -1,5 +1,6 @@
 #include "ivrinput.h"
 #include "ivrinput_action.h"
+#include "../utils/tick_recording.h"
 #include <openvr.h>
 #include <iostream>
 #include <array>
@@ -20,21 +21,27 @@ function and passed as reference, or created in this function.
 */
 vr::InputDigitalActionData_t getDigitalActionData( DigitalAction& action )
 {
-    vr::InputDigitalActionData_t handleData = {};
+    return utils::tickRecording.query(
+        action.name(),
+        0,
+        [&action]
+        {
+            vr::InputDigitalActionData_t handleData = {};
 
-    const auto error = vr::VRInput()->GetDigitalActionData(
-        action.handle(),
-        &handleData,
-        sizeof( handleData ),
-        vr::k_ulInvalidInputValueHandle );
+            const auto error = vr::VRInput()->GetDigitalActionData(
+                action.handle(),
+                &handleData,
+                sizeof( handleData ),
+                vr::k_ulInvalidInputValueHandle );
 
-    if ( error != vr::EVRInputError::VRInputError_None )
-    {
-        LOG( ERROR ) << "Error getting IVRInput Digital Action Data for handle "
-                     << action.name() << ". SteamVR Error: " << error;
-    }
-
-    return handleData;
+            if ( error != vr::EVRInputError::VRInputError_None )
+            {
+                LOG( ERROR )
+                    << "Error getting IVRInput Digital Action Data for handle "
+                    << action.name() << ". SteamVR Error: " << error;
+            }
+            return handleData;
+        } );
 }
 
 /*!
@@ -50,21 +57,60 @@ function and passed as reference, or created in this function.
 */
 vr::InputAnalogActionData_t getAnalogActionData( AnalogAction& action )
 {
-    vr::InputAnalogActionData_t handleData = {};
+    return utils::tickRecording.query(
+        action.name(),
+        0,
+        [&action]
+        {
+            vr::InputAnalogActionData_t handleData = {};
 
-    const auto error
-        = vr::VRInput()->GetAnalogActionData( action.handle(),
-                                              &handleData,
-                                              sizeof( handleData ),
-                                              vr::k_ulInvalidInputValueHandle );
+            const auto error = vr::VRInput()->GetAnalogActionData(
+                action.handle(),
+                &handleData,
+                sizeof( handleData ),
+                vr::k_ulInvalidInputValueHandle );
 
-    if ( error != vr::EVRInputError::VRInputError_None )
-    {
-        LOG( ERROR ) << "Error getting IVRInput Digital Action Data for handle "
-                     << action.name() << ". SteamVR Error: " << error;
-    }
+            if ( error != vr::EVRInputError::VRInputError_None )
+            {
+                LOG( ERROR )
+                    << "Error getting IVRInput Analog Action Data for handle "
+                    << action.name() << ". SteamVR Error: " << error;
+            }
+            return handleData;
+        } );
+}
 
-    return handleData;
+/*!
+Wrapper around the IVRInput GetPoseActionDataForNextFrame with error handling.
+The universe is part of the recorded query, the same action can be asked for
+in more than one.
+*/
+vr::InputPoseActionData_t
+    getPoseActionData( PoseAction& action,
+                       const vr::ETrackingUniverseOrigin universe )
+{
+    return utils::tickRecording.query(
+        action.name(),
+        static_cast<uint32_t>( universe ),
+        [&action, universe]
+        {
+            vr::InputPoseActionData_t handleData = {};
+
+            const auto error = vr::VRInput()->GetPoseActionDataForNextFrame(
+                action.handle(),
+                universe,
+                &handleData,
+                sizeof( handleData ),
+                vr::k_ulInvalidInputValueHandle );
+
+            if ( error != vr::EVRInputError::VRInputError_None )
+            {
+                LOG( ERROR )
+                    << "Error getting IVRInput Pose Action Data for handle "
+                    << action.name() << ". SteamVR Error: " << error;
+            }
+            return handleData;
+        } );
 }
 
 /*!
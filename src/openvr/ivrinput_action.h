@@ -14,6 +14,7 @@ enum class ActionType
     Undefined,
     Digital,
     Analog,
+    Pose,
     Haptic,
 };
 
@@ -44,7 +45,7 @@ class Action
     /*!
     The actions manfiest name of the action. Used for error reporting.
     */
-    std::string name() const noexcept
+    const std::string& name() const noexcept
     {
         return m_name;
     }
@@ -66,4 +67,10 @@ class AnalogAction : public Action
     AnalogAction( const char* const actionName ) : Action( actionName ) {}
 };
 
+class PoseAction : public Action
+{
+public:
+    PoseAction( const char* const actionName ) : Action( actionName ) {}
+};
+
 } // namespace input
@@ -1,4 +1,5 @@
 #include "ovr_overlay_wrapper.h"
+#include "../utils/overlay_image_cache.h"
 
 namespace ovr_overlay_wrapper
 {
@@ -78,14 +79,15 @@ OverlayError setOverlayFromFile( vr::VROverlayHandle_t overlayHandle,
                                  std::string customErrorMsg )
 {
     {
-        const auto overlayPath = paths::binaryDirectoryFindFile( fileName );
-        if ( !overlayPath.has_value() )
+        // Decoded once, later calls for the same file skip the disk.
+        const auto result = utils::overlayImageCache.setOverlayImage(
+            overlayHandle, fileName );
+        if ( !result.has_value() )
         {
             LOG( ERROR ) << "File not Found: " << fileName << customErrorMsg;
             return OverlayError::UndefinedError;
         }
-        vr::VROverlayError oError = vr::VROverlay()->SetOverlayFromFile(
-            overlayHandle, overlayPath->c_str() );
+        vr::VROverlayError oError = *result;
         if ( oError != vr::VROverlayError_None )
         {
             LOG( ERROR ) << "Error setting Overlay from file For "
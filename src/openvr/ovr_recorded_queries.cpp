@@ -0,0 +1,415 @@
+#include "ovr_recorded_queries.h"
+#include "../utils/tick_recording.h"
+
+namespace ovr_recorded_queries
+{
+namespace
+{
+    template <typename T, typename Error> struct WithError
+    {
+        T value;
+        Error error;
+    };
+
+    // Properties are told apart by device and property.
+    uint32_t propertyIndex( const uint32_t deviceIndex,
+                            const vr::TrackedDeviceProperty property )
+    {
+        return static_cast<uint32_t>( property ) * 64 + deviceIndex;
+    }
+
+    // Settings and applications are told apart by name, which is only worth
+    // building when the query can end up in a recording.
+    bool namesNeeded()
+    {
+        return utils::tickRecording.mode() != utils::TickRecordingMode::Off;
+    }
+
+    std::string settingName( const char* query,
+                             const std::string& section,
+                             const std::string& key )
+    {
+        if ( !namesNeeded() )
+        {
+            return std::string();
+        }
+        return std::string( query ) + '/' + section + '/' + key;
+    }
+
+    template <typename T, typename Error, typename Query>
+    T queryWithError( const std::string& name,
+                      const uint32_t index,
+                      Error* error,
+                      Query&& query )
+    {
+        const auto result = utils::tickRecording.query(
+            name,
+            index,
+            [&query]
+            {
+                WithError<T, Error> r{};
+                r.value = query( &r.error );
+                return r;
+            } );
+        if ( error )
+        {
+            *error = result.error;
+        }
+        return result.value;
+    }
+
+    template <typename Error, typename Query>
+    std::string queryStringWithError( const std::string& name,
+                                      const uint32_t index,
+                                      Error* error,
+                                      Query&& query )
+    {
+        // The string and the error are recorded as two queries, the second
+        // one hands out what the first one got from the runtime.
+        Error queried{};
+        auto value = utils::tickRecording.query(
+            name, index, [&query, &queried] { return query( &queried ); } );
+        const auto recorded = utils::tickRecording.query(
+            namesNeeded() ? name + "/error" : std::string(),
+            index,
+            [&queried] { return queried; } );
+        if ( error )
+        {
+            *error = recorded;
+        }
+        return value;
+    }
+
+    std::vector<vr::HmdQuad_t>
+        collisionBounds( const char* name,
+                         bool ( vr::IVRChaperoneSetup::*getBounds )(
+                             vr::HmdQuad_t*, uint32_t* ) )
+    {
+        return utils::tickRecording.query(
+            name,
+            0,
+            [getBounds]
+            {
+                std::vector<vr::HmdQuad_t> quads;
+                auto setup = vr::VRChaperoneSetup();
+                uint32_t count = 0;
+                ( setup->*getBounds )( nullptr, &count );
+                quads.resize( count );
+                if ( count && !( setup->*getBounds )( quads.data(), &count ) )
+                {
+                    count = 0;
+                }
+                quads.resize( count );
+                return quads;
+            } );
+    }
+} // namespace
+
+DevicePoses devicePoses( const vr::ETrackingUniverseOrigin universe )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::GetDeviceToAbsoluteTrackingPose",
+        static_cast<uint32_t>( universe ),
+        [universe]
+        {
+            DevicePoses poses;
+            vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
+                universe, 0.0f, poses.data(), vr::k_unMaxTrackedDeviceCount );
+            return poses;
+        } );
+}
+
+vr::EDeviceActivityLevel deviceActivityLevel( const uint32_t deviceIndex )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::GetTrackedDeviceActivityLevel",
+        deviceIndex,
+        [deviceIndex] {
+            return vr::VRSystem()->GetTrackedDeviceActivityLevel(
+                deviceIndex );
+        } );
+}
+
+vr::VRControllerState_t controllerState( const uint32_t deviceIndex )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::GetControllerState",
+        deviceIndex,
+        [deviceIndex]
+        {
+            vr::VRControllerState_t state{};
+            if ( !vr::VRSystem()->GetControllerState(
+                     deviceIndex, &state, sizeof( state ) ) )
+            {
+                state = vr::VRControllerState_t{};
+            }
+            return state;
+        } );
+}
+
+vr::ETrackedDeviceClass deviceClass( const uint32_t deviceIndex )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::GetTrackedDeviceClass",
+        deviceIndex,
+        [deviceIndex]
+        { return vr::VRSystem()->GetTrackedDeviceClass( deviceIndex ); } );
+}
+
+bool deviceConnected( const uint32_t deviceIndex )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::IsTrackedDeviceConnected",
+        deviceIndex,
+        [deviceIndex]
+        { return vr::VRSystem()->IsTrackedDeviceConnected( deviceIndex ); } );
+}
+
+vr::TrackedDeviceIndex_t
+    indexForControllerRole( const vr::ETrackedControllerRole role )
+{
+    return utils::tickRecording.query(
+        "IVRSystem::GetTrackedDeviceIndexForControllerRole",
+        static_cast<uint32_t>( role ),
+        [role] {
+            return vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
+                role );
+        } );
+}
+
+bool boolProperty( const uint32_t deviceIndex,
+                   const vr::TrackedDeviceProperty property,
+                   vr::ETrackedPropertyError* error )
+{
+    return queryWithError<bool>(
+        "IVRSystem::GetBoolTrackedDeviceProperty",
+        propertyIndex( deviceIndex, property ),
+        error,
+        [deviceIndex, property]( vr::ETrackedPropertyError* e )
+        {
+            return vr::VRSystem()->GetBoolTrackedDeviceProperty(
+                deviceIndex, property, e );
+        } );
+}
+
+int32_t int32Property( const uint32_t deviceIndex,
+                       const vr::TrackedDeviceProperty property,
+                       vr::ETrackedPropertyError* error )
+{
+    return queryWithError<int32_t>(
+        "IVRSystem::GetInt32TrackedDeviceProperty",
+        propertyIndex( deviceIndex, property ),
+        error,
+        [deviceIndex, property]( vr::ETrackedPropertyError* e )
+        {
+            return vr::VRSystem()->GetInt32TrackedDeviceProperty(
+                deviceIndex, property, e );
+        } );
+}
+
+float floatProperty( const uint32_t deviceIndex,
+                     const vr::TrackedDeviceProperty property,
+                     vr::ETrackedPropertyError* error )
+{
+    return queryWithError<float>(
+        "IVRSystem::GetFloatTrackedDeviceProperty",
+        propertyIndex( deviceIndex, property ),
+        error,
+        [deviceIndex, property]( vr::ETrackedPropertyError* e )
+        {
+            return vr::VRSystem()->GetFloatTrackedDeviceProperty(
+                deviceIndex, property, e );
+        } );
+}
+
+std::string stringProperty( const uint32_t deviceIndex,
+                            const vr::TrackedDeviceProperty property,
+                            vr::ETrackedPropertyError* error )
+{
+    return queryStringWithError(
+        "IVRSystem::GetStringTrackedDeviceProperty",
+        propertyIndex( deviceIndex, property ),
+        error,
+        [deviceIndex, property]( vr::ETrackedPropertyError* e )
+        {
+            // This appears to be correct value as set in CVRSettingHelper as
+            // of ovr 1.11.11
+            char value[4096] = {};
+            vr::VRSystem()->GetStringTrackedDeviceProperty(
+                deviceIndex, property, value, sizeof( value ), e );
+            return std::string( value );
+        } );
+}
+
+vr::ETrackingUniverseOrigin trackingSpace()
+{
+    return utils::tickRecording.query(
+        "IVRCompositor::GetTrackingSpace",
+        0,
+        [] { return vr::VRCompositor()->GetTrackingSpace(); } );
+}
+
+vr::Compositor_CumulativeStats cumulativeStats()
+{
+    return utils::tickRecording.query(
+        "IVRCompositor::GetCumulativeStats",
+        0,
+        []
+        {
+            vr::Compositor_CumulativeStats stats{};
+            vr::VRCompositor()->GetCumulativeStats(
+                &stats, sizeof( vr::Compositor_CumulativeStats ) );
+            return stats;
+        } );
+}
+
+bool dashboardVisible()
+{
+    return utils::tickRecording.query(
+        "IVROverlay::IsDashboardVisible",
+        0,
+        [] { return vr::VROverlay()->IsDashboardVisible(); } );
+}
+
+std::string keyboardText()
+{
+    return utils::tickRecording.query( "IVROverlay::GetKeyboardText",
+                                       0,
+                                       []
+                                       {
+                                           char text[1024] = {};
+                                           vr::VROverlay()->GetKeyboardText(
+                                               text, sizeof( text ) );
+                                           return std::string( text );
+                                       } );
+}
+
+uint32_t applicationProcessId( const char* appKey )
+{
+    const auto name
+        = namesNeeded()
+              ? std::string( "IVRApplications::GetApplicationProcessId/" )
+                    + appKey
+              : std::string();
+    return utils::tickRecording.query(
+        name,
+        0,
+        [appKey]
+        { return vr::VRApplications()->GetApplicationProcessId( appKey ); } );
+}
+
+vr::ChaperoneCalibrationState calibrationState()
+{
+    return utils::tickRecording.query(
+        "IVRChaperone::GetCalibrationState",
+        0,
+        [] { return vr::VRChaperone()->GetCalibrationState(); } );
+}
+
+vr::HmdMatrix34_t workingStandingZeroPose()
+{
+    return utils::tickRecording.query(
+        "IVRChaperoneSetup::GetWorkingStandingZeroPoseToRawTrackingPose",
+        0,
+        []
+        {
+            vr::HmdMatrix34_t pose{};
+            vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
+                &pose );
+            return pose;
+        } );
+}
+
+vr::HmdMatrix34_t workingSeatedZeroPose()
+{
+    return utils::tickRecording.query(
+        "IVRChaperoneSetup::GetWorkingSeatedZeroPoseToRawTrackingPose",
+        0,
+        []
+        {
+            vr::HmdMatrix34_t pose{};
+            vr::VRChaperoneSetup()->GetWorkingSeatedZeroPoseToRawTrackingPose(
+                &pose );
+            return pose;
+        } );
+}
+
+std::vector<vr::HmdQuad_t> workingCollisionBounds()
+{
+    return collisionBounds(
+        "IVRChaperoneSetup::GetWorkingCollisionBoundsInfo",
+        &vr::IVRChaperoneSetup::GetWorkingCollisionBoundsInfo );
+}
+
+std::vector<vr::HmdQuad_t> liveCollisionBounds()
+{
+    return collisionBounds(
+        "IVRChaperoneSetup::GetLiveCollisionBoundsInfo",
+        &vr::IVRChaperoneSetup::GetLiveCollisionBoundsInfo );
+}
+
+bool settingBool( const std::string& section,
+                  const std::string& key,
+                  vr::EVRSettingsError* error )
+{
+    return queryWithError<bool>(
+        settingName( "IVRSettings::GetBool", section, key ),
+        0,
+        error,
+        [&section, &key]( vr::EVRSettingsError* e )
+        {
+            return vr::VRSettings()->GetBool(
+                section.c_str(), key.c_str(), e );
+        } );
+}
+
+int32_t settingInt32( const std::string& section,
+                      const std::string& key,
+                      vr::EVRSettingsError* error )
+{
+    return queryWithError<int32_t>(
+        settingName( "IVRSettings::GetInt32", section, key ),
+        0,
+        error,
+        [&section, &key]( vr::EVRSettingsError* e )
+        {
+            return vr::VRSettings()->GetInt32(
+                section.c_str(), key.c_str(), e );
+        } );
+}
+
+float settingFloat( const std::string& section,
+                    const std::string& key,
+                    vr::EVRSettingsError* error )
+{
+    return queryWithError<float>(
+        settingName( "IVRSettings::GetFloat", section, key ),
+        0,
+        error,
+        [&section, &key]( vr::EVRSettingsError* e )
+        {
+            return vr::VRSettings()->GetFloat(
+                section.c_str(), key.c_str(), e );
+        } );
+}
+
+std::string settingString( const std::string& section,
+                           const std::string& key,
+                           vr::EVRSettingsError* error )
+{
+    return queryStringWithError(
+        settingName( "IVRSettings::GetString", section, key ),
+        0,
+        error,
+        [&section, &key]( vr::EVRSettingsError* e )
+        {
+            // This appears to be correct value as set in CVRSettingHelper as
+            // of ovr 1.11.11
+            char value[4096] = {};
+            vr::VRSettings()->GetString(
+                section.c_str(), key.c_str(), value, sizeof( value ), e );
+            return std::string( value );
+        } );
+}
+
+} // namespace ovr_recorded_queries
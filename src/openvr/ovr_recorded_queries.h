@@ -0,0 +1,74 @@
+#pragma once
+
+#include <openvr.h>
+#include <array>
+#include <string>
+#include <vector>
+
+/* Runtime queries made while a tick runs, through utils::TickRecording.
+ *
+ * Every function returns what the runtime answers, records it while
+ * --record-ticks is active and serves the recorded answer while replaying
+ * --replay-ticks, without calling the runtime at all. Code that runs as part
+ * of mainEventLoop should read runtime state through here (or through the
+ * ovr_*_wrapper getters, which use these) so that replays are complete.
+ */
+namespace ovr_recorded_queries
+{
+using DevicePoses
+    = std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount>;
+
+// IVRSystem
+DevicePoses devicePoses( const vr::ETrackingUniverseOrigin universe );
+vr::EDeviceActivityLevel deviceActivityLevel( const uint32_t deviceIndex );
+vr::VRControllerState_t controllerState( const uint32_t deviceIndex );
+vr::ETrackedDeviceClass deviceClass( const uint32_t deviceIndex );
+bool deviceConnected( const uint32_t deviceIndex );
+vr::TrackedDeviceIndex_t
+    indexForControllerRole( const vr::ETrackedControllerRole role );
+bool boolProperty( const uint32_t deviceIndex,
+                   const vr::TrackedDeviceProperty property,
+                   vr::ETrackedPropertyError* error = nullptr );
+int32_t int32Property( const uint32_t deviceIndex,
+                       const vr::TrackedDeviceProperty property,
+                       vr::ETrackedPropertyError* error = nullptr );
+float floatProperty( const uint32_t deviceIndex,
+                     const vr::TrackedDeviceProperty property,
+                     vr::ETrackedPropertyError* error = nullptr );
+std::string stringProperty( const uint32_t deviceIndex,
+                            const vr::TrackedDeviceProperty property,
+                            vr::ETrackedPropertyError* error = nullptr );
+
+// IVRCompositor
+vr::ETrackingUniverseOrigin trackingSpace();
+vr::Compositor_CumulativeStats cumulativeStats();
+
+// IVROverlay
+bool dashboardVisible();
+std::string keyboardText();
+
+// IVRApplications
+uint32_t applicationProcessId( const char* appKey );
+
+// IVRChaperone and IVRChaperoneSetup
+vr::ChaperoneCalibrationState calibrationState();
+vr::HmdMatrix34_t workingStandingZeroPose();
+vr::HmdMatrix34_t workingSeatedZeroPose();
+std::vector<vr::HmdQuad_t> workingCollisionBounds();
+std::vector<vr::HmdQuad_t> liveCollisionBounds();
+
+// IVRSettings
+bool settingBool( const std::string& section,
+                  const std::string& key,
+                  vr::EVRSettingsError* error = nullptr );
+int32_t settingInt32( const std::string& section,
+                      const std::string& key,
+                      vr::EVRSettingsError* error = nullptr );
+float settingFloat( const std::string& section,
+                    const std::string& key,
+                    vr::EVRSettingsError* error = nullptr );
+std::string settingString( const std::string& section,
+                           const std::string& key,
+                           vr::EVRSettingsError* error = nullptr );
+
+} // namespace ovr_recorded_queries
@@ -1,4 +1,5 @@
 #include "ovr_settings_wrapper.h"
+#include "ovr_recorded_queries.h"
 
 namespace ovr_settings_wrapper
 {
@@ -40,8 +41,7 @@ std::pair<SettingsError, bool> getBool( std::string section,
 {
     bool value;
     vr::EVRSettingsError error;
-    value = vr::VRSettings()->GetBool(
-        section.c_str(), settingsKey.c_str(), &error );
+    value = ovr_recorded_queries::settingBool( section, settingsKey, &error );
     SettingsError e = handleErrors( settingsKey, error, customErrorMsg );
     std::pair<SettingsError, bool> p( e, value );
     return p;
@@ -54,8 +54,8 @@ std::pair<SettingsError, int> getInt32( std::string section,
 {
     int value;
     vr::EVRSettingsError error;
-    value = static_cast<int>( vr::VRSettings()->GetInt32(
-        section.c_str(), settingsKey.c_str(), &error ) );
+    value = static_cast<int>(
+        ovr_recorded_queries::settingInt32( section, settingsKey, &error ) );
     SettingsError e = handleErrors( settingsKey, error, customErrorMsg );
     std::pair<SettingsError, int> p( e, value );
     return p;
@@ -68,8 +68,7 @@ std::pair<SettingsError, float> getFloat( std::string section,
 {
     float value;
     vr::EVRSettingsError error;
-    value = vr::VRSettings()->GetFloat(
-        section.c_str(), settingsKey.c_str(), &error );
+    value = ovr_recorded_queries::settingFloat( section, settingsKey, &error );
     handleErrors( settingsKey, error, customErrorMsg );
     SettingsError e = handleErrors( settingsKey, error, customErrorMsg );
     std::pair<SettingsError, float> p( e, value );
@@ -82,15 +81,9 @@ std::pair<SettingsError, std::string> getString( std::string section,
 
 {
     vr::EVRSettingsError error;
-    // This appears to be correct value as set in CVRSettingHelper as of
-    // ovr 1.11.11
-    const uint32_t bufferMax = 4096;
-    char cStringOut[bufferMax];
-
-    vr::VRSettings()->GetString(
-        section.c_str(), settingsKey.c_str(), cStringOut, bufferMax, &error );
+    std::string value
+        = ovr_recorded_queries::settingString( section, settingsKey, &error );
     handleErrors( settingsKey, error, customErrorMsg );
-    std::string value = cStringOut;
     SettingsError e = handleErrors( settingsKey, error, customErrorMsg );
     std::pair<SettingsError, std::string> p( e, value );
     return p;
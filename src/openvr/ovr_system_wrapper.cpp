@@ -1,4 +1,5 @@
 #include "ovr_system_wrapper.h"
+#include "ovr_recorded_queries.h"
 
 namespace ovr_system_wrapper
 {
@@ -36,8 +37,7 @@ std::pair<SystemError, bool>
     uint32_t unIndex = static_cast<uint32_t>( deviceIndex );
     vr::ETrackedPropertyError error;
     bool value;
-    value = vr::VRSystem()->GetBoolTrackedDeviceProperty(
-        unIndex, property, &error );
+    value = ovr_recorded_queries::boolProperty( unIndex, property, &error );
     SystemError e
         = handleTrackedPropertyErrors( property, error, customErrorMsg );
     std::pair<SystemError, bool> p( e, value );
@@ -53,8 +53,8 @@ std::pair<SystemError, int>
     uint32_t unIndex = static_cast<uint32_t>( deviceIndex );
     int value;
     vr::ETrackedPropertyError error;
-    value = static_cast<int>( vr::VRSystem()->GetInt32TrackedDeviceProperty(
-        unIndex, property, &error ) );
+    value = static_cast<int>(
+        ovr_recorded_queries::int32Property( unIndex, property, &error ) );
     SystemError e
         = handleTrackedPropertyErrors( property, error, customErrorMsg );
     std::pair<SystemError, int> p( e, value );
@@ -70,8 +70,7 @@ std::pair<SystemError, float>
     uint32_t unIndex = static_cast<uint32_t>( deviceIndex );
     vr::ETrackedPropertyError error;
     float value;
-    value = vr::VRSystem()->GetFloatTrackedDeviceProperty(
-        unIndex, property, &error );
+    value = ovr_recorded_queries::floatProperty( unIndex, property, &error );
     SystemError e
         = handleTrackedPropertyErrors( property, error, customErrorMsg );
     std::pair<SystemError, float> p( e, value );
@@ -84,14 +83,9 @@ std::pair<SystemError, std::string>
                               std::string customErrorMsg )
 
 {
-    // This appears to be correct value as set in CVRSettingHelper as of
-    // ovr 1.11.11
-    const uint32_t bufferMax = 4096;
-    char cStringOut[bufferMax];
     uint32_t unIndex = static_cast<uint32_t>( deviceIndex );
-    vr::VRSystem()->GetStringTrackedDeviceProperty(
-        unIndex, property, cStringOut, bufferMax );
-    std::string value = cStringOut;
+    std::string value
+        = ovr_recorded_queries::stringProperty( unIndex, property );
     SystemError e = handleTrackedPropertyErrors(
         property, vr::TrackedProp_Success, customErrorMsg );
     std::pair<SystemError, std::string> p( e, value );
@@ -101,20 +95,20 @@ std::pair<SystemError, std::string>
 bool deviceConnected( int index )
 {
     uint32_t unIndex = static_cast<uint32_t>( index );
-    return vr::VRSystem()->IsTrackedDeviceConnected( unIndex );
+    return ovr_recorded_queries::deviceConnected( unIndex );
 }
 
 vr::ETrackedDeviceClass getDeviceClass( int index )
 {
     uint32_t unIndex = static_cast<uint32_t>( index );
-    return vr::VRSystem()->GetTrackedDeviceClass( unIndex );
+    return ovr_recorded_queries::deviceClass( unIndex );
 }
 
 std::string getDeviceName( int index )
 {
     uint32_t unIndex = static_cast<uint32_t>( index );
     // checks if connected returns unknown if not
-    if ( !vr::VRSystem()->IsTrackedDeviceConnected( unIndex ) )
+    if ( !ovr_recorded_queries::deviceConnected( unIndex ) )
     {
         return "No Device Connected";
     }
@@ -16,12 +16,17 @@
 #include <QProcess>
 #include <QMessageBox>
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 #include <openvr.h>
 #include <easylogging++.h>
 #include "utils/Matrix.h"
+#include "utils/startup_trace.h"
+#include "utils/overlay_image_cache.h"
+#include "utils/scheduling_policy.h"
 #include "keyboard_input/input_sender.h"
 #include "settings/settings.h"
+#include "openvr/ovr_recorded_queries.h"
 
 // application namespace
 namespace advsettings
@@ -40,12 +45,26 @@ int verifyCustomTickRate( const int tickRate )
     return tickRate;
 }
 
+double verifyOverlayRenderScale( const double scale )
+{
+    return std::clamp(
+        scale, k_minOverlayRenderScale, k_maxOverlayRenderScale );
+}
+
 OverlayController::OverlayController( bool desktopMode,
                                       bool noSound,
                                       QQmlEngine& qmlEngine )
     : QObject(), m_desktopMode( desktopMode ), m_noSound( noSound ),
       m_verifiedCustomTickRateMs( verifyCustomTickRate( settings::getSetting(
           settings::IntSetting::APPLICATION_customTickRateMs ) ) ),
+      m_tickThread(
+          [this]()
+          {
+              // Called from the tick thread, mainEventLoop must run on the
+              // Qt thread.
+              QMetaObject::invokeMethod(
+                  this, "OnTickPumpEvents", Qt::QueuedConnection );
+          } ),
       m_actions(), m_alarm()
 {
     // Arbitrarily chosen Max Length of Directory path, should be sufficient for
@@ -130,21 +149,40 @@ OverlayController::OverlayController( bool desktopMode,
     // by the compatibility profile, and this is an AMD bug?
     format.setVersion( 2, 1 );
     // format.setProfile( QSurfaceFormat::CompatibilityProfile );
-    format.setDepthBufferSize( 16 );
-    format.setStencilBufferSize( 8 );
+    if ( overlayDepthStencilDisabled() )
+    {
+        // The scene graph renderer decides from this whether to sort opaque
+        // items with the depth buffer. Clipping of rotated items needs the
+        // stencil buffer and breaks.
+        qputenv( "QSG_NO_DEPTH_BUFFER", "1" );
+    }
+    else
+    {
+        format.setDepthBufferSize( 16 );
+        format.setStencilBufferSize( 8 );
+    }
     format.setSamples( 16 );
 
     m_openGLContext.setFormat( format );
-    if ( !m_openGLContext.create() )
+    if ( m_openGLContext.create() )
+    {
+        // create an offscreen surface to attach the context and FBO to
+        m_offscreenSurface.setFormat( m_openGLContext.format() );
+        m_offscreenSurface.create();
+        m_openGLContext.makeCurrent( &m_offscreenSurface );
+    }
+    else if ( m_desktopMode )
+    {
+        // Only the overlay renders with the context, this allows running on
+        // machines without OpenGL, like the --benchmark-dashboard CI runs.
+        LOG( WARNING ) << "Could not create OpenGL context, desktop mode "
+                          "continues without it.";
+    }
+    else
     {
         throw std::runtime_error( "Could not create OpenGL context" );
     }
 
-    // create an offscreen surface to attach the context and FBO to
-    m_offscreenSurface.setFormat( m_openGLContext.format() );
-    m_offscreenSurface.create();
-    m_openGLContext.makeCurrent( &m_offscreenSurface );
-
     if ( !vr::VROverlay() )
     {
         QMessageBox::critical(
@@ -153,13 +191,23 @@ OverlayController::OverlayController( bool desktopMode,
     }
 
     // Init controllers
+    utils::StartupSpan stage1Span( "initStage1" );
+    utils::StartupSpan controllerSpan( "SteamVRTabController" );
     m_steamVRTabController.initStage1();
+    controllerSpan.next( "ChaperoneTabController" );
     m_chaperoneTabController.initStage1();
+    controllerSpan.next( "MoveCenterTabController" );
     m_moveCenterTabController.initStage1();
+    controllerSpan.next( "AudioTabController" );
     m_audioTabController.initStage1();
+    controllerSpan.next( "SettingsTabController" );
     m_settingsTabController.initStage1();
+    controllerSpan.next( "VideoTabController" );
     m_videoTabController.initStage1();
+    controllerSpan.next( "RotationTabController" );
     m_rotationTabController.initStage1();
+    controllerSpan.end();
+    stage1Span.end();
 
     // init action handles
 
@@ -361,6 +409,8 @@ void OverlayController::exitApp()
     // save to settings that shutdown was safe
     setPreviousShutdownSafe( true );
 
+    // Finishes pending settings writes before everything is saved again.
+    utils::backgroundWorker.stop();
     settings::saveAllSettings();
 
     m_moveCenterTabController.shutdown();
@@ -380,11 +430,9 @@ void OverlayController::exitApp()
 
 void OverlayController::Shutdown()
 {
-    disconnect( &m_pumpEventsTimer,
-                SIGNAL( timeout() ),
-                this,
-                SLOT( OnTimeoutPumpEvents() ) );
-    m_pumpEventsTimer.stop();
+    m_tickThread.stop();
+    utils::backgroundWorker.stop();
+    utils::tickRecording.stop();
 
     if ( m_pRenderTimer )
     {
@@ -403,7 +451,11 @@ void OverlayController::Shutdown()
         m_pRenderTimer->stop();
         m_pRenderTimer.reset();
     }
-    m_pFbo.reset();
+    if ( m_renderer )
+    {
+        m_renderer->stop();
+        m_renderer.reset();
+    }
 }
 
 void OverlayController::SetWidget( QQuickItem* quickItem,
@@ -455,31 +507,39 @@ void OverlayController::SetWidget( QQuickItem* quickItem,
 
         // Too many render calls in too short time overwhelm Qt and an
         // assertion gets thrown. Therefore we use an timer to delay render
-        // calls
+        // calls, m_renderThrottle decides for how long.
         m_pRenderTimer.reset( new QTimer() );
         m_pRenderTimer->setSingleShot( true );
-        m_pRenderTimer->setInterval( 5 );
         connect( m_pRenderTimer.get(),
                  SIGNAL( timeout() ),
                  this,
                  SLOT( renderOverlay() ) );
 
-        QOpenGLFramebufferObjectFormat fboFormat;
-        fboFormat.setAttachment(
-            QOpenGLFramebufferObject::CombinedDepthStencil );
-        fboFormat.setTextureTarget( GL_TEXTURE_2D );
-        m_pFbo.reset( new QOpenGLFramebufferObject(
-            static_cast<int>( quickItem->width() ),
-            static_cast<int>( quickItem->height() ),
-            fboFormat ) );
-
-        m_window.setRenderTarget( m_pFbo.get() );
         quickItem->setParentItem( m_window.contentItem() );
         m_window.setGeometry( 0,
                               0,
                               static_cast<int>( quickItem->width() ),
                               static_cast<int>( quickItem->height() ) );
-        m_renderControl.initialize( &m_openGLContext );
+
+        m_renderer = std::make_unique<utils::OverlayRenderer>(
+            m_renderControl, m_window, m_openGLContext, m_offscreenSurface );
+        // The window keeps its size, the render control makes Qt scale the
+        // scene to the FBO. Mouse events are therefore still in window
+        // coordinates.
+        m_renderControl.setRenderWindow( &m_window );
+        const auto renderScale = overlayRenderScale();
+        const QSize textureSize(
+            static_cast<int>( std::lround( quickItem->width() * renderScale ) ),
+            static_cast<int>(
+                std::lround( quickItem->height() * renderScale ) ) );
+        LOG( INFO ) << "Dashboard texture " << textureSize.width() << "x"
+                    << textureSize.height() << " (render scale "
+                    << renderScale << ")"
+                    << ( overlayDepthStencilDisabled()
+                             ? ", no depth/stencil buffer."
+                             : "." );
+        m_renderer->start(
+            m_ulOverlayHandle, textureSize, !overlayDepthStencilDisabled() );
 
         vr::HmdVector2_t vecWindowSize
             = { static_cast<float>( quickItem->width() ),
@@ -497,29 +557,22 @@ void OverlayController::SetWidget( QQuickItem* quickItem,
                  SLOT( OnRenderRequest() ) );
     }
 
-    connect( &m_pumpEventsTimer,
-             SIGNAL( timeout() ),
-             this,
-             SLOT( OnTimeoutPumpEvents() ) );
+    // Audio polling, SteamVR settings synchronisation and settings writes run
+    // here instead of on the tick.
+    utils::backgroundWorker.start();
 
-    // Every 1ms we check if the current frame has advanced (for vsync)
-    m_pumpEventsTimer.setInterval( 1 );
+    // The tick thread sleeps until the next predicted vsync and then posts
+    // exactly one OnTickPumpEvents() per frame.
+    m_tickThread.setVsyncDisabled( vsyncDisabled() );
+    m_tickThread.setCustomTickRateMs( customTickRateMs() );
+    m_tickThread.setNonVsyncTickRateMs( k_nonVsyncTickRate );
+    m_tickThread.start();
 
-    m_pumpEventsTimer.start();
-
-    m_steamVRTabController.initStage2( this );
-    m_chaperoneTabController.initStage2( this );
-    m_fixFloorTabController.initStage2( this );
-    m_audioTabController.initStage2();
-    m_statisticsTabController.initStage2( this );
-    m_settingsTabController.initStage2( this );
-    m_utilitiesTabController.initStage2( this );
-    m_moveCenterTabController.initStage2( this );
-    m_rotationTabController.initStage2( this );
-    m_videoTabController.initStage2();
+    initTabControllers();
 
     if ( autoApplyChaperoneEnabled() )
     {
+        utils::StartupSpan autoApplySpan( "auto apply chaperone" );
         m_chaperoneTabController.reloadChaperoneProfiles();
         auto chapindex
             = m_chaperoneTabController.getChaperoneProfileIndexFromName(
@@ -538,12 +591,56 @@ void OverlayController::SetWidget( QQuickItem* quickItem,
     }
 }
 
+void OverlayController::initTabControllers()
+{
+    utils::StartupSpan stage2Span( "initStage2" );
+    utils::StartupSpan controllerSpan( "SteamVRTabController" );
+    m_steamVRTabController.initStage2( this );
+    controllerSpan.next( "ChaperoneTabController" );
+    m_chaperoneTabController.initStage2( this );
+    controllerSpan.next( "FixFloorTabController" );
+    m_fixFloorTabController.initStage2( this );
+    controllerSpan.next( "AudioTabController" );
+    m_audioTabController.initStage2();
+    controllerSpan.next( "StatisticsTabController" );
+    m_statisticsTabController.initStage2( this );
+    controllerSpan.next( "SettingsTabController" );
+    m_settingsTabController.initStage2( this );
+    controllerSpan.next( "UtilitiesTabController" );
+    m_utilitiesTabController.initStage2( this );
+    controllerSpan.next( "MoveCenterTabController" );
+    m_moveCenterTabController.initStage2( this );
+    controllerSpan.next( "RotationTabController" );
+    m_rotationTabController.initStage2( this );
+    controllerSpan.next( "VideoTabController" );
+    m_videoTabController.initStage2();
+    controllerSpan.end();
+    stage2Span.end();
+}
+
 void OverlayController::OnRenderRequest()
 {
-    if ( m_pRenderTimer && !m_pRenderTimer->isActive() )
+    if ( !m_pRenderTimer || m_pRenderTimer->isActive() )
     {
-        m_pRenderTimer->start();
+        return;
+    }
+    // VREvent_OverlayShown asks for a new frame once it becomes visible.
+    if ( !m_desktopMode && !isOverlayVisible() )
+    {
+        m_renderThrottle.frameSkippedHidden();
+        return;
     }
+    const auto delay = m_renderThrottle.nextRenderDelay(
+        m_tickThread.displayFrequency() );
+    m_pRenderTimer->start( static_cast<int>( delay.count() ) );
+}
+
+bool OverlayController::isOverlayVisible() const
+{
+    return vr::VROverlay()
+           && ( vr::VROverlay()->IsOverlayVisible( m_ulOverlayHandle )
+                || vr::VROverlay()->IsOverlayVisible(
+                    m_ulOverlayThumbnailHandle ) );
 }
 
 void OverlayController::renderOverlay()
@@ -551,49 +648,80 @@ void OverlayController::renderOverlay()
     if ( !m_desktopMode )
     {
         // skip rendering if the overlay isn't visible
-        if ( !vr::VROverlay()
-             || ( !vr::VROverlay()->IsOverlayVisible( m_ulOverlayHandle )
-                  && !vr::VROverlay()->IsOverlayVisible(
-                      m_ulOverlayThumbnailHandle ) ) )
+        if ( !isOverlayVisible() )
+        {
+            m_renderThrottle.frameSkippedHidden();
             return;
-        m_renderControl.polishItems();
-        m_renderControl.sync();
-        m_renderControl.render();
-
-        GLuint unTexture = m_pFbo->texture();
-        if ( unTexture != 0 )
+        }
+        // Right before the frame is polished, so the bindings re-evaluate
+        // once per rendered frame and the frame shows the latest values.
+        m_moveCenterTabController.flushPropertyChanges();
+        if ( !m_renderer || !m_renderer->renderFrame() )
         {
-#if defined _WIN64 || defined _LP64
-            // To avoid any compiler warning because of cast to a larger
-            // pointer type (warning C4312 on VC)
-            vr::Texture_t texture = { reinterpret_cast<void*>(
-                                          static_cast<uint64_t>( unTexture ) ),
-                                      vr::TextureType_OpenGL,
-                                      vr::ColorSpace_Auto };
-#else
-            vr::Texture_t texture = { reinterpret_cast<void*>( unTexture ),
-                                      vr::TextureType_OpenGL,
-                                      vr::ColorSpace_Auto };
-#endif
-            vr::VROverlay()->SetOverlayTexture( m_ulOverlayHandle, &texture );
+            return;
         }
-        m_openGLContext.functions()->glFlush(); // We need to flush otherwise
-                                                // the texture may be empty.*/
+        m_renderThrottle.frameRendered();
+        onOverlayFrameRendered();
+    }
+}
+
+void OverlayController::onOverlayFrameRendered()
+{
+    if ( !m_firstOverlayFrameSubmitted )
+    {
+        m_firstOverlayFrameSubmitted = true;
+        const auto memory = utils::residentMemoryBytes();
+        LOG( INFO ) << "First overlay frame submitted "
+                    << utils::millisecondsSinceProcessStart()
+                    << " ms after start, resident memory "
+                    << ( memory ? *memory / ( 1024 * 1024 ) : 0 ) << " MiB.";
+        emit firstOverlayFrameSubmitted();
     }
 }
 
 bool OverlayController::pollNextEvent( vr::VROverlayHandle_t ulOverlayHandle,
                                        vr::VREvent_t* pEvent )
 {
-    if ( isDesktopMode() )
+    const auto thumbnail = ulOverlayHandle != vr::k_ulOverlayHandleInvalid
+                           && ulOverlayHandle == m_ulOverlayThumbnailHandle;
+    if ( isDesktopMode() && !thumbnail )
     {
-        return vr::VRSystem()->PollNextEvent( pEvent, sizeof( vr::VREvent_t ) );
-    }
-    else
+        return utils::tickRecording.pollEvent(
+            utils::EventQueue::System,
+            *pEvent,
+            []( vr::VREvent_t& event )
+            {
+                return vr::VRSystem()->PollNextEvent( &event,
+                                                      sizeof( event ) );
+            } );
+    }
+    return utils::tickRecording.pollEvent(
+        thumbnail ? utils::EventQueue::Thumbnail : utils::EventQueue::Overlay,
+        *pEvent,
+        [ulOverlayHandle]( vr::VREvent_t& event )
+        {
+            return vr::VROverlay()->PollNextOverlayEvent(
+                ulOverlayHandle, &event, sizeof( event ) );
+        } );
+}
+
+void OverlayController::deliverPendingMouseMove()
+{
+    const auto pendingMove = m_mouseMoves.take( m_ptLastMouse );
+    if ( !pendingMove )
     {
-        return vr::VROverlay()->PollNextOverlayEvent(
-            ulOverlayHandle, pEvent, sizeof( vr::VREvent_t ) );
+        return;
     }
+    const auto ptNewMouse = *pendingMove;
+    QMouseEvent mouseEvent( QEvent::MouseMove,
+                            ptNewMouse,
+                            m_window.mapToGlobal( ptNewMouse ),
+                            Qt::NoButton,
+                            m_lastMouseButtons,
+                            nullptr );
+    m_ptLastMouse = ptNewMouse;
+    QCoreApplication::sendEvent( &m_window, &mouseEvent );
+    OnRenderRequest();
 }
 
 QPoint OverlayController::getMousePositionForEvent( vr::VREvent_Mouse_t mouse )
@@ -918,6 +1046,7 @@ void OverlayController::setVsyncDisabled( bool value, bool notify )
 {
     settings::setSetting( settings::BoolSetting::APPLICATION_vsyncDisabled,
                           value );
+    m_tickThread.setVsyncDisabled( value );
     if ( notify )
     {
         emit vsyncDisabledChanged( value );
@@ -1010,6 +1139,77 @@ void OverlayController::setDebugState( int value, bool notify )
     }
 }
 
+bool OverlayController::frameProfilerEnabled() const
+{
+    return m_frameProfiler.enabled();
+}
+
+void OverlayController::setFrameProfilerEnabled( bool value, bool notify )
+{
+    m_frameProfiler.setEnabled( value );
+    LOG( INFO ) << "Frame profiler " << ( value ? "enabled." : "disabled." );
+
+    if ( notify )
+    {
+        emit frameProfilerEnabledChanged( value );
+    }
+}
+
+QString OverlayController::frameProfilerSummary() const
+{
+    const auto images = utils::overlayImageCache.counters();
+    const auto& spaceChanges = m_moveCenterTabController.propertyChanges();
+    return QString::fromStdString( m_frameProfiler.summaryText() + '\n'
+                                   + utils::frameBudgetGovernor.summaryText() )
+           + QString( "\nMouse moves: %1 received, %2 sent to Qt\n" )
+                 .arg( m_mouseMoves.receivedCount() )
+                 .arg( m_mouseMoves.sentCount() )
+           + QString::fromStdString( m_renderThrottle.summaryText() )
+           + QString( "Space property changes: %1 marked, %2 emitted\n" )
+                 .arg( spaceChanges.markedCount() )
+                 .arg( spaceChanges.emittedCount() )
+           + QString( "Overlay images: %1 cached, %2 decoded, %3 loaded from "
+                      "file\n" )
+                 .arg( images.hits )
+                 .arg( images.misses )
+                 .arg( images.fromFile );
+}
+
+QString OverlayController::dumpFrameProfilerCsv()
+{
+    const auto directory = paths::settingsDirectory();
+    if ( !directory.has_value() )
+    {
+        return "";
+    }
+
+    const auto fileName
+        = QString( "frame_profile_%1.csv" )
+              .arg( QDateTime::currentDateTime().toString(
+                  "yyyyMMdd_hhmmss" ) );
+    const auto filePath = QDir( QString::fromStdString( *directory ) )
+                              .absoluteFilePath( fileName );
+
+    if ( !m_frameProfiler.writeCsv( filePath.toStdString() ) )
+    {
+        LOG( ERROR ) << "Could not write frame profile to '" << filePath
+                     << "'.";
+        return "";
+    }
+
+    LOG( INFO ) << "Frame profile written to '" << filePath << "'.";
+    return QDir::toNativeSeparators( filePath );
+}
+
+void OverlayController::logPagesPreloaded()
+{
+    const auto memory = utils::residentMemoryBytes();
+    LOG( INFO ) << "Dashboard pages preloaded "
+                << utils::millisecondsSinceProcessStart()
+                << " ms after start, resident memory "
+                << ( memory ? *memory / ( 1024 * 1024 ) : 0 ) << " MiB.";
+}
+
 void OverlayController::setPreviousShutdownSafe( bool value )
 {
     settings::setSetting(
@@ -1028,6 +1228,7 @@ void OverlayController::setCustomTickRateMs( int value, bool notify )
     settings::setSetting( settings::IntSetting::APPLICATION_customTickRateMs,
                           verifiedTickRate );
     m_verifiedCustomTickRateMs = verifiedTickRate;
+    m_tickThread.setCustomTickRateMs( verifiedTickRate );
 
     if ( notify )
     {
@@ -1035,71 +1236,127 @@ void OverlayController::setCustomTickRateMs( int value, bool notify )
     }
 }
 
-// vsync implementation:
-// this function triggers every 1ms
-// this function should remain lightweight and only check if it's time to
-// run mainEventLoop() or not.
-void OverlayController::OnTimeoutPumpEvents()
+// Posted by m_tickThread once per vsync frame (or once per custom tick when
+// vsync is disabled). The timing logic lives in utils::VsyncTickThread, this
+// only runs the main event loop and tells the thread the tick is done.
+// While replaying a tick recording the ticks are instead posted back to back
+// from here, so the replay runs as fast as mainEventLoop allows.
+void OverlayController::OnTickPumpEvents()
 {
-    if ( vsyncDisabled() )
+    if ( !utils::tickRecording.beginTick() )
     {
-        // check if it's time for a custom tick rate tick
-        if ( m_customTickRateCounter > customTickRateMs() )
-        {
-            mainEventLoop();
-            m_customTickRateCounter = 0;
-            updateRate.incrementCounter();
-        }
-        else
-        {
-            m_customTickRateCounter++;
-        }
+        finishTickReplay();
+        return;
     }
 
-    // vsync is enabled
+    // Ticks follow vsync unless it is disabled, so does the frame budget.
+    if ( m_tickThread.vsyncDisabled() )
+    {
+        utils::frameBudgetGovernor.setFramePeriod(
+            std::chrono::milliseconds( m_tickThread.customTickRateMs() ) );
+    }
     else
     {
-        // get the current frame number from the VRSystem frame counter
-        vr::VRSystem()->GetTimeSinceLastVsync( nullptr, &m_currentFrame );
+        utils::frameBudgetGovernor.setFramePeriod(
+            std::chrono::duration_cast<UpdateRate::Clock::duration>(
+                std::chrono::duration<double>(
+                    1.0 / m_tickThread.displayFrequency() ) ) );
+    }
 
-        // Check if we are in the next frame yet
-        if ( m_currentFrame > m_lastFrame )
-        {
-            // If the frame has advanced since last check, it's time for our
-            // main event loop. (this function should trigger about every
-            // 11ms assuming 90fps compositor)
-            mainEventLoop();
-            updateRate.incrementCounter();
-
-            // wait for the next frame after executing our main event loop
-            // once.
-            m_lastFrame = m_currentFrame;
-            m_vsyncTooLateCounter = 0;
-        }
-        else if ( m_vsyncTooLateCounter >= k_nonVsyncTickRate )
-        {
-            mainEventLoop();
-            // m_lastFrame = m_currentFrame + 1 skips the next vsync frame
-            // in case it was just about to trigger, to prevent double
-            // updates faster than 11ms.
-            m_lastFrame = m_currentFrame + 1;
-            m_vsyncTooLateCounter = 0;
-        }
-        else
-        {
-            m_vsyncTooLateCounter++;
-        }
+    utils::frameBudgetGovernor.beginTick();
+
+    // The governor holds back deferred subjects before UpdateRate hands out
+    // the tick's slot, so they stay due.
+    if ( utils::tickRecording.isReplaying() )
+    {
+        updateRate.beginTick(
+            m_replayEpoch
+                + std::chrono::duration_cast<UpdateRate::Clock::duration>(
+                    std::chrono::duration<double>(
+                        utils::tickRecording.currentTickSeconds() ) ),
+            utils::withinBudget );
+    }
+    else
+    {
+        updateRate.beginTick( utils::withinBudget );
     }
+
+    mainEventLoop();
+    utils::frameBudgetGovernor.endTick();
+    utils::tickRecording.endTick();
+
+    if ( utils::tickRecording.isReplaying() )
+    {
+        QMetaObject::invokeMethod(
+            this, "OnTickPumpEvents", Qt::QueuedConnection );
+    }
+    else
+    {
+        m_tickThread.tickFinished();
+    }
+}
+
+/*!
+Switches the main event loop from the runtime to a tick recording made with
+--record-ticks. The frame profiler is enabled for the whole replay and its
+results are written to the settings directory once the recording runs out.
+*/
+bool OverlayController::startTickReplay( const std::string& filePath )
+{
+    m_tickThread.stop();
+
+    if ( !utils::tickRecording.startReplay( filePath ) )
+    {
+        return false;
+    }
+
+    m_replayEpoch = UpdateRate::Clock::now();
+    setFrameProfilerEnabled( true );
+    utils::backgroundWorker.resetStatistics();
+    utils::frameBudgetGovernor.resetCounters();
+    m_mouseMoves.resetCounters();
+    m_renderThrottle.resetCounters();
+    m_moveCenterTabController.propertyChanges().resetCounters();
+    QMetaObject::invokeMethod( this, "OnTickPumpEvents", Qt::QueuedConnection );
+    return true;
+}
+
+void OverlayController::finishTickReplay()
+{
+    const auto worker = utils::backgroundWorker.statistics();
+    LOG( INFO ) << "Tick replay finished after "
+                << utils::tickRecording.tickCount() << " ticks.\n"
+                << frameProfilerSummary();
+    LOG( INFO ) << "Background worker: " << worker.jobsRun << " jobs, "
+                << worker.busyUs << " us busy, longest job " << worker.maxJobUs
+                << " us, " << worker.jobsDropped << " dropped.";
+    dumpFrameProfilerCsv();
+    utils::tickRecording.stop();
+    exitApp();
 }
 
 void OverlayController::mainEventLoop()
 {
-    if ( !vr::VRSystem() )
+    // A replay gets its input from the recording.
+    if ( !vr::VRSystem() && !utils::tickRecording.isReplaying() )
         return;
 
-    m_actions.UpdateStates();
+    using utils::ProfiledSection;
+    utils::ProfilerSequence profile( m_frameProfiler );
+
+    // Results of the jobs the background worker finished since the last tick.
+    utils::backgroundWorker.runCompletions();
+    profile.mark( ProfiledSection::BackgroundResults );
+
+    // Action states come from the recording while replaying.
+    if ( !utils::tickRecording.isReplaying() )
+    {
+        m_actions.UpdateStates();
+    }
+    profile.mark( ProfiledSection::UpdateActionStates );
 
     processInputBindings();
+    profile.mark( ProfiledSection::InputBindings );
 
     vr::VREvent_t vrEvent;
     bool chaperoneDataAlreadyUpdated = false;
@@ -1109,24 +1366,17 @@ void OverlayController::mainEventLoop()
         {
         case vr::VREvent_MouseMove:
         {
-            QPoint ptNewMouse = getMousePositionForEvent( vrEvent.data.mouse );
-            if ( ptNewMouse != m_ptLastMouse )
-            {
-                QMouseEvent mouseEvent( QEvent::MouseMove,
-                                        ptNewMouse,
-                                        m_window.mapToGlobal( ptNewMouse ),
-                                        Qt::NoButton,
-                                        m_lastMouseButtons,
-                                        nullptr );
-                m_ptLastMouse = ptNewMouse;
-                QCoreApplication::sendEvent( &m_window, &mouseEvent );
-                OnRenderRequest();
-            }
+            // Sent to Qt before the next button or scroll event, or once the
+            // queue is drained. Moves in between only update the position.
+            m_renderThrottle.noteInteraction();
+            m_mouseMoves.move( getMousePositionForEvent( vrEvent.data.mouse ) );
         }
         break;
 
         case vr::VREvent_MouseButtonDown:
         {
+            deliverPendingMouseMove();
+            m_renderThrottle.noteInteraction();
             QPoint ptNewMouse = getMousePositionForEvent( vrEvent.data.mouse );
             Qt::MouseButton button
                 = vrEvent.data.mouse.button == vr::VRMouseButton_Right
@@ -1145,6 +1395,8 @@ void OverlayController::mainEventLoop()
 
         case vr::VREvent_MouseButtonUp:
         {
+            deliverPendingMouseMove();
+            m_renderThrottle.noteInteraction();
             QPoint ptNewMouse = getMousePositionForEvent( vrEvent.data.mouse );
             Qt::MouseButton button
                 = vrEvent.data.mouse.button == vr::VRMouseButton_Right
@@ -1163,6 +1415,8 @@ void OverlayController::mainEventLoop()
 
         case vr::VREvent_ScrollSmooth:
         {
+            deliverPendingMouseMove();
+            m_renderThrottle.noteInteraction();
             // Wheel speed is defined as 1/8 of a degree
             QWheelEvent wheelEvent(
                 m_ptLastMouse,
@@ -1209,15 +1463,14 @@ void OverlayController::mainEventLoop()
         {
             LOG( DEBUG ) << "Dashboard deactivated";
             m_dashboardVisible = false;
-            settings::saveChangedSettings();
+            settings::saveChangedSettingsInBackground();
         }
         break;
 
         case vr::VREvent_KeyboardDone:
         {
-            char keyboardBuffer[1024];
-            vr::VROverlay()->GetKeyboardText( keyboardBuffer, 1024 );
-            emit keyBoardInputSignal( QString( keyboardBuffer ),
+            const auto keyboardText = ovr_recorded_queries::keyboardText();
+            emit keyBoardInputSignal( QString::fromStdString( keyboardText ),
                                       static_cast<unsigned long>(
                                           vrEvent.data.keyboard.uUserValue ) );
         }
@@ -1234,7 +1487,7 @@ void OverlayController::mainEventLoop()
         // emitted at the same time (some with a little bit of
         // delay) There is no sure way to recognize redundant
         // events, we can only exclude redundant events during
-        // the same call of OnTimeoutPumpEvents() INFO Removed
+        // the same call of mainEventLoop() INFO Removed
         // logging on play space mover for possible crashing
         // issues.
         case vr::VREvent_ChaperoneUniverseHasChanged:
@@ -1267,73 +1520,111 @@ void OverlayController::mainEventLoop()
             }
         }
         break;
+        case vr::VREvent_TrackedDeviceActivated:
+        case vr::VREvent_TrackedDeviceDeactivated:
+        case vr::VREvent_TrackedDeviceRoleChanged:
+            utils::controllerRoles.handleEvent( vrEvent );
+            break;
         default:
             break;
         }
     }
+    deliverPendingMouseMove();
+    // Device events aren't guaranteed to reach the overlay's event queue, so
+    // the system queue is drained as well. Desktop mode polls it above.
+    if ( !isDesktopMode() )
+    {
+        const auto pollSystemEvent = []( vr::VREvent_t& event )
+        { return vr::VRSystem()->PollNextEvent( &event, sizeof( event ) ); };
+        while ( utils::tickRecording.pollEvent(
+            utils::EventQueue::System, vrEvent, pollSystemEvent ) )
+        {
+            utils::controllerRoles.handleEvent( vrEvent );
+        }
+    }
+    utils::controllerRoles.refreshIfStale();
     if ( m_incomingReset )
     {
         m_incomingReset = false;
         LOG( INFO ) << "Reset zero event recorded";
         m_moveCenterTabController.incomingZeroReset();
     }
+    profile.mark( ProfiledSection::EventPolling );
 
-    vr::TrackedDevicePose_t devicePoses[vr::k_unMaxTrackedDeviceCount];
-    vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
-        vr::TrackingUniverseStanding,
-        0.0f,
-        devicePoses,
-        vr::k_unMaxTrackedDeviceCount );
-
-    // HMD/Controller Velocities
-    auto leftId = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-        vr::TrackedControllerRole_LeftHand );
-    float leftSpeed = 0.0f;
-    if ( leftId != vr::k_unTrackedDeviceIndexInvalid
-         && devicePoses[leftId].bPoseIsValid
-         && devicePoses[leftId].eTrackingResult
-                == vr::TrackingResult_Running_OK )
-    {
-        auto& vel = devicePoses[leftId].vVelocity.v;
-        leftSpeed
-            = std::sqrt( vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2] );
-    }
-    auto rightId = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-        vr::TrackedControllerRole_RightHand );
-    auto rightSpeed = 0.0f;
-    if ( rightId != vr::k_unTrackedDeviceIndexInvalid
-         && devicePoses[rightId].bPoseIsValid
-         && devicePoses[rightId].eTrackingResult
-                == vr::TrackingResult_Running_OK )
-    {
-        auto& vel = devicePoses[rightId].vVelocity.v;
-        rightSpeed
-            = std::sqrt( vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2] );
-    }
-    auto universe = vr::VRCompositor()->GetTrackingSpace();
-    m_moveCenterTabController.eventLoopTick( universe, devicePoses );
+    auto devicePoses = m_frame.poses.data();
+    if ( utils::tickRecording.isReplaying() )
+    {
+        utils::tickRecording.replayPoses( devicePoses );
+    }
+    else
+    {
+        vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
+            vr::TrackingUniverseStanding,
+            0.0f,
+            devicePoses,
+            vr::k_unMaxTrackedDeviceCount );
+    }
+
+    auto universe = utils::tickRecording.isReplaying()
+                        ? utils::tickRecording.replayUniverse()
+                        : vr::VRCompositor()->GetTrackingSpace();
+    utils::tickRecording.recordPoses( universe, devicePoses );
+    m_frame.update( universe, ovr_recorded_queries::dashboardVisible() );
+    profile.mark( ProfiledSection::DevicePoses );
+
+    m_moveCenterTabController.eventLoopTick( m_frame );
+    profile.mark( ProfiledSection::MoveCenterTick );
     m_utilitiesTabController.eventLoopTick();
-    m_statisticsTabController.eventLoopTick(
-        devicePoses, leftSpeed, rightSpeed );
-    m_chaperoneTabController.eventLoopTick( universe, devicePoses );
+    profile.mark( ProfiledSection::UtilitiesTick );
+    if ( utils::frameBudgetGovernor.shouldRun(
+             utils::DeferrableSubject::Statistics ) )
+    {
+        m_statisticsTabController.eventLoopTick( m_frame );
+        profile.mark( ProfiledSection::StatisticsTick );
+    }
+    m_frame.updateChaperone( m_chaperoneUtils );
+    m_chaperoneTabController.eventLoopTick( m_frame );
+    profile.mark( ProfiledSection::ChaperoneTick );
     m_audioTabController.eventLoopTick();
-    m_rotationTabController.eventLoopTick( devicePoses );
+    profile.mark( ProfiledSection::AudioTick );
+    m_rotationTabController.eventLoopTick( m_frame );
+    profile.mark( ProfiledSection::RotationTick );
 
+    // The alarm check and the dashboard ticks are deferred through
+    // UpdateRate, see OnTickPumpEvents.
     m_alarm.eventLoopTick();
+    profile.mark( ProfiledSection::AlarmTick );
 
-    if ( vr::VROverlay()->IsDashboardVisible() || m_desktopMode )
+    if ( m_frame.dashboardVisible || m_desktopMode )
     {
         m_settingsTabController.dashboardLoopTick();
+        profile.mark( ProfiledSection::SettingsDashboardTick );
         m_steamVRTabController.dashboardLoopTick();
-        m_fixFloorTabController.dashboardLoopTick( devicePoses );
+        profile.mark( ProfiledSection::SteamVrDashboardTick );
+        m_fixFloorTabController.dashboardLoopTick( m_frame );
+        profile.mark( ProfiledSection::FixFloorDashboardTick );
         m_videoTabController.dashboardLoopTick();
+        profile.mark( ProfiledSection::VideoDashboardTick );
         m_chaperoneTabController.dashboardLoopTick();
+        profile.mark( ProfiledSection::ChaperoneDashboardTick );
+    }
+
+    // renderOverlay() flushes property changes, the desktop window renders
+    // on its own.
+    if ( m_desktopMode )
+    {
+        m_moveCenterTabController.flushPropertyChanges();
+        profile.mark( ProfiledSection::PropertyChanges );
+    }
+    else if ( m_frame.dashboardVisible
+              && m_moveCenterTabController.propertyChanges().hasChanges() )
+    {
+        OnRenderRequest();
     }
 
     if ( m_ulOverlayThumbnailHandle != vr::k_ulOverlayHandleInvalid )
     {
-        while ( vr::VROverlay()->PollNextOverlayEvent(
-            m_ulOverlayThumbnailHandle, &vrEvent, sizeof( vrEvent ) ) )
+        while ( pollNextEvent( m_ulOverlayThumbnailHandle, &vrEvent ) )
         {
             switch ( vrEvent.eventType )
             {
@@ -1594,6 +1885,89 @@ bool OverlayController::desktopModeToggle() const
         settings::BoolSetting::APPLICATION_desktopModeToggle );
 }
 
+void OverlayController::setOverlayRenderScale( double value, bool notify )
+{
+    const auto verifiedScale = verifyOverlayRenderScale( value );
+    settings::setSetting(
+        settings::DoubleSetting::APPLICATION_overlayRenderScale,
+        verifiedScale );
+    if ( notify )
+    {
+        emit overlayRenderScaleChanged( verifiedScale );
+    }
+    settings::saveAllSettings();
+}
+
+double OverlayController::overlayRenderScale() const
+{
+    return verifyOverlayRenderScale( settings::getSetting(
+        settings::DoubleSetting::APPLICATION_overlayRenderScale ) );
+}
+
+void OverlayController::setOverlayDepthStencilDisabled( bool value,
+                                                        bool notify )
+{
+    settings::setSetting(
+        settings::BoolSetting::APPLICATION_overlayDepthStencilDisabled,
+        value );
+    if ( notify )
+    {
+        emit overlayDepthStencilDisabledChanged( value );
+    }
+    settings::saveAllSettings();
+}
+
+bool OverlayController::overlayDepthStencilDisabled() const
+{
+    return settings::getSetting(
+        settings::BoolSetting::APPLICATION_overlayDepthStencilDisabled );
+}
+
+void OverlayController::setLowPriorityMode( bool value, bool notify )
+{
+    settings::setSetting( settings::BoolSetting::APPLICATION_lowPriorityMode,
+                          value );
+    if ( notify )
+    {
+        emit lowPriorityModeChanged( value );
+    }
+    settings::saveAllSettings();
+}
+
+bool OverlayController::lowPriorityMode() const
+{
+    return settings::getSetting(
+        settings::BoolSetting::APPLICATION_lowPriorityMode );
+}
+
+void OverlayController::setLowPriorityCpus( QString value, bool notify )
+{
+    const auto cpus = value.trimmed().toStdString();
+    // A malformed list keeps the previous one, the UI is told to show it
+    // again.
+    if ( utils::parseCpuList( cpus ) )
+    {
+        settings::setSetting(
+            settings::StringSetting::APPLICATION_lowPriorityCpus, cpus );
+        settings::saveAllSettings();
+    }
+    else
+    {
+        LOG( WARNING ) << "Ignoring invalid low priority CPU list '" << cpus
+                       << "'.";
+    }
+    if ( notify )
+    {
+        emit lowPriorityCpusChanged( lowPriorityCpus() );
+    }
+}
+
+QString OverlayController::lowPriorityCpus() const
+{
+    return QString::fromStdString( settings::getSetting(
+        settings::StringSetting::APPLICATION_lowPriorityCpus ) );
+}
+
 void OverlayController::playActivationSound()
 {
     if ( !m_noSound )
@@ -45,6 +45,18 @@
 #include "alarm_clock/vr_alarm.h"
 
 #include "utils/update_rate.h"
+#include "utils/vsync_tick_thread.h"
+#include "utils/frame_profiler.h"
+#include "utils/frame_context.h"
+#include "utils/controller_roles.h"
+#include "utils/startup_metrics.h"
+#include "utils/tick_recording.h"
+#include "utils/background_worker.h"
+#include "utils/frame_budget_governor.h"
+#include "utils/overlay_renderer.h"
+#include "utils/overlay_render_control.h"
+#include "utils/render_throttle.h"
+#include "utils/mouse_move_coalescer.h"
 
 namespace application_strings
 {
@@ -67,6 +79,9 @@ namespace advsettings
 // loop tick when vsync is too late due to dropped frames.
 constexpr int k_nonVsyncTickRate = 20;
 constexpr int k_maxCustomTickRate = 999;
+// Dashboard texture resolution relative to the size of the root QML item.
+constexpr double k_minOverlayRenderScale = 0.5;
+constexpr double k_maxOverlayRenderScale = 1.5;
 constexpr int k_hmdRotationCounterUpdateRate = 7;
 
 class OverlayController : public QObject
@@ -100,24 +115,40 @@ class OverlayController : public QObject
                     soundVolumeChanged )
     Q_PROPERTY( bool desktopModeToggle READ desktopModeToggle WRITE
                     setDesktopModeToggle NOTIFY desktopModeToggleChanged )
+    Q_PROPERTY( double overlayRenderScale READ overlayRenderScale WRITE
+                    setOverlayRenderScale NOTIFY overlayRenderScaleChanged )
+    Q_PROPERTY( bool overlayDepthStencilDisabled READ
+                    overlayDepthStencilDisabled WRITE
+                        setOverlayDepthStencilDisabled NOTIFY
+                            overlayDepthStencilDisabledChanged )
+    Q_PROPERTY( bool lowPriorityMode READ lowPriorityMode WRITE
+                    setLowPriorityMode NOTIFY lowPriorityModeChanged )
+    Q_PROPERTY( QString lowPriorityCpus READ lowPriorityCpus WRITE
+                    setLowPriorityCpus NOTIFY lowPriorityCpusChanged )
+    Q_PROPERTY(
+        bool frameProfilerEnabled READ frameProfilerEnabled WRITE
+            setFrameProfilerEnabled NOTIFY frameProfilerEnabledChanged )
 
 private:
     vr::VROverlayHandle_t m_ulOverlayHandle = vr::k_ulOverlayHandleInvalid;
     vr::VROverlayHandle_t m_ulOverlayThumbnailHandle
         = vr::k_ulOverlayHandleInvalid;
 
-    QQuickRenderControl m_renderControl;
+    utils::OverlayRenderControl m_renderControl;
     QQuickWindow m_window{ &m_renderControl };
-    std::unique_ptr<QOpenGLFramebufferObject> m_pFbo;
     QOpenGLContext m_openGLContext;
     QOffscreenSurface m_offscreenSurface;
+    std::unique_ptr<utils::OverlayRenderer> m_renderer;
 
-    QTimer m_pumpEventsTimer;
     std::unique_ptr<QTimer> m_pRenderTimer;
+    utils::RenderThrottle m_renderThrottle;
     bool m_dashboardVisible = false;
+    // The time to the first submitted frame is logged as a startup metric.
+    bool m_firstOverlayFrameSubmitted = false;
 
     QPoint m_ptLastMouse;
     Qt::MouseButtons m_lastMouseButtons = nullptr;
+    utils::MouseMoveCoalescer<QPoint> m_mouseMoves;
 
     bool m_desktopMode;
     bool m_noSound;
@@ -140,11 +171,15 @@ class OverlayController : public QObject
     QSoundEffect m_focusChangedSoundEffect;
     QSoundEffect m_alarm01SoundEffect;
 
-    uint64_t m_currentFrame = 0;
-    uint64_t m_lastFrame = 0;
-    int m_vsyncTooLateCounter = 0;
-    int m_customTickRateCounter = 0;
     int m_verifiedCustomTickRateMs = 0;
+    utils::VsyncTickThread m_tickThread;
+    utils::FrameProfiler m_frameProfiler;
+    // Rebuilt at the start of every mainEventLoop. The poses are fetched
+    // straight into it.
+    utils::FrameContext m_frame;
+    // Time base for replayed ticks, so updateRate schedules subjects on the
+    // recorded timeline instead of the replay's wall clock.
+    UpdateRate::Clock::time_point m_replayEpoch{};
 
     input::SteamIVRInput m_actions;
 
@@ -170,6 +205,9 @@ class OverlayController : public QObject
 
 private:
     QPoint getMousePositionForEvent( vr::VREvent_Mouse_t mouse );
+    void deliverPendingMouseMove();
+    void onOverlayFrameRendered();
+    bool isOverlayVisible() const;
     void processInputBindings();
     void processMediaKeyBindings();
     void processMotionBindings();
@@ -189,6 +227,7 @@ class OverlayController : public QObject
 
     void Shutdown();
     Q_INVOKABLE void exitApp();
+    bool startTickReplay( const std::string& filePath );
     Q_INVOKABLE void setAutoChapProfileName( int index );
 
     bool isDashboardVisible()
@@ -199,6 +238,8 @@ class OverlayController : public QObject
     void SetWidget( QQuickItem* quickItem,
                     const std::string& name,
                     const std::string& key = "" );
+    // Runs every tab controller's initStage2(), SetWidget() does this too.
+    void initTabControllers();
 
     void RotateUniverseCenter( vr::ETrackingUniverseOrigin universe,
                                float yAngle,
@@ -235,6 +276,7 @@ class OverlayController : public QObject
     bool pollNextEvent( vr::VROverlayHandle_t ulOverlayHandle,
                         vr::VREvent_t* pEvent );
     void mainEventLoop();
+    void finishTickReplay();
 
     bool crashRecoveryDisabled() const;
     bool exclusiveInputEnabled() const;
@@ -250,11 +292,21 @@ class OverlayController : public QObject
 
     double soundVolume() const;
     bool desktopModeToggle() const;
+    double overlayRenderScale() const;
+    bool overlayDepthStencilDisabled() const;
+    bool lowPriorityMode() const;
+    QString lowPriorityCpus() const;
+    bool frameProfilerEnabled() const;
+
+    Q_INVOKABLE QString frameProfilerSummary() const;
+    Q_INVOKABLE QString dumpFrameProfilerCsv();
+    // Logs the startup metrics once --page-loading preload is done.
+    Q_INVOKABLE void logPagesPreloaded();
 
 public slots:
     void renderOverlay();
     void OnRenderRequest();
-    void OnTimeoutPumpEvents();
+    void OnTickPumpEvents();
     void OnNetworkReply( QNetworkReply* reply );
 
     void showKeyboard( QString existingText, unsigned long userValue = 0 );
@@ -278,6 +330,11 @@ public slots:
     void setAutoApplyChaperoneEnabled( bool value, bool notify = true );
     void setSoundVolume( double value, bool notify = true );
     void setDesktopModeToggle( bool value, bool notify = true );
+    void setOverlayRenderScale( double value, bool notify = true );
+    void setOverlayDepthStencilDisabled( bool value, bool notify = true );
+    void setLowPriorityMode( bool value, bool notify = true );
+    void setLowPriorityCpus( QString value, bool notify = true );
+    void setFrameProfilerEnabled( bool value, bool notify = true );
 
 signals:
     void keyBoardInputSignal( QString input, unsigned long userValue = 0 );
@@ -293,6 +350,13 @@ public slots:
     void autoApplyChaperoneEnabledChanged( bool value );
     void soundVolumeChanged( double value );
     void desktopModeToggleChanged( bool value );
+    void overlayRenderScaleChanged( double value );
+    void overlayDepthStencilDisabledChanged( bool value );
+    void lowPriorityModeChanged( bool value );
+    void lowPriorityCpusChanged( QString value );
+    void frameProfilerEnabledChanged( bool value );
+    // Starts --page-loading preload.
+    void firstOverlayFrameSubmitted();
 };
 
 } // namespace advsettings
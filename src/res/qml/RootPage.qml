@@ -34,7 +34,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(steamVRPage)
+                           mainView.push(dashboardPage("steamVR"))
                        }
                    }
 
@@ -46,7 +46,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(chaperonePage)
+                           mainView.push(dashboardPage("chaperone"))
                        }
                    }
 
@@ -58,7 +58,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(playspacePage)
+                           mainView.push(dashboardPage("playspace"))
                        }
                    }
 
@@ -70,7 +70,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(motionPage)
+                           mainView.push(dashboardPage("motion"))
                        }
                    }
                    MyPushButton {
@@ -81,7 +81,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(rotationPage)
+                           mainView.push(dashboardPage("rotation"))
                        }
                    }
 
@@ -93,7 +93,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(fixFloorPage)
+                           mainView.push(dashboardPage("fixFloor"))
                        }
                    }
 
@@ -105,7 +105,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(audioPage)
+                           mainView.push(dashboardPage("audio"))
                        }
                    }
 
@@ -117,7 +117,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(videoPage)
+                           mainView.push(dashboardPage("video"))
                        }
                    }
 
@@ -129,7 +129,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(utilitiesPage)
+                           mainView.push(dashboardPage("utilities"))
                        }
                    }
 
@@ -142,7 +142,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(statisticsPage)
+                           mainView.push(dashboardPage("statistics"))
                        }
                    }
 
@@ -170,7 +170,7 @@ MyStackViewPage {
                        Layout.fillWidth: true
                        onClicked: {
                            MyResources.playFocusChangedSound()
-                           mainView.push(settingsPage)
+                           mainView.push(dashboardPage("settings"))
                        }
                    }
                }
@@ -100,6 +100,79 @@ MyStackViewPage {
                 }
             }
 
+            RowLayout {
+                Layout.fillWidth: true
+
+                MyText {
+                    text: "Dashboard Render Scale (restart required): "
+                    horizontalAlignment: Text.AlignRight
+                    Layout.rightMargin: 2
+                }
+
+                MyTextField {
+                    id: overlayRenderScaleText
+                    text: "1.00"
+                    keyBoardUID: 504
+                    Layout.preferredWidth: 140
+                    Layout.leftMargin: 10
+                    horizontalAlignment: Text.AlignHCenter
+                    function onInputEvent(input) {
+                        var val = parseFloat(input)
+                        if (!isNaN(val)) {
+                            OverlayController.overlayRenderScale = val
+                        }
+                        text = OverlayController.overlayRenderScale.toFixed(2)
+                    }
+                }
+
+                Item {
+                    Layout.fillWidth: true
+                }
+            }
+
+            MyToggleButton {
+                id: overlayDepthStencilDisabledToggle
+                text: "Render Dashboard Without Depth/Stencil Buffer (restart required)"
+                onCheckedChanged: {
+                    OverlayController.setOverlayDepthStencilDisabled(this.checked, false)
+                }
+            }
+
+            MyToggleButton {
+                id: lowPriorityModeToggle
+                text: "Low Priority Mode (restart required)"
+                onCheckedChanged: {
+                    OverlayController.setLowPriorityMode(this.checked, false)
+                }
+            }
+
+            RowLayout {
+                Layout.fillWidth: true
+
+                MyText {
+                    text: "Low Priority CPUs, e.g. 2,3 or 4-7 (restart required): "
+                    horizontalAlignment: Text.AlignRight
+                    Layout.rightMargin: 2
+                }
+
+                MyTextField {
+                    id: lowPriorityCpusText
+                    text: ""
+                    keyBoardUID: 505
+                    Layout.preferredWidth: 140
+                    Layout.leftMargin: 10
+                    horizontalAlignment: Text.AlignHCenter
+                    function onInputEvent(input) {
+                        OverlayController.lowPriorityCpus = input
+                        text = OverlayController.lowPriorityCpus
+                    }
+                }
+
+                Item {
+                    Layout.fillWidth: true
+                }
+            }
+
             MyToggleButton {
                 id: universeCenteredRotationToggle
                 text: "Universe-Centered Rotation (Disables HMD Centering)"
@@ -275,6 +348,65 @@ MyStackViewPage {
                     Layout.fillWidth: true
                 }
             }
+            ColumnLayout {
+                id: frameProfilerColumn
+                Layout.fillWidth: true
+                spacing: 18
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    MyToggleButton {
+                        id: frameProfilerToggle
+                        text: "Frame Profiler"
+                        onCheckedChanged: {
+                            OverlayController.setFrameProfilerEnabled(checked, false)
+                            frameProfilerText.text = OverlayController.frameProfilerSummary()
+                        }
+                    }
+
+                    Item {
+                        Layout.fillWidth: true
+                    }
+
+                    MyPushButton {
+                        id: frameProfilerDumpButton
+                        Layout.preferredWidth: 250
+                        text: "Dump to CSV"
+                        onClicked: {
+                            var path = OverlayController.dumpFrameProfilerCsv()
+                            frameProfilerPathText.text = path.length > 0 ? "Saved: " + path : "Could not write CSV file."
+                        }
+                    }
+                }
+
+                MyText {
+                    id: frameProfilerText
+                    Layout.fillWidth: true
+                    font.family: "Courier New"
+                    font.pointSize: 14
+                    text: ""
+                }
+
+                MyText {
+                    id: frameProfilerPathText
+                    Layout.fillWidth: true
+                    font.pointSize: 14
+                    wrapMode: Text.WrapAnywhere
+                    text: ""
+                }
+
+                Timer {
+                    id: frameProfilerUpdateTimer
+                    repeat: true
+                    interval: 1000
+                    running: frameProfilerColumn.visible && frameProfilerToggle.checked
+                    onTriggered: {
+                        frameProfilerText.text = OverlayController.frameProfilerSummary()
+                    }
+                }
+            }
+
             RowLayout{
                 Item {
                     Layout.fillWidth: true
@@ -323,6 +455,8 @@ MyStackViewPage {
                 customTickRateLabel.visible = vsyncDisabledToggle.checked
                 customTickRateMsLabel.visible = vsyncDisabledToggle.checked
                 debugStateRow.visible = OverlayController.enableDebug
+                frameProfilerColumn.visible = OverlayController.enableDebug
+                frameProfilerToggle.checked = OverlayController.frameProfilerEnabled
                 debugStateText.text = OverlayController.debugState
                 disableVersionCheckToggle.checked = OverlayController.disableVersionCheck
                 nativeChaperoneToggleButton.checked = SettingsTabController.nativeChaperoneToggle
@@ -330,6 +464,10 @@ MyStackViewPage {
                 exclusiveInputToggleButton.checked = OverlayController.exclusiveInputEnabled
                 autoApplyChaperoneToggleButton.checked = OverlayController.autoApplyChaperoneEnabled
                 desktopModeToggleButton.checked = OverlayController.desktopModeToggle
+                overlayRenderScaleText.text = OverlayController.overlayRenderScale.toFixed(2)
+                overlayDepthStencilDisabledToggle.checked = OverlayController.overlayDepthStencilDisabled
+                lowPriorityModeToggle.checked = OverlayController.lowPriorityMode
+                lowPriorityCpusText.text = OverlayController.lowPriorityCpus
 
 
                 reloadChaperoneProfiles()
@@ -374,6 +512,10 @@ MyStackViewPage {
 
             onEnableDebugChanged: {
                 debugStateRow.visible = OverlayController.enableDebug
+                frameProfilerColumn.visible = OverlayController.enableDebug
+            }
+            onFrameProfilerEnabledChanged: {
+                frameProfilerToggle.checked = OverlayController.frameProfilerEnabled
             }
 
             onDebugStateChanged: {
@@ -394,6 +536,18 @@ MyStackViewPage {
             onDesktopModeToggleChanged:{
                 desktopModeToggleButton.checked = OverlayController.desktopModeToggle
             }
+            onOverlayRenderScaleChanged:{
+                overlayRenderScaleText.text = OverlayController.overlayRenderScale.toFixed(2)
+            }
+            onOverlayDepthStencilDisabledChanged:{
+                overlayDepthStencilDisabledToggle.checked = OverlayController.overlayDepthStencilDisabled
+            }
+            onLowPriorityModeChanged:{
+                lowPriorityModeToggle.checked = OverlayController.lowPriorityMode
+            }
+            onLowPriorityCpusChanged:{
+                lowPriorityCpusText.text = OverlayController.lowPriorityCpus
+            }
         }
         Connections{
             target: ChaperoneTabController
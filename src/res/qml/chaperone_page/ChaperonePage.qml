@@ -495,7 +495,7 @@ MyStackViewPage {
                 Layout.preferredWidth: 350
                 onClicked: {
                     MyResources.playFocusChangedSound()
-                    mainView.push(chaperoneWarningsPage)
+                    mainView.push(dashboardPage("chaperoneWarnings"))
                 }
             }
             Item {Layout.fillWidth: true}
@@ -507,7 +507,7 @@ MyStackViewPage {
 
                 onClicked: {
                     MyResources.playFocusChangedSound()
-                    mainView.push(chaperoneAdditionalPage)
+                    mainView.push(dashboardPage("chaperoneAdditional"))
                 }
             }
         }
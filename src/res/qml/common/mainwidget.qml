@@ -1,6 +1,7 @@
 import QtQuick 2.7
 import QtQuick.Controls 2.0
 import QtQuick.Layouts 1.0
+import ovras.advsettings 1.0
 import ".."
 import "../utilities_page"
 import "../audio_page"
@@ -22,74 +23,191 @@ Rectangle {
         stackView: mainView
     }
 
-    property SteamVRPage steamVRPage: SteamVRPage {
-        stackView: mainView
-        visible: false
-    }
-
-    property ChaperonePage chaperonePage: ChaperonePage {
-        stackView: mainView
-        visible: false
-    }
-
-    property ChaperoneWarningsPage chaperoneWarningsPage: ChaperoneWarningsPage {
-        stackView: mainView
-        visible: false
-    }
-
-    property ChaperoneAdditionalPage chaperoneAdditionalPage: ChaperoneAdditionalPage{
-        stackView: mainView
-        visible: false
-    }
-
-    property SteamVRTXRXPage steamVRTXRXPage: SteamVRTXRXPage{
-        stackView: mainView
-        visible: false
-    }
-
-    property PlayspacePage playspacePage: PlayspacePage {
-        stackView: mainView
-        visible: false
-    }
-
-    property MotionPage motionPage: MotionPage {
-        stackView: mainView
-        visible: false
-    }
-
-    property RotationPage  rotationPage: RotationPage {
-        stackView: mainView
-        visible: false
-    }
-
-    property FixFloorPage fixFloorPage: FixFloorPage {
-        stackView: mainView
-        visible: false
-    }
-
-    property StatisticsPage statisticsPage: StatisticsPage {
-        stackView: mainView
-        visible: false
-    }
+    // "lazy" creates a page when it is first opened, "preload" additionally
+    // creates the remaining pages one at a time once the first overlay frame
+    // has been submitted and "eager" creates all of them at startup. Set
+    // from --page-loading.
+    property string pageLoading: "lazy"
+
+    // Pages that have been created so far, by name.
+    property var createdPages: ({})
+
+    readonly property var pageComponents: ({
+        "steamVR": steamVRPageComponent,
+        "chaperone": chaperonePageComponent,
+        "chaperoneWarnings": chaperoneWarningsPageComponent,
+        "chaperoneAdditional": chaperoneAdditionalPageComponent,
+        "steamVRTXRX": steamVRTXRXPageComponent,
+        "playspace": playspacePageComponent,
+        "motion": motionPageComponent,
+        "rotation": rotationPageComponent,
+        "fixFloor": fixFloorPageComponent,
+        "statistics": statisticsPageComponent,
+        "settings": settingsPageComponent,
+        "audio": audioPageComponent,
+        "utilities": utilitiesPageComponent,
+        "video": videoPageComponent
+    })
+
+    function dashboardPage(name) {
+        var page = createdPages[name]
+        if (!page) {
+            page = pageComponents[name].createObject(root)
+            createdPages[name] = page
+        }
+        return page
+    }
+
+    function createNextPage() {
+        for (var name in pageComponents) {
+            if (!createdPages[name]) {
+                dashboardPage(name)
+                return true
+            }
+        }
+        return false
+    }
+
+    Timer {
+        id: pagePreloadTimer
+        interval: 500
+        repeat: true
+        onTriggered: {
+            if (!createNextPage()) {
+                stop()
+                OverlayController.logPagesPreloaded()
+            }
+        }
+    }
+
+    Connections {
+        target: OverlayController
+        onFirstOverlayFrameSubmitted: {
+            if (pageLoading === "preload") {
+                pagePreloadTimer.start()
+            }
+        }
+    }
+
+    Component.onCompleted: {
+        if (pageLoading === "eager") {
+            while (createNextPage()) {}
+        } else if (pageLoading === "preload" && OverlayController.m_desktopMode) {
+            // No overlay frames are submitted in desktop mode.
+            pagePreloadTimer.start()
+        }
+    }
+
+    Component {
+        id: steamVRPageComponent
+        SteamVRPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: chaperonePageComponent
+        ChaperonePage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: chaperoneWarningsPageComponent
+        ChaperoneWarningsPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: chaperoneAdditionalPageComponent
+        ChaperoneAdditionalPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: steamVRTXRXPageComponent
+        SteamVRTXRXPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: playspacePageComponent
+        PlayspacePage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: motionPageComponent
+        MotionPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: rotationPageComponent
+        RotationPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: fixFloorPageComponent
+        FixFloorPage {
+            stackView: mainView
+            visible: false
+        }
+    }
+
+    Component {
+        id: statisticsPageComponent
+        StatisticsPage {
+            stackView: mainView
+            visible: false
+        }
+    }
 
-    property SettingsPage settingsPage: SettingsPage {
-        stackView: mainView
-        visible: false
-    }
+    Component {
+        id: settingsPageComponent
+        SettingsPage {
+            stackView: mainView
+            visible: false
+        }
+    }
 
-    property AudioPage audioPage: AudioPage {
-        stackView: mainView
-        visible: false
-    }
+    Component {
+        id: audioPageComponent
+        AudioPage {
+            stackView: mainView
+            visible: false
+        }
+    }
 
-    property UtilitiesPage utilitiesPage: UtilitiesPage {
-        stackView: mainView
-        visible: false
-    }
+    Component {
+        id: utilitiesPageComponent
+        UtilitiesPage {
+            stackView: mainView
+            visible: false
+        }
+    }
 
-    property VideoPage videoPage: VideoPage {
-        stackView: mainView
-        visible:false
+    Component {
+        id: videoPageComponent
+        VideoPage {
+            stackView: mainView
+            visible: false
+        }
     }
 
     StackView {
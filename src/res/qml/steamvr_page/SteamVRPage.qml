@@ -33,7 +33,7 @@ MyStackViewPage {
 
                 onClicked: {
                     MyResources.playFocusChangedSound()
-                    mainView.push(steamVRTXRXPage)
+                    mainView.push(dashboardPage("steamVRTXRX"))
                     SteamVRTabController.updateRXTXList()
                 }
             }
@@ -23,7 +23,12 @@ class SettingValue
         return m_qtInfo;
     }
 
-    virtual void saveValue() = 0;
+    [[nodiscard]] virtual QVariant qtValue() const = 0;
+
+    virtual void saveValue()
+    {
+        saveQtSetting( m_category, m_qtInfo.settingName, qtValue() );
+    }
 
 private:
     const SettingCategory m_category;
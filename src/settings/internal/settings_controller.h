@@ -1,5 +1,6 @@
 #pragma once
 #include <assert.h>
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <easylogging++.h>
@@ -123,6 +124,33 @@ class SettingsController
         m_changedSettings.clear();
     }
 
+    // Captures the values of all changed settings and clears the list. The
+    // result can be written with saveQtSettings() on any thread.
+    [[nodiscard]] std::vector<PendingSettingWrite> takeChangedSettings()
+    {
+        std::vector<PendingSettingWrite> writes;
+        writes.reserve( m_changedSettings.size() );
+
+        for ( std::size_t i = 0; i < m_changedSettings.size(); ++i )
+        {
+            const auto setting = m_changedSettings[i];
+            const auto begin = m_changedSettings.begin();
+            const auto end = begin + static_cast<std::ptrdiff_t>( i );
+            if ( std::find( begin, end, setting ) != end )
+            {
+                continue;
+            }
+
+            writes.push_back( PendingSettingWrite{
+                setting->category(),
+                setting->qtInfo().settingName,
+                setting->qtValue() } );
+        }
+
+        m_changedSettings.clear();
+        return writes;
+    }
+
     void saveAllSettings()
     {
         for ( auto& setting : m_boolSettings )
@@ -334,6 +362,14 @@ class SettingsController
                           SettingCategory::Application,
                           QtInfo{ "desktopModeToggle" },
                           false },
+        BoolSettingValue{ BoolSetting::APPLICATION_overlayDepthStencilDisabled,
+                          SettingCategory::Application,
+                          QtInfo{ "overlayDepthStencilDisabled" },
+                          false },
+        BoolSettingValue{ BoolSetting::APPLICATION_lowPriorityMode,
+                          SettingCategory::Application,
+                          QtInfo{ "lowPriorityMode" },
+                          false },
 
         BoolSettingValue{ BoolSetting::AUDIO_pttEnabled,
                           SettingCategory::Audio,
@@ -467,6 +503,10 @@ class SettingsController
                             SettingCategory::Application,
                             QtInfo{ "appVolume" },
                             0.7 },
+        DoubleSettingValue{ DoubleSetting::APPLICATION_overlayRenderScale,
+                            SettingCategory::Application,
+                            QtInfo{ "overlayRenderScale" },
+                            1.0 },
 
         DoubleSettingValue{ DoubleSetting::VIDEO_brightnessOpacityValue,
                             SettingCategory::Video,
@@ -579,6 +619,10 @@ class SettingsController
                             SettingCategory::Application,
                             QtInfo{ "autoApplyChaperoneName" },
                             nameDefault },
+        StringSettingValue{ StringSetting::APPLICATION_lowPriorityCpus,
+                            SettingCategory::Application,
+                            QtInfo{ "lowPriorityCpus" },
+                            "" },
     };
 
     constexpr static auto intSettingsSize
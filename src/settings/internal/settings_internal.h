@@ -2,6 +2,7 @@
 #include <QSettings>
 #include <string>
 #include <type_traits>
+#include <vector>
 #include "../../overlaycontroller.h"
 
 namespace settings
@@ -84,6 +85,34 @@ void saveQtSetting( const SettingCategory category,
     getQSettings().endGroup();
 }
 
+// Value of a changed setting, captured so that it can be written from another
+// thread.
+struct PendingSettingWrite
+{
+    SettingCategory category;
+    std::string settingName;
+    QVariant value;
+};
+
+void saveQtSettings( const std::vector<PendingSettingWrite>& writes )
+{
+    // QSettings instances must not be shared between threads. Separate
+    // instances for the same file are safe and see each others changes.
+    QSettings s( QSettings::IniFormat,
+                 QSettings::UserScope,
+                 application_strings::applicationOrganizationName,
+                 application_strings::applicationName );
+
+    for ( const auto& write : writes )
+    {
+        s.beginGroup( getQtCategoryName( write.category ).c_str() );
+        s.setValue( write.settingName.c_str(), write.value );
+        s.endGroup();
+    }
+
+    s.sync();
+}
+
 template <typename Value>[[nodiscard]] bool isValidQVariant( const QVariant v )
 {
     auto savedSettingIsValid = v.isValid() && !v.isNull();
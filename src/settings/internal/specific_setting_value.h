@@ -81,21 +81,17 @@ class SpecificSettingValue : public SettingValue
         return SettingValue::qtInfo();
     }
 
-    void saveValue() override
+    [[nodiscard]] QVariant qtValue() const override
     {
         if constexpr ( !std::is_same<Value, std::string>::value )
         {
-            saveQtSetting( SettingValue::category(),
-                           SettingValue::qtInfo().settingName,
-                           m_value );
+            return QVariant( m_value );
         }
         else
         {
             // Special case for std::string because it can't be auto
             // converted to QVariant
-            saveQtSetting( SettingValue::category(),
-                           SettingValue::qtInfo().settingName,
-                           m_value.c_str() );
+            return QVariant( m_value.c_str() );
         }
     }
 
@@ -2,6 +2,7 @@
 #include <easylogging++.h>
 #include "../overlaycontroller.h"
 #include "internal/settings_controller.h"
+#include "../utils/background_worker.h"
 
 namespace settings
 {
@@ -12,6 +13,26 @@ void saveChangedSettings()
     settingController.saveChangedSettings();
 }
 
+void saveChangedSettingsInBackground()
+{
+    const auto writes = settingController.takeChangedSettings();
+    if ( writes.empty() )
+    {
+        return;
+    }
+
+    const auto posted = utils::backgroundWorker.post(
+        [writes]
+        {
+            saveQtSettings( writes );
+            return utils::BackgroundWorker::Completion{};
+        } );
+    if ( !posted )
+    {
+        saveQtSettings( writes );
+    }
+}
+
 void saveAllSettings()
 {
     LOG( INFO ) << "Saving all settings.";
@@ -37,6 +37,8 @@ enum class BoolSetting
     APPLICATION_openXRWorkAround,
     APPLICATION_autoApplyChaperone,
     APPLICATION_desktopModeToggle,
+    APPLICATION_overlayDepthStencilDisabled,
+    APPLICATION_lowPriorityMode,
 
     AUDIO_pttEnabled,
     AUDIO_pttShowNotification,
@@ -79,6 +81,7 @@ enum class DoubleSetting
     PLAYSPACE_dragMult,
 
     APPLICATION_appVolume,
+    APPLICATION_overlayRenderScale,
 
     VIDEO_brightnessOpacityValue,
     VIDEO_colorOverlayOpacity,
@@ -112,9 +115,10 @@ enum class StringSetting
     KEYBOARDSHORTCUT_keyPressSystem,
 
     APPLICATION_autoApplyChaperoneName,
+    APPLICATION_lowPriorityCpus,
 
     // LAST_ENUMERATOR must always be set to the last value
-    LAST_ENUMERATOR = APPLICATION_autoApplyChaperoneName,
+    LAST_ENUMERATOR = APPLICATION_lowPriorityCpus,
 };
 
 enum class IntSetting
@@ -143,6 +147,9 @@ std::string initializeAndGetSettingsPath();
 std::string getSettingsAndValues();
 
 void saveChangedSettings();
+// Same as saveChangedSettings(), but the file is written on the background
+// worker. The values are captured before returning.
+void saveChangedSettingsInBackground();
 
 void saveAllSettings();
 
@@ -5,6 +5,7 @@
 #include "../settings/settings.h"
 #include "../settings/settings_object.h"
 #include "../utils/update_rate.h"
+#include "../openvr/ovr_overlay_wrapper.h"
 #ifdef _WIN32
 #    include "audiomanager/AudioManagerWindows.h"
 #elif __linux__
@@ -101,17 +102,18 @@ void AudioTabController::initStage2()
         return;
     }
 
-    m_pushToTalkValues.pushToTalkPath = *pushToTalkIconFilePath;
-    m_pushToTalkValues.pushToMutePath = *pushToMuteIconFilePath;
+    // Kept relative, ovr_overlay_wrapper caches the decoded images by name.
+    m_pushToTalkValues.pushToTalkPath = pushToTalkIconFilepath;
+    m_pushToTalkValues.pushToMutePath = pushToMuteIconFilepath;
 
-    auto pushToPath = m_pushToTalkValues.pushToTalkPath.c_str();
+    auto pushToPath = m_pushToTalkValues.pushToTalkPath;
     if ( settings::getSetting( settings::BoolSetting::AUDIO_micReversePtt ) )
     {
-        pushToPath = m_pushToTalkValues.pushToMutePath.c_str();
+        pushToPath = m_pushToTalkValues.pushToMutePath;
     }
 
-    vr::VROverlay()->SetOverlayFromFile( m_pushToTalkValues.overlayHandle,
-                                         pushToPath );
+    ovr_overlay_wrapper::setOverlayFromFile( m_pushToTalkValues.overlayHandle,
+                                             pushToPath );
     vr::VROverlay()->SetOverlayWidthInMeters( m_pushToTalkValues.overlayHandle,
                                               0.02f );
     vr::HmdMatrix34_t notificationTransform
@@ -182,11 +184,29 @@ void AudioTabController::eventLoopTick()
         return;
     }
 
-    if ( !eventLoopMutex.try_lock() )
+    // Querying the audio devices can take milliseconds, it is done on the
+    // background worker. Only one poll is in flight at a time.
+    if ( m_audioPollPending )
     {
         return;
     }
+    m_audioPollPending = true;
+    const auto posted
+        = utils::backgroundWorker.post( [this] { return pollAudioDevices(); } );
+    if ( !posted )
+    {
+        m_audioPollPending = false;
+    }
+}
+
+// Runs on the background worker. Must not touch any QObject state, that is
+// done by the returned completion on the Qt thread.
+utils::BackgroundWorker::Completion AudioTabController::pollAudioDevices()
+{
+    AudioDeviceSample sample;
+    sample.generation = m_audioStateGeneration.load();
 
+    // IPC to SteamVR, no lock needed.
     vr::EVRSettingsError vrSettingsError;
     char mirrorDeviceId[1024];
     vr::VRSettings()->GetString( vr::k_pch_audio_Section,
@@ -201,25 +221,133 @@ void AudioTabController::eventLoopTick()
                        << "\" setting: "
                        << vr::VRSettings()->GetSettingsErrorNameFromEnum(
                               vrSettingsError );
+        return [this, sample] { applyAudioDeviceSample( sample ); };
     }
-    if ( lastMirrorDevId.compare( mirrorDeviceId ) != 0 )
+    sample.mirrorDeviceId = mirrorDeviceId;
+
     {
-        audioManager->setMirrorDevice( mirrorDeviceId );
+        std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
+        if ( audioManager->isMirrorValid() )
+        {
+            sample.mirrorVolume = audioManager->getMirrorVolume();
+            sample.mirrorMuted = audioManager->getMirrorMuted();
+        }
+        if ( audioManager->isMicValid() )
+        {
+            sample.micVolume = audioManager->getMicVolume();
+            sample.micMuted = audioManager->getMicMuted();
+        }
+    }
+    sample.valid = true;
+
+    return [this, sample] { applyAudioDeviceSample( sample ); };
+}
+
+void AudioTabController::applyAudioDeviceSample(
+    const AudioDeviceSample& sample )
+{
+    m_audioPollPending = false;
+    if ( !sample.valid )
+    {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock( eventLoopMutex );
+    if ( sample.generation != m_audioStateGeneration.load() )
+    {
+        // Something was changed in the meantime, the sample is outdated.
+        return;
+    }
+
+    if ( lastMirrorDevId != sample.mirrorDeviceId )
+    {
+        // Runs during the tick, a switch is retried with the next poll
+        // rather than waiting for a device write on the worker.
+        std::unique_lock<std::recursive_mutex> device( m_audioDeviceMutex,
+                                                       std::try_to_lock );
+        if ( !device.owns_lock() || m_deviceWritesPending != 0 )
+        {
+            return;
+        }
+        audioManager->setMirrorDevice( sample.mirrorDeviceId );
         findMirrorDeviceIndex( audioManager->getMirrorDevId() );
-        lastMirrorDevId = mirrorDeviceId;
+        lastMirrorDevId = sample.mirrorDeviceId;
+        // The sampled mirror volume belongs to the previous device, the next
+        // poll picks up the new one.
+        return;
     }
+
+    // The sample is what the devices already have, only the state and the
+    // UI are updated.
     if ( m_mirrorDeviceIndex >= 0 )
     {
-        setMirrorVolume( audioManager->getMirrorVolume() );
-        setMirrorMuted( audioManager->getMirrorMuted() );
+        if ( sample.mirrorVolume != m_mirrorVolume )
+        {
+            m_mirrorVolume = sample.mirrorVolume;
+            emit mirrorVolumeChanged( m_mirrorVolume );
+        }
+        if ( sample.mirrorMuted != m_mirrorMuted )
+        {
+            m_mirrorMuted = sample.mirrorMuted;
+            emit mirrorMutedChanged( m_mirrorMuted );
+        }
     }
     if ( m_recordingDeviceIndex >= 0 )
     {
-        setMicVolume( audioManager->getMicVolume() );
-        setMicMuted( audioManager->getMicMuted() );
+        if ( sample.micVolume != m_micVolume )
+        {
+            m_micVolume = sample.micVolume;
+            emit micVolumeChanged( m_micVolume );
+        }
+        if ( sample.micMuted != m_micMuted )
+        {
+            m_micMuted = sample.micMuted;
+            emit micMutedChanged( m_micMuted );
+        }
+    }
+}
+
+/*!
+Applies a volume or mute change to the audio devices. Push-to-talk calls this
+from the tick, so it never waits for the worker: if the worker is reading the
+devices right now, the write is queued on the worker behind the read. Later
+writes queue up behind it as well until it ran, so writes stay in order.
+*/
+void AudioTabController::writeAudioDevice(
+    std::function<void( AudioManager& )> write )
+{
+    if ( !audioManager )
+    {
+        return;
+    }
+    {
+        std::unique_lock<std::recursive_mutex> device( m_audioDeviceMutex,
+                                                       std::try_to_lock );
+        if ( device.owns_lock() && m_deviceWritesPending == 0 )
+        {
+            write( *audioManager );
+            return;
+        }
     }
 
-    eventLoopMutex.unlock();
+    ++m_deviceWritesPending;
+    const auto posted = utils::backgroundWorker.post(
+        [this, write]
+        {
+            {
+                std::lock_guard<std::recursive_mutex> device(
+                    m_audioDeviceMutex );
+                write( *audioManager );
+            }
+            return [this] { --m_deviceWritesPending; };
+        } );
+    if ( !posted )
+    {
+        // The worker's queue is full, which doesn't happen in practice.
+        --m_deviceWritesPending;
+        std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
+        write( *audioManager );
+    }
 }
 
 bool AudioTabController::pttChangeValid()
@@ -274,10 +402,15 @@ void AudioTabController::setMirrorVolume( float value, bool notify )
     if ( value != m_mirrorVolume )
     {
         m_mirrorVolume = value;
-        if ( audioManager->isMirrorValid() )
-        {
-            audioManager->setMirrorVolume( value );
-        }
+        ++m_audioStateGeneration;
+        writeAudioDevice(
+            [value]( AudioManager& manager )
+            {
+                if ( manager.isMirrorValid() )
+                {
+                    manager.setMirrorVolume( value );
+                }
+            } );
         if ( notify )
         {
             emit mirrorVolumeChanged( value );
@@ -291,10 +424,15 @@ void AudioTabController::setMirrorMuted( bool value, bool notify )
     if ( value != m_mirrorMuted )
     {
         m_mirrorMuted = value;
-        if ( audioManager->isMirrorValid() )
-        {
-            audioManager->setMirrorMuted( value );
-        }
+        ++m_audioStateGeneration;
+        writeAudioDevice(
+            [value]( AudioManager& manager )
+            {
+                if ( manager.isMirrorValid() )
+                {
+                    manager.setMirrorMuted( value );
+                }
+            } );
         if ( notify )
         {
             emit mirrorMutedChanged( value );
@@ -308,10 +446,15 @@ void AudioTabController::setMicVolume( float value, bool notify )
     if ( value != m_micVolume )
     {
         m_micVolume = value;
-        if ( audioManager->isMicValid() )
-        {
-            audioManager->setMicVolume( value );
-        }
+        ++m_audioStateGeneration;
+        writeAudioDevice(
+            [value]( AudioManager& manager )
+            {
+                if ( manager.isMicValid() )
+                {
+                    manager.setMicVolume( value );
+                }
+            } );
         if ( notify )
         {
             emit micVolumeChanged( value );
@@ -326,10 +469,15 @@ void AudioTabController::setMicMuted( bool value, bool notify )
     if ( value != m_micMuted )
     {
         m_micMuted = value;
-        if ( audioManager->isMicValid() )
-        {
-            audioManager->setMicMuted( value );
-        }
+        ++m_audioStateGeneration;
+        writeAudioDevice(
+            [value]( AudioManager& manager )
+            {
+                if ( manager.isMicValid() )
+                {
+                    manager.setMicMuted( value );
+                }
+            } );
         if ( notify )
         {
             emit micMutedChanged( value );
@@ -358,15 +506,15 @@ void AudioTabController::setMicReversePtt( bool value, bool notify )
 
     if ( value )
     {
-        vr::VROverlay()->SetOverlayFromFile(
+        ovr_overlay_wrapper::setOverlayFromFile(
             m_pushToTalkValues.overlayHandle,
-            m_pushToTalkValues.pushToMutePath.c_str() );
+            m_pushToTalkValues.pushToMutePath );
     }
     else
     {
-        vr::VROverlay()->SetOverlayFromFile(
+        ovr_overlay_wrapper::setOverlayFromFile(
             m_pushToTalkValues.overlayHandle,
-            m_pushToTalkValues.pushToTalkPath.c_str() );
+            m_pushToTalkValues.pushToTalkPath );
     }
 
     if ( pttEnabled() )
@@ -401,16 +549,19 @@ void AudioTabController::setAudioProfileDefault( bool value, bool notify )
 
 void AudioTabController::onNewRecordingDevice()
 {
+    std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
     findMicDeviceIndex( audioManager->getMicDevId() );
 }
 
 void AudioTabController::onNewPlaybackDevice()
 {
+    std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
     findPlaybackDeviceIndex( audioManager->getPlaybackDevId() );
 }
 
 void AudioTabController::onNewMirrorDevice()
 {
+    std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
     auto devid = audioManager->getMirrorDevId();
     if ( devid.empty() )
     {
@@ -427,6 +578,7 @@ void AudioTabController::onDeviceStateChanged()
 {
     // I'm too lazy to find out which device has changed, so let's invalidate
     // all device lists
+    std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
     m_playbackDevices = audioManager->getPlaybackDevices();
     m_recordingDevices = audioManager->getRecordingDevices();
     findPlaybackDeviceIndex( audioManager->getPlaybackDevId(), false );
@@ -548,6 +700,7 @@ void AudioTabController::setPlaybackDeviceIndex( int index, bool notify )
              && index != m_mirrorDeviceIndex )
         {
             // Code to only change the Device and not apply changes to SteamVR
+            std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
             audioManager->setPlaybackDevice(
                 m_playbackDevices[static_cast<size_t>( index )].id(), notify );
         }
@@ -580,6 +733,8 @@ void AudioTabController::setMirrorDeviceIndex( int index, bool notify )
             }
             else
             {
+                std::lock_guard<std::recursive_mutex> device(
+                    m_audioDeviceMutex );
                 audioManager->setMirrorDevice( "", notify );
             }
         }
@@ -605,6 +760,8 @@ void AudioTabController::setMirrorDeviceIndex( int index, bool notify )
             }
             else
             {
+                std::lock_guard<std::recursive_mutex> device(
+                    m_audioDeviceMutex );
                 audioManager->setMirrorDevice(
                     m_playbackDevices[static_cast<size_t>( index )].id(),
                     notify );
@@ -635,6 +792,13 @@ void AudioTabController::setMicDeviceIndex( int index, bool notify )
             }
             setMicMuted( false, true );
             // code to just change Mic
+            std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
+            // The unmute may still be queued on the worker, it has to reach
+            // the old device before the switch.
+            if ( m_deviceWritesPending != 0 && audioManager->isMicValid() )
+            {
+                audioManager->setMicMuted( false );
+            }
             audioManager->setMicDevice(
                 m_recordingDevices[static_cast<size_t>( index )].id(), notify );
             m_recordingDeviceIndex = index;
@@ -1099,6 +1263,7 @@ void AudioTabController::setDefaultPlayback( int index, bool notify )
     }
     else
     {
+        std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
         audioManager->setPlaybackDevice(
             m_playbackDevices[static_cast<size_t>( index )].id(), notify );
     }
@@ -1122,6 +1287,7 @@ void AudioTabController::setDefaultMic( int index, bool notify )
     }
     else
     {
+        std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
         audioManager->setMicDevice(
             m_recordingDevices[static_cast<size_t>( index )].id(), notify );
     }
@@ -1146,6 +1312,7 @@ void AudioTabController::setDefaultMirror( int index, bool notify )
         }
         else
         {
+            std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
             audioManager->setMirrorDevice( "", notify );
         }
     }
@@ -1167,6 +1334,7 @@ void AudioTabController::setDefaultMirror( int index, bool notify )
         }
         else
         {
+            std::lock_guard<std::recursive_mutex> device( m_audioDeviceMutex );
             audioManager->setMirrorDevice(
                 m_playbackDevices[static_cast<size_t>( index )].id(), notify );
         }
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <QObject>
+#include <atomic>
+#include <functional>
 #include <mutex>
 
 #include "audiomanager/AudioManager.h"
 #include <memory>
 #include "../utils/FrameRateUtils.h"
 #include "../settings/settings_object.h"
+#include "../utils/background_worker.h"
 
 class QQuickWindow;
 // application namespace
@@ -143,6 +146,34 @@ class AudioTabController : public QObject
     std::string lastMirrorDevId;
 
     std::recursive_mutex eventLoopMutex;
+    // Guards every audioManager call, it is used from the Qt thread and the
+    // background worker. The worker holds it only for single device reads,
+    // writes made during the tick never wait for it (see writeAudioDevice()).
+    // Recursive because the audio managers call back into the controller.
+    std::recursive_mutex m_audioDeviceMutex;
+    // Device writes handed to the worker that haven't run yet. Later writes
+    // queue up behind them so that they are applied in order.
+    unsigned m_deviceWritesPending = 0;
+
+    // State of the audio devices as read by the background worker.
+    struct AudioDeviceSample
+    {
+        bool valid = false;
+        uint64_t generation = 0;
+        std::string mirrorDeviceId;
+        float mirrorVolume = 0.0f;
+        bool mirrorMuted = false;
+        float micVolume = 0.0f;
+        bool micMuted = false;
+    };
+    // Incremented whenever volume or mute state is changed, so that samples
+    // taken before the change are discarded.
+    std::atomic<uint64_t> m_audioStateGeneration{ 0 };
+    bool m_audioPollPending = false;
+
+    utils::BackgroundWorker::Completion pollAudioDevices();
+    void applyAudioDeviceSample( const AudioDeviceSample& sample );
+    void writeAudioDevice( std::function<void( AudioManager& )> write );
 
     void onPttStart();
     void onPttStop();
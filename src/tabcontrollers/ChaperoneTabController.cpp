@@ -1,10 +1,13 @@
 #include "ChaperoneTabController.h"
 #include <QQuickWindow>
 #include "../overlaycontroller.h"
+#include "../openvr/ovr_recorded_queries.h"
 #include "../settings/settings.h"
 #include "../utils/Matrix.h"
 #include "../quaternion/quaternion.h"
 #include "../utils/update_rate.h"
+#include "../utils/frame_budget_governor.h"
+#include "../utils/controller_roles.h"
 #include <cmath>
 
 // application namespace
@@ -20,7 +23,9 @@ void ChaperoneTabController::initStage1()
 
     reloadChaperoneProfiles();
     initCenterMarkerOverlay();
-    eventLoopTick( m_trackingUniverse, nullptr );
+    utils::FrameContext initialFrame;
+    initialFrame.universe = m_trackingUniverse;
+    eventLoopTick( initialFrame );
 }
 
 void ChaperoneTabController::initStage2( OverlayController* var_parent )
@@ -70,10 +75,8 @@ void ChaperoneTabController::saveChaperoneProfiles()
 
 void ChaperoneTabController::handleChaperoneWarnings( float distance )
 {
-    vr::VRControllerState_t hmdState;
-    vr::VRSystem()->GetControllerState( vr::k_unTrackedDeviceIndex_Hmd,
-                                        &hmdState,
-                                        sizeof( vr::VRControllerState_t ) );
+    const auto hmdState = ovr_recorded_queries::controllerState(
+        vr::k_unTrackedDeviceIndex_Hmd );
     // If proximity Sensor is True (only can be true if exists)
     // Then use prox sensor else use hmd activity level.
     // Needed as detection since the "has prox sensor" property is unreliable.
@@ -130,16 +133,16 @@ void ChaperoneTabController::handleChaperoneWarnings( float distance )
                 m_chaperoneHapticFeedbackThread = std::thread(
                     [&]( ChaperoneTabController* _this )
                     {
-                        auto leftIndex
-                            = vr::VRSystem()
-                                  ->GetTrackedDeviceIndexForControllerRole(
-                                      vr::TrackedControllerRole_LeftHand );
-                        auto rightIndex
-                            = vr::VRSystem()
-                                  ->GetTrackedDeviceIndexForControllerRole(
-                                      vr::TrackedControllerRole_RightHand );
+                        // A proximity warning, keeps normal priority even
+                        // in low priority mode.
                         while ( _this->m_chaperoneHapticFeedbackActive )
                         {
+                            auto leftIndex
+                                = utils::controllerRoles.indexForRole(
+                                    vr::TrackedControllerRole_LeftHand );
+                            auto rightIndex
+                                = utils::controllerRoles.indexForRole(
+                                    vr::TrackedControllerRole_RightHand );
                             // AS it stands both controllers will vibrate
                             // regardless of which is closer to boundary
                             // haptic Frequency is 0-320Hz
@@ -221,7 +224,7 @@ void ChaperoneTabController::handleChaperoneWarnings( float distance )
         float activationDistance = chaperoneShowDashboardDistance();
         if ( distance <= activationDistance && !m_chaperoneShowDashboardActive )
         {
-            if ( !vr::VROverlay()->IsDashboardVisible() )
+            if ( !ovr_recorded_queries::dashboardVisible() )
             {
                 vr::VROverlay()->ShowDashboard(
                     application_strings::applicationKey );
@@ -236,13 +239,13 @@ void ChaperoneTabController::handleChaperoneWarnings( float distance )
     }
 }
 
-void ChaperoneTabController::eventLoopTick(
-    vr::ETrackingUniverseOrigin universe,
-    vr::TrackedDevicePose_t* devicePoses )
+void ChaperoneTabController::eventLoopTick( const utils::FrameContext& frame )
 {
-    m_trackingUniverse = universe;
+    m_trackingUniverse = frame.universe;
 
-    if ( centerMarkerNew() )
+    if ( centerMarkerNew()
+         && utils::frameBudgetGovernor.shouldRun(
+             utils::DeferrableSubject::CenterMarkerRotationCount ) )
     {
         // This Runs Independently of Updates to orientation and position of
         // center Marker This also only runs Every ~.5 seconds
@@ -270,31 +273,26 @@ void ChaperoneTabController::eventLoopTick(
         }
     }
 
-    if ( devicePoses )
+    if ( frame.hasPoses )
     {
         m_isHMDActive = false;
-        std::lock_guard<std::recursive_mutex> lock(
-            parent->chaperoneUtils().mutex() );
         auto minDistance = NAN;
-        auto& poseHmd = devicePoses[vr::k_unTrackedDeviceIndex_Hmd];
+        const auto& poseHmd = frame.hmdPose();
 
         // m_isHMDActive is true when prox sensor OR HMD is moving (~10 seconds
         // to update from OVR)
         // THIS IS A WORK-AROUND Until proper binding support/calls are made
         // availble for prox sensor
-        if ( vr::VRSystem()->GetTrackedDeviceActivityLevel(
+        if ( ovr_recorded_queries::deviceActivityLevel(
                  vr::k_unTrackedDeviceIndex_Hmd )
              == vr::k_EDeviceActivityLevel_UserInteraction )
         {
             m_isHMDActive = true;
         }
-        if ( poseHmd.bPoseIsValid && poseHmd.bDeviceIsConnected
-             && poseHmd.eTrackingResult == vr::TrackingResult_Running_OK )
+        if ( frame.isHmdPoseValid() )
         {
-            auto distanceHmd = parent->chaperoneUtils().getDistanceToChaperone(
-                { poseHmd.mDeviceToAbsoluteTracking.m[0][3],
-                  poseHmd.mDeviceToAbsoluteTracking.m[1][3],
-                  poseHmd.mDeviceToAbsoluteTracking.m[2][3] } );
+            const auto& distanceHmd
+                = frame.chaperone[vr::k_unTrackedDeviceIndex_Hmd];
             if ( !std::isnan( distanceHmd.distance ) )
             {
                 minDistance = distanceHmd.distance;
@@ -320,47 +318,19 @@ void ChaperoneTabController::eventLoopTick(
                 }
             }
         }
-        auto leftIndex = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-            vr::TrackedControllerRole_LeftHand );
-        if ( leftIndex != vr::k_unTrackedDeviceIndexInvalid )
+        for ( const auto handIndex :
+              { frame.leftHandIndex, frame.rightHandIndex } )
         {
-            auto& poseLeft = devicePoses[leftIndex];
-            if ( poseLeft.bPoseIsValid && poseLeft.bDeviceIsConnected
-                 && poseLeft.eTrackingResult == vr::TrackingResult_Running_OK )
+            if ( !frame.isPoseValid( handIndex ) )
             {
-                auto distanceLeft
-                    = parent->chaperoneUtils().getDistanceToChaperone(
-                        { poseLeft.mDeviceToAbsoluteTracking.m[0][3],
-                          poseLeft.mDeviceToAbsoluteTracking.m[1][3],
-                          poseLeft.mDeviceToAbsoluteTracking.m[2][3] } );
-                if ( !std::isnan( distanceLeft.distance )
-                     && ( std::isnan( minDistance )
-                          || distanceLeft.distance < minDistance ) )
-                {
-                    minDistance = distanceLeft.distance;
-                }
+                continue;
             }
-        }
-        auto rightIndex
-            = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-                vr::TrackedControllerRole_RightHand );
-        if ( rightIndex != vr::k_unTrackedDeviceIndexInvalid )
-        {
-            auto& poseRight = devicePoses[rightIndex];
-            if ( poseRight.bPoseIsValid && poseRight.bDeviceIsConnected
-                 && poseRight.eTrackingResult == vr::TrackingResult_Running_OK )
+            const auto& distanceHand = frame.chaperone[handIndex];
+            if ( !std::isnan( distanceHand.distance )
+                 && ( std::isnan( minDistance )
+                      || distanceHand.distance < minDistance ) )
             {
-                auto distanceRight
-                    = parent->chaperoneUtils().getDistanceToChaperone(
-                        { poseRight.mDeviceToAbsoluteTracking.m[0][3],
-                          poseRight.mDeviceToAbsoluteTracking.m[1][3],
-                          poseRight.mDeviceToAbsoluteTracking.m[2][3] } );
-                if ( !std::isnan( distanceRight.distance )
-                     && ( std::isnan( minDistance )
-                          || distanceRight.distance < minDistance ) )
-                {
-                    minDistance = distanceRight.distance;
-                }
+                minDistance = distanceHand.distance;
             }
         }
         if ( !std::isnan( minDistance ) )
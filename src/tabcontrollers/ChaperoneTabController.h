@@ -9,6 +9,7 @@
 #include <cmath>
 #include "../utils/FrameRateUtils.h"
 #include "../utils/ChaperoneUtils.h"
+#include "../utils/frame_context.h"
 #include "../settings/settings_object.h"
 #include "MoveCenterTabController.h"
 #include "../openvr/ovr_overlay_wrapper.h"
@@ -400,8 +401,7 @@ class ChaperoneTabController : public QObject
     void initStage1();
     void initStage2( OverlayController* parent );
 
-    void eventLoopTick( vr::ETrackingUniverseOrigin universe,
-                        vr::TrackedDevicePose_t* devicePoses );
+    void eventLoopTick( const utils::FrameContext& frame );
     void dashboardLoopTick();
     void handleChaperoneWarnings( float distance );
 
@@ -11,16 +11,14 @@ void FixFloorTabController::initStage2( OverlayController* var_parent )
 }
 
 void FixFloorTabController::dashboardLoopTick(
-    vr::TrackedDevicePose_t* devicePoses )
+    const utils::FrameContext& frame )
 {
     if ( state > 0 )
     {
         if ( measurementCount == 0 )
         {
             // Get Controller ids for left/right hand
-            auto leftId
-                = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-                    vr::TrackedControllerRole_LeftHand );
+            auto leftId = frame.leftHandIndex;
             if ( leftId == vr::k_unTrackedDeviceIndexInvalid )
             {
                 statusMessage = "No left controller found.";
@@ -30,9 +28,7 @@ void FixFloorTabController::dashboardLoopTick(
                 state = 0;
                 return;
             }
-            auto rightId
-                = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-                    vr::TrackedControllerRole_RightHand );
+            auto rightId = frame.rightHandIndex;
             if ( rightId == vr::k_unTrackedDeviceIndexInvalid )
             {
                 statusMessage = "No right controller found.";
@@ -43,10 +39,9 @@ void FixFloorTabController::dashboardLoopTick(
                 return;
             }
             // Get poses
-            vr::TrackedDevicePose_t* leftPose = devicePoses + leftId;
-            vr::TrackedDevicePose_t* rightPose = devicePoses + rightId;
-            if ( !leftPose->bPoseIsValid || !leftPose->bDeviceIsConnected
-                 || leftPose->eTrackingResult != vr::TrackingResult_Running_OK )
+            const auto& leftPose = frame.poses[leftId];
+            const auto& rightPose = frame.poses[rightId];
+            if ( !frame.isPoseValid( leftId ) )
             {
                 statusMessage = "Left controller tracking problems.";
                 statusMessageTimeout = 2.0;
@@ -55,9 +50,7 @@ void FixFloorTabController::dashboardLoopTick(
                 state = 0;
                 return;
             }
-            else if ( !rightPose->bPoseIsValid || !rightPose->bDeviceIsConnected
-                      || rightPose->eTrackingResult
-                             != vr::TrackingResult_Running_OK )
+            else if ( !frame.isPoseValid( rightId ) )
             {
                 statusMessage = "Right controller tracking problems.";
                 statusMessageTimeout = 2.0;
@@ -71,8 +64,8 @@ void FixFloorTabController::dashboardLoopTick(
                 // The controller with the lowest y-pos is the floor fix
                 // reference
 
-                if ( leftPose->mDeviceToAbsoluteTracking.m[1][3]
-                     < rightPose->mDeviceToAbsoluteTracking.m[1][3] )
+                if ( leftPose.mDeviceToAbsoluteTracking.m[1][3]
+                     < rightPose.mDeviceToAbsoluteTracking.m[1][3] )
                 {
                     referenceController = leftId;
                 }
@@ -81,7 +74,7 @@ void FixFloorTabController::dashboardLoopTick(
                     referenceController = rightId;
                 }
 
-                auto& m = devicePoses[referenceController]
+                auto& m = frame.poses[referenceController]
                               .mDeviceToAbsoluteTracking.m;
                 tempOffsetX = static_cast<double>( m[0][3] );
                 tempOffsetY = static_cast<double>( m[1][3] );
@@ -106,7 +99,7 @@ void FixFloorTabController::dashboardLoopTick(
         {
             measurementCount++;
             auto& m
-                = devicePoses[referenceController].mDeviceToAbsoluteTracking.m;
+                = frame.poses[referenceController].mDeviceToAbsoluteTracking.m;
 
             double rollDiff = std::atan2( static_cast<double>( m[1][0] ),
                                           static_cast<double>( m[1][1] ) )
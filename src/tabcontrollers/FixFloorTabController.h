@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <openvr.h>
+#include "../utils/frame_context.h"
 
 class QQuickWindow;
 // application namespace
@@ -56,7 +57,7 @@ class FixFloorTabController : public QObject
     void initStage2( OverlayController* parent );
 
     void eventLoopTick( vr::TrackedDevicePose_t* devicePoses );
-    void dashboardLoopTick( vr::TrackedDevicePose_t* devicePoses );
+    void dashboardLoopTick( const utils::FrameContext& frame );
 
     Q_INVOKABLE QString currentStatusMessage();
     Q_INVOKABLE float currentStatusMessageTimeout();
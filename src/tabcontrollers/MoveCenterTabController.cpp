@@ -3,6 +3,9 @@
 #include "../overlaycontroller.h"
 #include "../quaternion/quaternion.h"
 #include "../settings/settings.h"
+#include "../utils/controller_roles.h"
+#include "../openvr/ovr_recorded_queries.h"
+#include <algorithm>
 
 void rotateCoordinates( double coordinates[3], double angle )
 {
@@ -188,9 +191,9 @@ void MoveCenterTabController::outputLogPoses()
     LOG( INFO ) << "HMD POSE (seated universe)";
     outputLogHmdMatrix( hmdSeated );
 
-    auto leftHand = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
+    auto leftHand = utils::controllerRoles.indexForRole(
         vr::TrackedControllerRole_LeftHand );
-    auto rightHand = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
+    auto rightHand = utils::controllerRoles.indexForRole(
         vr::TrackedControllerRole_RightHand );
 
     vr::HmdMatrix34_t leftHandMatrix
@@ -288,6 +291,46 @@ void MoveCenterTabController::setTrackingUniverse( int value, bool notify )
     }
 }
 
+void MoveCenterTabController::flushPropertyChanges()
+{
+    m_propertyChanges.flush( [this]( const SpaceProperty property )
+                             { emitPropertyChanged( property ); } );
+}
+
+void MoveCenterTabController::notifyPropertyChanged(
+    const SpaceProperty property,
+    const bool coalesce )
+{
+    if ( coalesce )
+    {
+        m_propertyChanges.mark( property );
+    }
+    else
+    {
+        emitPropertyChanged( property );
+    }
+}
+
+void MoveCenterTabController::emitPropertyChanged(
+    const SpaceProperty property )
+{
+    switch ( property )
+    {
+    case SpaceProperty::OffsetX:
+        emit offsetXChanged( m_offsetX );
+        break;
+    case SpaceProperty::OffsetY:
+        emit offsetYChanged( m_offsetY );
+        break;
+    case SpaceProperty::OffsetZ:
+        emit offsetZChanged( m_offsetZ );
+        break;
+    case SpaceProperty::Rotation:
+        emit rotationChanged( m_rotation );
+        break;
+    }
+}
+
 float MoveCenterTabController::offsetX() const
 {
     return m_offsetX;
@@ -338,6 +381,18 @@ int MoveCenterTabController::tempRotation() const
 }
 
 void MoveCenterTabController::setRotation( int value, bool notify )
+{
+    rotateSpace( value, notify, false );
+}
+
+void MoveCenterTabController::turnSpace( int value )
+{
+    rotateSpace( value, true, true );
+}
+
+void MoveCenterTabController::rotateSpace( int value,
+                                           bool notify,
+                                           bool coalesce )
 {
     if ( m_rotation != value )
     {
@@ -346,34 +401,18 @@ void MoveCenterTabController::setRotation( int value, bool notify )
             m_rotation = value;
             if ( notify )
             {
-                emit rotationChanged( m_rotation );
+                notifyPropertyChanged( SpaceProperty::Rotation, coalesce );
             }
             return;
         }
 
         double angle = ( value - m_rotation ) * k_centidegreesToRadians;
 
-        // Get hmd pose matrix.
-        vr::TrackedDevicePose_t
-            devicePosesForRot[vr::k_unMaxTrackedDeviceCount];
-
-        // source must be current universe
-        if ( m_trackingUniverse == vr::TrackingUniverseSeated )
-        {
-            vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
-                vr::TrackingUniverseSeated,
-                0.0f,
-                devicePosesForRot,
-                vr::k_unMaxTrackedDeviceCount );
-        }
-        else
-        {
-            vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
-                vr::TrackingUniverseStanding,
-                0.0f,
-                devicePosesForRot,
-                vr::k_unMaxTrackedDeviceCount );
-        }
+        // Get hmd pose matrix, source must be current universe.
+        const auto devicePosesForRot = ovr_recorded_queries::devicePoses(
+            m_trackingUniverse == vr::TrackingUniverseSeated
+                ? vr::TrackingUniverseSeated
+                : vr::TrackingUniverseStanding );
 
         vr::HmdMatrix34_t oldHmdPos
             = devicePosesForRot[0].mDeviceToAbsoluteTracking;
@@ -401,7 +440,7 @@ void MoveCenterTabController::setRotation( int value, bool notify )
         m_rotation = value;
         if ( notify )
         {
-            emit rotationChanged( m_rotation );
+            notifyPropertyChanged( SpaceProperty::Rotation, coalesce );
         }
 
         // Update UI offsets.
@@ -409,8 +448,8 @@ void MoveCenterTabController::setRotation( int value, bool notify )
         m_offsetZ += static_cast<float>( hmdRotDiff[2] );
         if ( notify )
         {
-            emit offsetXChanged( m_offsetX );
-            emit offsetZChanged( m_offsetZ );
+            notifyPropertyChanged( SpaceProperty::OffsetX, coalesce );
+            notifyPropertyChanged( SpaceProperty::OffsetZ, coalesce );
         }
     }
 }
@@ -913,7 +952,7 @@ void MoveCenterTabController::incomingZeroReset()
     // However It does appear to effect the recenter method (potentially other
     // aspects) IN mixed tracking environments I get this issue, the check if
     // there is an error and apply autosaved profile is hopefully a workaround
-    auto calState = vr::VRChaperone()->GetCalibrationState();
+    auto calState = ovr_recorded_queries::calibrationState();
     LOG( INFO ) << "Calibration State on Zero Reset is: " << calState;
 
     // If we detect a seated Recenter and are not currently in process
@@ -941,10 +980,9 @@ void MoveCenterTabController::incomingZeroReset()
     if ( m_recenterStages == 1 )
     {
         LOG( INFO ) << "Recenter Stage 2 re-set zero pos, and reset offsets";
-        vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-            &m_universeCenterForReset );
-        vr::VRChaperoneSetup()->GetWorkingSeatedZeroPoseToRawTrackingPose(
-            &m_seatedCenterForReset );
+        m_universeCenterForReset
+            = ovr_recorded_queries::workingStandingZeroPose();
+        m_seatedCenterForReset = ovr_recorded_queries::workingSeatedZeroPose();
         resetOffsets( true );
         m_recenterStages = 0;
         return;
@@ -955,7 +993,7 @@ void MoveCenterTabController::reset()
 {
     // DO NOT attempt to apply autosaved profile on reset, as it is triggered by
     // the apply chaperone profile Side effects are bad!
-    auto calState = vr::VRChaperone()->GetCalibrationState();
+    auto calState = ovr_recorded_queries::calibrationState();
     LOG( INFO ) << "Calibration State on Reset is: " << calState;
 
     if ( !m_chaperoneBasisAcquired )
@@ -994,11 +1032,9 @@ void MoveCenterTabController::reset()
         m_offsetmatrix = utils::k_forwardUpMatrix;
         if ( m_trackingUniverse == vr::TrackingUniverseSeated )
         {
-            vr::HmdMatrix34_t temp;
             // This is not the floor it should be ~ chair height... this
             // seems to be intended behaviour from openvr
-            vr::VRChaperoneSetup()->GetWorkingSeatedZeroPoseToRawTrackingPose(
-                &temp );
+            const auto temp = ovr_recorded_queries::workingSeatedZeroPose();
             m_offsetmatrix.m[1][3] = temp.m[1][3];
             // TODO check orientation
         }
@@ -1020,9 +1056,7 @@ void MoveCenterTabController::zeroOffsets()
 {
     // first we'll check if we're outside the max commit distance
 
-    vr::HmdMatrix34_t currentCenter;
-    vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-        &currentCenter );
+    const auto currentCenter = ovr_recorded_queries::workingStandingZeroPose();
     double currentCenterYaw = static_cast<double>(
         std::atan2( currentCenter.m[0][2], currentCenter.m[2][2] ) );
     double currentCenterXyz[3]
@@ -1104,10 +1138,10 @@ void MoveCenterTabController::zeroOffsets()
     m_offsetY = 0.0f;
     m_offsetZ = 0.0f;
     m_rotation = 0;
-    emit offsetXChanged( m_offsetX );
-    emit offsetYChanged( m_offsetY );
-    emit offsetZChanged( m_offsetZ );
-    emit rotationChanged( m_rotation );
+    m_propertyChanges.mark( SpaceProperty::OffsetX );
+    m_propertyChanges.mark( SpaceProperty::OffsetY );
+    m_propertyChanges.mark( SpaceProperty::OffsetZ );
+    m_propertyChanges.mark( SpaceProperty::Rotation );
     updateChaperoneResetData();
     m_pendingZeroOffsets = false;
     if ( !m_chaperoneBasisAcquired )
@@ -1115,10 +1149,10 @@ void MoveCenterTabController::zeroOffsets()
         m_chaperoneBasisAcquired = true;
         if ( !m_initComplete )
         {
-            setTrackingUniverse( vr::VRCompositor()->GetTrackingSpace() );
+            setTrackingUniverse( ovr_recorded_queries::trackingSpace() );
             if ( parent->isPreviousShutdownSafe() )
             {
-                auto calState = vr::VRChaperone()->GetCalibrationState();
+                auto calState = ovr_recorded_queries::calibrationState();
                 if ( calState == 200 )
                 {
                     LOG( WARNING )
@@ -1193,7 +1227,7 @@ void MoveCenterTabController::clampVelocity( double* velocity )
 
 void MoveCenterTabController::updateChaperoneResetData()
 {
-    auto cstate = vr::VRChaperone()->GetCalibrationState();
+    auto cstate = ovr_recorded_queries::calibrationState();
     if ( cstate > 199 )
     {
         LOG( WARNING ) << "Chaperone Calibration State is error: " << cstate
@@ -1205,19 +1239,16 @@ void MoveCenterTabController::updateChaperoneResetData()
             vr::EChaperoneConfigFile_Live );
         vr::VRChaperoneSetup()->RevertWorkingCopy();
     }
-    unsigned currentQuadCount = 0;
-    vr::VRChaperoneSetup()->GetWorkingCollisionBoundsInfo( nullptr,
-                                                           &currentQuadCount );
+    const auto bounds = ovr_recorded_queries::workingCollisionBounds();
+    unsigned currentQuadCount = static_cast<unsigned>( bounds.size() );
     m_collisionBoundsForReset = new vr::HmdQuad_t[currentQuadCount];
     // m_collisionBoundsForOffset = new vr::HmdQuad_t[currentQuadCount];
     m_collisionBoundsCountForReset = currentQuadCount;
-    vr::VRChaperoneSetup()->GetWorkingCollisionBoundsInfo(
-        m_collisionBoundsForReset, &currentQuadCount );
+    std::copy( bounds.begin(), bounds.end(), m_collisionBoundsForReset );
 
-    vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-        &m_universeCenterForReset );
-    vr::VRChaperoneSetup()->GetWorkingSeatedZeroPoseToRawTrackingPose(
-        &m_seatedCenterForReset );
+    m_universeCenterForReset
+        = ovr_recorded_queries::workingStandingZeroPose();
+    m_seatedCenterForReset = ovr_recorded_queries::workingSeatedZeroPose();
 
     // updateCollisionBoundsForOffset();
     parent->m_chaperoneTabController.updateHeight( getBoundsBasisMaxY() );
@@ -1248,10 +1279,7 @@ void MoveCenterTabController::applyChaperoneResetData()
 
     vr::VRChaperoneSetup()->CommitWorkingCopy( vr::EChaperoneConfigFile_Live );
 
-    unsigned checkQuadCount = 0;
-    vr::VRChaperoneSetup()->GetWorkingCollisionBoundsInfo( nullptr,
-                                                           &checkQuadCount );
-    if ( checkQuadCount > 0 )
+    if ( !ovr_recorded_queries::workingCollisionBounds().empty() )
     {
         parent->chaperoneUtils().loadChaperoneData( false );
     }
@@ -1899,12 +1927,12 @@ void MoveCenterTabController::resetOffsets( bool resetOffsetsJustPressed )
         m_offsetY = 0.0f;
         m_offsetZ = 0.0f;
         m_rotation = 0;
-        emit offsetXChanged( m_offsetX );
-        emit offsetYChanged( m_offsetY );
-        emit offsetZChanged( m_offsetZ );
-        emit rotationChanged( m_rotation );
+        m_propertyChanges.mark( SpaceProperty::OffsetX );
+        m_propertyChanges.mark( SpaceProperty::OffsetY );
+        m_propertyChanges.mark( SpaceProperty::OffsetZ );
+        m_propertyChanges.mark( SpaceProperty::Rotation );
         updateSpace( true );
-        auto calState = vr::VRChaperone()->GetCalibrationState();
+        auto calState = ovr_recorded_queries::calibrationState();
         LOG( INFO ) << "Calibration State on Reset Offsets is: " << calState;
 
         //        if ( calState > 199 && m_initComplete )
@@ -1944,7 +1972,7 @@ void MoveCenterTabController::snapTurnLeft( bool snapTurnLeftJustPressed )
         newRotationAngleDeg += 36000;
     }
 
-    setRotation( newRotationAngleDeg );
+    turnSpace( newRotationAngleDeg );
 }
 
 void MoveCenterTabController::snapTurnRight( bool snapTurnRightJustPressed )
@@ -1965,7 +1993,7 @@ void MoveCenterTabController::snapTurnRight( bool snapTurnRightJustPressed )
         newRotationAngleDeg += 36000;
     }
 
-    setRotation( newRotationAngleDeg );
+    turnSpace( newRotationAngleDeg );
 }
 
 void MoveCenterTabController::smoothTurnLeft( bool smoothTurnLeftActive )
@@ -1989,7 +2017,7 @@ void MoveCenterTabController::smoothTurnLeft( bool smoothTurnLeftActive )
         newRotationAngleDeg += 36000;
     }
 
-    setRotation( newRotationAngleDeg );
+    turnSpace( newRotationAngleDeg );
 }
 
 void MoveCenterTabController::smoothTurnRight( bool smoothTurnRightActive )
@@ -2013,7 +2041,7 @@ void MoveCenterTabController::smoothTurnRight( bool smoothTurnRightActive )
         newRotationAngleDeg += 36000;
     }
 
-    setRotation( newRotationAngleDeg );
+    turnSpace( newRotationAngleDeg );
 }
 
 void MoveCenterTabController::xAxisLockToggle( bool xAxisLockToggleJustPressed )
@@ -2072,7 +2100,7 @@ void MoveCenterTabController::zAxisLockToggle( bool zAxisLockToggleJustPressed )
 // NOTE this function will create bad output if User Rotates 180 Degrees in
 // 1/7* frame-rate. (Worst Case 30 fps = ~770 deg/s)
 void MoveCenterTabController::updateHmdRotationCounter(
-    vr::TrackedDevicePose_t hmdPose,
+    const vr::TrackedDevicePose_t& hmdPose,
     double angle )
 {
     // If hmd tracking is bad, set m_lastHmdQuaternion invalid
@@ -2158,11 +2186,10 @@ void MoveCenterTabController::updateHmdRotationCounter(
 }
 
 void MoveCenterTabController::updateHandDrag(
-    vr::TrackedDevicePose_t* devicePoses,
+    const utils::FrameContext& frame,
     double angle )
 {
-    auto moveHandId = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-        m_activeDragHand );
+    auto moveHandId = frame.indexForRole( m_activeDragHand );
 
     if ( m_activeDragHand == vr::TrackedControllerRole_Invalid
          || moveHandId == vr::k_unTrackedDeviceIndexInvalid
@@ -2171,9 +2198,9 @@ void MoveCenterTabController::updateHandDrag(
         // detect new release of drag bind
         if ( m_lastMoveHand != vr::TrackedControllerRole_Invalid )
         {
-            emit offsetXChanged( m_offsetX );
-            emit offsetYChanged( m_offsetY );
-            emit offsetZChanged( m_offsetZ );
+            m_propertyChanges.mark( SpaceProperty::OffsetX );
+            m_propertyChanges.mark( SpaceProperty::OffsetY );
+            m_propertyChanges.mark( SpaceProperty::OffsetZ );
 
             // reset gravity update timepoint whenever a space drag was just
             // released
@@ -2183,18 +2210,13 @@ void MoveCenterTabController::updateHandDrag(
         return;
     }
 
-    vr::TrackedDevicePose_t* movePose;
-    movePose = devicePoses + moveHandId;
+    const vr::TrackedDevicePose_t* movePose = &frame.poses[moveHandId];
+    ovr_recorded_queries::DevicePoses seatedDevicePoses;
     if ( m_seatedModeDetected )
     {
-        vr::TrackedDevicePose_t
-            seatedDevicePoses[vr::k_unMaxTrackedDeviceCount];
-        vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
-            vr::TrackingUniverseSeated,
-            0.0f,
-            seatedDevicePoses,
-            vr::k_unMaxTrackedDeviceCount );
-        movePose = seatedDevicePoses + moveHandId;
+        seatedDevicePoses
+            = ovr_recorded_queries::devicePoses( vr::TrackingUniverseSeated );
+        movePose = seatedDevicePoses.data() + moveHandId;
     }
 
     if ( !movePose->bPoseIsValid || !movePose->bDeviceIsConnected
@@ -2276,11 +2298,10 @@ void MoveCenterTabController::updateHandDrag(
 }
 
 void MoveCenterTabController::updateHandTurn(
-    vr::TrackedDevicePose_t* devicePoses,
+    const utils::FrameContext& frame,
     double angle )
 {
-    auto rotateHandId = vr::VRSystem()->GetTrackedDeviceIndexForControllerRole(
-        m_activeTurnHand );
+    auto rotateHandId = frame.indexForRole( m_activeTurnHand );
 
     if ( m_activeTurnHand == vr::TrackedControllerRole_Invalid
          || rotateHandId == vr::k_unTrackedDeviceIndexInvalid
@@ -2293,16 +2314,15 @@ void MoveCenterTabController::updateHandTurn(
         m_lastRotateHand = m_activeTurnHand;
         return;
     }
-    vr::TrackedDevicePose_t* rotatePose = devicePoses + rotateHandId;
-    if ( !rotatePose->bPoseIsValid || !rotatePose->bDeviceIsConnected
-         || rotatePose->eTrackingResult != vr::TrackingResult_Running_OK )
+    if ( !frame.isPoseValid( rotateHandId ) )
     {
         m_lastRotateHand = m_activeTurnHand;
         return;
     }
     // Get hand's rotation.
     // handMatrix is in rotated coordinates.
-    vr::HmdMatrix34_t handMatrix = rotatePose->mDeviceToAbsoluteTracking;
+    vr::HmdMatrix34_t handMatrix
+        = frame.poses[rotateHandId].mDeviceToAbsoluteTracking;
 
     // We need un-rotated coordinates for valid comparison between
     // handQuaternion and lastHandQuaternion. Set up (un)rotation
@@ -2352,7 +2372,7 @@ void MoveCenterTabController::updateHandTurn(
                 newRotationAngleDeg += 36000;
             }
 
-            setRotation( newRotationAngleDeg );
+            turnSpace( newRotationAngleDeg );
         }
     }
     m_lastHandQuaternion = m_handQuaternion;
@@ -2466,9 +2486,9 @@ void MoveCenterTabController::updateGravity()
             m_offsetY = m_gravityFloor;
             m_offsetZ += static_cast<float>( m_velocity[2]
                                              * secondsSinceLastGravityUpdate );
-            emit offsetXChanged( m_offsetX );
-            emit offsetYChanged( m_offsetY );
-            emit offsetZChanged( m_offsetZ );
+            m_propertyChanges.mark( SpaceProperty::OffsetX );
+            m_propertyChanges.mark( SpaceProperty::OffsetY );
+            m_propertyChanges.mark( SpaceProperty::OffsetZ );
         }
 
         // otherwise we're still falling
@@ -2481,9 +2501,9 @@ void MoveCenterTabController::updateGravity()
                                              * secondsSinceLastGravityUpdate );
             m_offsetZ += static_cast<float>( m_velocity[2]
                                              * secondsSinceLastGravityUpdate );
-            emit offsetXChanged( m_offsetX );
-            emit offsetYChanged( m_offsetY );
-            emit offsetZChanged( m_offsetZ );
+            m_propertyChanges.mark( SpaceProperty::OffsetX );
+            m_propertyChanges.mark( SpaceProperty::OffsetY );
+            m_propertyChanges.mark( SpaceProperty::OffsetZ );
 
             // accelerate downward velocity for the next update
             // note: downward is positive y
@@ -2498,7 +2518,7 @@ void MoveCenterTabController::updateGravity()
     if ( m_offsetY > m_gravityFloor )
     {
         m_offsetY = m_gravityFloor;
-        emit offsetYChanged( m_offsetY );
+        m_propertyChanges.mark( SpaceProperty::OffsetY );
     }
     // Touchdown! We've landed, velocity set to 0.
     m_velocity[0] = 0.0;
@@ -2588,9 +2608,8 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
     {
         LOG( INFO ) << "Raw universe center out of bounds ( X: "
                     << offsetUniverseCenterXyz[0] << " )";
-        vr::HmdMatrix34_t standingZero;
-        vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-            &standingZero );
+        const auto standingZero
+            = ovr_recorded_queries::workingStandingZeroPose();
         LOG( INFO ) << "GetWorkingStandingZeroPoseToRawTrackingPose";
         outputLogHmdMatrix( standingZero );
         reset();
@@ -2605,9 +2624,8 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
     {
         LOG( INFO ) << "Raw universe center out of bounds ( Y: "
                     << offsetUniverseCenterXyz[1] << " )";
-        vr::HmdMatrix34_t standingZero;
-        vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-            &standingZero );
+        const auto standingZero
+            = ovr_recorded_queries::workingStandingZeroPose();
         LOG( INFO ) << "GetWorkingStandingZeroPoseToRawTrackingPose";
         outputLogHmdMatrix( standingZero );
         reset();
@@ -2622,9 +2640,8 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
     {
         LOG( INFO ) << "Raw universe center out of bounds ( Z: "
                     << offsetUniverseCenterXyz[2] << " )";
-        vr::HmdMatrix34_t standingZero;
-        vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
-            &standingZero );
+        const auto standingZero
+            = ovr_recorded_queries::workingStandingZeroPose();
         LOG( INFO ) << "GetWorkingStandingZeroPoseToRawTrackingPose";
         outputLogHmdMatrix( standingZero );
         reset();
@@ -2706,9 +2723,7 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
         finalmatrix.m[2][3] = universePlayCenterTempCoords[2];
         if ( m_trackingUniverse == vr::TrackingUniverseSeated )
         {
-            vr::HmdMatrix34_t temp;
-            vr::VRChaperoneSetup()->GetWorkingSeatedZeroPoseToRawTrackingPose(
-                &temp );
+            const auto temp = ovr_recorded_queries::workingSeatedZeroPose();
             finalmatrix.m[1][3] += temp.m[1][3];
         }
 
@@ -2721,10 +2736,10 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
 
     vr::VRChaperoneSetup()->ShowWorkingSetPreview();
 
-    if ( m_collisionBoundsCountForReset > 0 )
-    {
-        parent->chaperoneUtils().loadChaperoneData( false );
-    }
+    // The collision bounds are relative to the standing zero pose and move
+    // with it, so the chaperone geometry cached by ChaperoneUtils is still
+    // valid. Changes to the bounds themselves reload it through
+    // updateChaperoneResetData() or VREvent_ChaperoneUniverseHasChanged.
 
     m_oldOffsetX = m_offsetX;
     m_oldOffsetY = m_offsetY;
@@ -2732,14 +2747,12 @@ void MoveCenterTabController::updateSpace( bool forceUpdate )
     m_oldRotation = m_rotation;
 }
 
-void MoveCenterTabController::eventLoopTick(
-    vr::ETrackingUniverseOrigin universe,
-    vr::TrackedDevicePose_t* devicePoses )
-
+void MoveCenterTabController::eventLoopTick( const utils::FrameContext& frame )
 {
+    const auto universe = frame.universe;
     // detect if room setup is running
     if ( universe == vr::TrackingUniverseRawAndUncalibrated
-         && vr::VRApplications()->GetApplicationProcessId(
+         && ovr_recorded_queries::applicationProcessId(
                 "openvr.tool.steamvr_room_setup" )
                 != 0 )
     {
@@ -2802,7 +2815,7 @@ void MoveCenterTabController::eventLoopTick(
         if ( m_hmdRotationStatsUpdateCounter >= k_hmdRotationCounterUpdateRate )
         {
             // device pose index 0 is always the hmd
-            updateHmdRotationCounter( devicePoses[0], angle );
+            updateHmdRotationCounter( frame.hmdPose(), angle );
             m_hmdRotationStatsUpdateCounter = 0;
         }
         else
@@ -2847,7 +2860,7 @@ void MoveCenterTabController::eventLoopTick(
             if ( m_turnComfortFrameSkipCounter >= static_cast<unsigned>(
                      ( turnComfortFactor() * turnComfortFactor() ) ) )
             {
-                updateHandTurn( devicePoses, angle );
+                updateHandTurn( frame, angle );
                 m_turnComfortFrameSkipCounter = 0;
             }
             else
@@ -2861,7 +2874,7 @@ void MoveCenterTabController::eventLoopTick(
             if ( m_dragComfortFrameSkipCounter >= static_cast<unsigned>(
                      ( dragComfortFactor() * dragComfortFactor() ) ) )
             {
-                updateHandDrag( devicePoses, angle );
+                updateHandDrag( frame, angle );
                 m_lastDragUpdateTimePoint = std::chrono::steady_clock::now();
                 m_dragComfortFrameSkipCounter = 0;
             }
@@ -7,6 +7,8 @@
 #include <qmath.h>
 #include "../utils/Matrix.h"
 #include "../utils/FrameRateUtils.h"
+#include "../utils/frame_context.h"
+#include "../utils/change_coalescer.h"
 #include "../settings/settings_object.h"
 
 class QQuickWindow;
@@ -217,10 +219,10 @@ class MoveCenterTabController : public QObject
     // vr::HmdQuad_t* m_collisionBoundsForOffset;
     // void updateCollisionBoundsForOffset();
 
-    void updateHmdRotationCounter( vr::TrackedDevicePose_t hmdPose,
+    void updateHmdRotationCounter( const vr::TrackedDevicePose_t& hmdPose,
                                    double angle );
-    void updateHandDrag( vr::TrackedDevicePose_t* devicePoses, double angle );
-    void updateHandTurn( vr::TrackedDevicePose_t* devicePoses, double angle );
+    void updateHandDrag( const utils::FrameContext& frame, double angle );
+    void updateHandTurn( const utils::FrameContext& frame, double angle );
     void updateGravity();
     void updateSpace( bool forceUpdate = false );
     void clampVelocity( double* velocity );
@@ -230,12 +232,45 @@ class MoveCenterTabController : public QObject
 
     std::vector<OffsetProfile> m_offsetProfiles;
 
+public:
+    // Properties that change every tick while the space moves. Changes made
+    // by the tick only mark them, their NOTIFY signals are emitted by
+    // flushPropertyChanges(). Changes made through the slots emit at once.
+    enum class SpaceProperty
+    {
+        OffsetX,
+        OffsetY,
+        OffsetZ,
+        Rotation,
+        // LAST_ENUMERATOR must always be set to the last value
+        LAST_ENUMERATOR = Rotation,
+    };
+
+private:
+    utils::ChangeCoalescer<SpaceProperty> m_propertyChanges;
+    void rotateSpace( int value, bool notify, bool coalesce );
+    void notifyPropertyChanged( SpaceProperty property, bool coalesce );
+    void emitPropertyChanged( SpaceProperty property );
+
 public:
     void initStage1();
     void initStage2( OverlayController* parent );
 
-    void eventLoopTick( vr::ETrackingUniverseOrigin universe,
-                        vr::TrackedDevicePose_t* devicePoses );
+    void eventLoopTick( const utils::FrameContext& frame );
+    // Emits the signals of the properties changed since the last call.
+    void flushPropertyChanges();
+    // setRotation() for the tick, the signals wait for the next flush.
+    void turnSpace( int value );
+    [[nodiscard]] utils::ChangeCoalescer<SpaceProperty>&
+        propertyChanges() noexcept
+    {
+        return m_propertyChanges;
+    }
+    [[nodiscard]] const utils::ChangeCoalescer<SpaceProperty>&
+        propertyChanges() const noexcept
+    {
+        return m_propertyChanges;
+    }
 
     float offsetX() const;
     float offsetY() const;
@@ -3,17 +3,15 @@
 #include "../overlaycontroller.h"
 #include "../settings/settings.h"
 #include "../utils/Matrix.h"
+#include "../openvr/ovr_overlay_wrapper.h"
+#include "../openvr/ovr_recorded_queries.h"
 #include "../quaternion/quaternion.h"
 #include <cmath>
 
 // application namespace
 namespace advsettings
 {
-void RotationTabController::initStage1()
-{ // TODO adjust update rate
-  // m_chaperoneSettingsUpdateCounter
-  //   = utils::adjustUpdateRate( k_chaperoneSettingsUpdateCounter );
-}
+void RotationTabController::initStage1() {}
 
 void RotationTabController::initStage2( OverlayController* var_parent )
 {
@@ -51,13 +49,12 @@ void RotationTabController::initStage2( OverlayController* var_parent )
         return;
     }
 
-    m_autoturnValues.autoturnPath = *autoturnIconFilePath;
-    m_autoturnValues.noautoturnPath = *noautoturnIconFilePath;
-
-    auto pushToPath = m_autoturnValues.autoturnPath.c_str();
+    // Kept relative, ovr_overlay_wrapper caches the decoded images by name.
+    m_autoturnValues.autoturnPath = autoturnIconFilepath;
+    m_autoturnValues.noautoturnPath = noautoturnIconFilepath;
 
-    vr::VROverlay()->SetOverlayFromFile( m_autoturnValues.overlayHandle,
-                                         pushToPath );
+    ovr_overlay_wrapper::setOverlayFromFile( m_autoturnValues.overlayHandle,
+                                             m_autoturnValues.autoturnPath );
     vr::VROverlay()->SetOverlayWidthInMeters( m_autoturnValues.overlayHandle,
                                               0.02f );
     vr::HmdMatrix34_t notificationTransform
@@ -74,54 +71,60 @@ void RotationTabController::initStage2( OverlayController* var_parent )
     this->parent = var_parent;
 }
 
-void RotationTabController::eventLoopTick(
-    vr::TrackedDevicePose_t* devicePoses )
+void RotationTabController::eventLoopTick( const utils::FrameContext& frame )
 {
-    if ( devicePoses )
+    if ( frame.hasPoses )
     {
         m_isHMDActive = false;
-        std::lock_guard<std::recursive_mutex> lock(
-            parent->chaperoneUtils().mutex() );
-        auto& poseHmd = devicePoses[vr::k_unTrackedDeviceIndex_Hmd];
+        const auto& poseHmd = frame.hmdPose();
 
         // m_isHMDActive is true when prox sensor OR HMD is moving (~10 seconds
         // to update from OVR)
         // THIS IS A WORK-AROUND Until proper binding support/calls are made
         // availble for prox sensor
-        if ( vr::VRSystem()->GetTrackedDeviceActivityLevel(
+        if ( ovr_recorded_queries::deviceActivityLevel(
                  vr::k_unTrackedDeviceIndex_Hmd )
              == vr::k_EDeviceActivityLevel_UserInteraction )
         {
             m_isHMDActive = true;
         }
-        if ( poseHmd.bPoseIsValid && poseHmd.bDeviceIsConnected
-             && poseHmd.eTrackingResult == vr::TrackingResult_Running_OK )
+        if ( frame.isHmdPoseValid() )
         {
-            auto chaperoneDistances
-                = parent->chaperoneUtils().getDistancesToChaperone(
-                    { poseHmd.mDeviceToAbsoluteTracking.m[0][3],
-                      poseHmd.mDeviceToAbsoluteTracking.m[1][3],
-                      poseHmd.mDeviceToAbsoluteTracking.m[2][3] } );
+            // Don't take the movement since the last tick into account if
+            // the chaperone changed in between.
+            const auto quadsCount = parent->chaperoneUtils().quadsCount();
+            if ( quadsCount != m_chaperoneQuadsCountLast )
+            {
+                m_chaperoneQuadsCountLast = quadsCount;
+                m_autoTurnLastHmdUpdate = poseHmd.mDeviceToAbsoluteTracking;
+            }
+            const auto& nearestWall
+                = frame.chaperone[vr::k_unTrackedDeviceIndex_Hmd];
 
-            // Autoturn mode
+            // Autoturn mode, the only one that needs the distance to every
+            // wall.
             if ( RotationTabController::autoTurnEnabled() )
             {
-                doAutoTurn( poseHmd, chaperoneDistances );
+                parent->chaperoneUtils().getDistancesToChaperone(
+                    { poseHmd.mDeviceToAbsoluteTracking.m[0][3],
+                      poseHmd.mDeviceToAbsoluteTracking.m[1][3],
+                      poseHmd.mDeviceToAbsoluteTracking.m[2][3] },
+                    m_chaperoneDistances );
+                doAutoTurn( frame, m_chaperoneDistances );
             }
             // Vestibular motion. Dependent on autoTurn so the playspace
             // doesn't move when you use the keybind
             if ( RotationTabController::vestibularMotionEnabled() )
             {
-                doVestibularMotion( poseHmd, chaperoneDistances );
+                doVestibularMotion( frame, nearestWall );
             }
 
             if ( RotationTabController::viewRatchettingEnabled() )
             {
-                doViewRatchetting( poseHmd, chaperoneDistances );
+                doViewRatchetting( frame, nearestWall );
             }
 
             m_autoTurnLastHmdUpdate = poseHmd.mDeviceToAbsoluteTracking;
-            m_autoTurnChaperoneDistancesLast = std::move( chaperoneDistances );
         }
     }
     if ( m_autoTurnNotificationTimestamp )
@@ -150,45 +153,24 @@ void RotationTabController::eventLoopTick(
 }
 
 void RotationTabController::doViewRatchetting(
-    const vr::TrackedDevicePose_t& poseHmd,
-    const std::vector<utils::ChaperoneQuadData>& chaperoneDistances )
+    const utils::FrameContext& frame,
+    const utils::NearestSegment& nearestWall )
 {
-    if ( m_isHMDActive && poseHmd.bPoseIsValid && poseHmd.bDeviceIsConnected
-         && poseHmd.eTrackingResult == vr::TrackingResult_Running_OK
-         && !chaperoneDistances.empty() )
+    const auto& poseHmd = frame.hmdPose();
+    if ( m_isHMDActive && frame.isHmdPoseValid()
+         && !std::isnan( nearestWall.distance ) )
     {
-        if ( chaperoneDistances.size()
-             != m_autoTurnChaperoneDistancesLast.size() )
-        {
-            m_autoTurnChaperoneDistancesLast = chaperoneDistances;
-            m_autoTurnLastHmdUpdate = poseHmd.mDeviceToAbsoluteTracking;
-        }
-
-        // Find the (index of the) nearest wall
-        size_t nearestWallIdx = 0;
-        for ( size_t i = 0; i < chaperoneDistances.size(); i++ )
-        {
-            if ( chaperoneDistances[i].distance
-                 < chaperoneDistances[nearestWallIdx].distance )
-            {
-                nearestWallIdx = i;
-            }
-        }
-        const auto& nearestWall = chaperoneDistances[nearestWallIdx];
-
-        // Convert pose matrix to quaternion
-        auto hmdQuaternion
-            = quaternion::fromHmdMatrix34( poseHmd.mDeviceToAbsoluteTracking );
+        const auto nearestWallIdx = nearestWall.segment;
 
         // Get HMD raw yaw
-        double hmdYaw = quaternion::getYaw( hmdQuaternion );
+        double hmdYaw = frame.hmdYaw;
 
         // Get angle between HMD position and nearest point on
         // wall
         double hmdPositionToWallYaw = static_cast<double>(
-            std::atan2( nearestWall.nearestPoint.v[0]
+            std::atan2( nearestWall.x
                             - poseHmd.mDeviceToAbsoluteTracking.m[0][3],
-                        nearestWall.nearestPoint.v[2]
+                        nearestWall.z
                             - poseHmd.mDeviceToAbsoluteTracking.m[2][3] ) );
 
         // Get angle between HMD and wall
@@ -218,7 +200,7 @@ void RotationTabController::doViewRatchetting(
                       hmdToWallYaw - m_ratchettingLastHmdRotation, -M_PI, M_PI )
                   * viewRatchettingPercent();
 
-            parent->m_moveCenterTabController.setRotation(
+            parent->m_moveCenterTabController.turnSpace(
                 parent->m_moveCenterTabController.rotation()
                 + static_cast<int>( delta_degrees * k_radiansToCentidegrees ) );
         } while ( false );
@@ -229,19 +211,13 @@ void RotationTabController::doViewRatchetting(
 }
 
 void RotationTabController::doVestibularMotion(
-    const vr::TrackedDevicePose_t& poseHmd,
-    const std::vector<utils::ChaperoneQuadData>& chaperoneDistances )
+    const utils::FrameContext& frame,
+    const utils::NearestSegment& nearestWall )
 {
-    if ( m_isHMDActive && poseHmd.bPoseIsValid && poseHmd.bDeviceIsConnected
-         && poseHmd.eTrackingResult == vr::TrackingResult_Running_OK
-         && !chaperoneDistances.empty() )
+    const auto& poseHmd = frame.hmdPose();
+    if ( m_isHMDActive && frame.isHmdPoseValid()
+         && !std::isnan( nearestWall.distance ) )
     {
-        if ( chaperoneDistances.size()
-             != m_autoTurnChaperoneDistancesLast.size() )
-        {
-            m_autoTurnChaperoneDistancesLast = chaperoneDistances;
-            m_autoTurnLastHmdUpdate = poseHmd.mDeviceToAbsoluteTracking;
-        }
         // Rotate dist/(2*pi*r) where r is
         // m_autoTurnVestibularMotionRadius, as if we had walked
         // however many inches along a circle and the world was
@@ -249,28 +225,16 @@ void RotationTabController::doVestibularMotion(
 
         do
         {
-            // Find the nearest wall
-            const auto& nearestWall
-                = std::min_element( chaperoneDistances.begin(),
-                                    chaperoneDistances.end(),
-                                    []( const auto& quadA, const auto& quadB ) {
-                                        return quadA.distance < quadB.distance;
-                                    } );
-
-            // Convert pose matrix to quaternion
-            auto hmdQuaternion = quaternion::fromHmdMatrix34(
-                poseHmd.mDeviceToAbsoluteTracking );
-
             // Get HMD raw yaw
-            double hmdYaw = quaternion::getYaw( hmdQuaternion );
+            double hmdYaw = frame.hmdYaw;
 
             // Get angle between HMD position and nearest point on
             // wall
             double hmdPositionToWallYaw = static_cast<double>(
                 std::atan2( poseHmd.mDeviceToAbsoluteTracking.m[0][3]
-                                - nearestWall->nearestPoint.v[0],
+                                - nearestWall.x,
                             poseHmd.mDeviceToAbsoluteTracking.m[2][3]
-                                - nearestWall->nearestPoint.v[2] ) );
+                                - nearestWall.z ) );
 
             // Get angle between HMD and wall
             double hmdToWallYaw
@@ -316,18 +280,18 @@ void RotationTabController::doVestibularMotion(
                 0,
                 36000 );
 
-            parent->m_moveCenterTabController.setRotation( newRotationAngle );
+            parent->m_moveCenterTabController.turnSpace( newRotationAngle );
 
         } while ( false );
     }
 }
 
 void RotationTabController::doAutoTurn(
-    const vr::TrackedDevicePose_t& poseHmd,
+    const utils::FrameContext& frame,
     const std::vector<utils::ChaperoneQuadData>& chaperoneDistances )
 {
-    if ( m_isHMDActive && poseHmd.bPoseIsValid && poseHmd.bDeviceIsConnected
-         && poseHmd.eTrackingResult == vr::TrackingResult_Running_OK
+    const auto& poseHmd = frame.hmdPose();
+    if ( m_isHMDActive && frame.isHmdPoseValid()
          && !chaperoneDistances.empty() )
     {
         auto currentTime = std::chrono::steady_clock::now();
@@ -365,7 +329,7 @@ void RotationTabController::doAutoTurn(
                                  0,
                                  36000 );
 
-            parent->m_moveCenterTabController.setRotation(
+            parent->m_moveCenterTabController.turnSpace(
                 newRotationAngleDeg );
             m_autoTurnLinearSmoothTurnRemaining -= miniDeltaAngle;
         }
@@ -377,12 +341,8 @@ void RotationTabController::doAutoTurn(
                      <= RotationTabController::autoTurnActivationDistance()
                  && !m_autoTurnWallActive[i] )
             {
-                // Convert pose matrix to quaternion
-                auto hmdQuaternion = quaternion::fromHmdMatrix34(
-                    poseHmd.mDeviceToAbsoluteTracking );
-
                 // Get HMD raw yaw
-                double hmdYaw = quaternion::getYaw( hmdQuaternion );
+                double hmdYaw = frame.hmdYaw;
 
                 // Get angle between HMD position and nearest point on
                 // wall
@@ -466,20 +426,27 @@ void RotationTabController::doAutoTurn(
                         // we're currently touching, the far corner on
                         // the wall we've just touched, and the corner
                         // between them
-                        const size_t cornerCnt
-                            = parent->chaperoneUtils().quadsCount();
+                        // Corners come from the same version of the
+                        // bounds as the distances, wall j starts at
+                        // corner j.
+                        const size_t cornerCnt = chaperoneDistances.size();
                         const size_t middleCornerIdx
                             = turnLeft ? i
                                        : circularIndex( i, true, cornerCnt );
                         const auto& middleCorner
-                            = parent->chaperoneUtils().getCorner(
-                                middleCornerIdx );
+                            = chaperoneDistances[middleCornerIdx].corners[0];
                         const auto& newWallCorner
-                            = parent->chaperoneUtils().getCorner( circularIndex(
-                                middleCornerIdx, turnLeft, cornerCnt ) );
+                            = chaperoneDistances[circularIndex(
+                                                     middleCornerIdx,
+                                                     turnLeft,
+                                                     cornerCnt )]
+                                  .corners[0];
                         const auto& touchingWallCorner
-                            = parent->chaperoneUtils().getCorner( circularIndex(
-                                middleCornerIdx, !turnLeft, cornerCnt ) );
+                            = chaperoneDistances[circularIndex(
+                                                     middleCornerIdx,
+                                                     !turnLeft,
+                                                     cornerCnt )]
+                                  .corners[0];
 
                         double newWallAngle = static_cast<double>( std::atan2(
                             middleCorner.v[0] - newWallCorner.v[0],
@@ -502,7 +469,7 @@ void RotationTabController::doAutoTurn(
                     switch ( RotationTabController::autoTurnModeType() )
                     {
                     case AutoTurnModes::SNAP:
-                        parent->m_moveCenterTabController.setRotation(
+                        parent->m_moveCenterTabController.turnSpace(
                             parent->m_moveCenterTabController.rotation()
                             + static_cast<int>( delta_degrees ) );
                         break;
@@ -677,15 +644,14 @@ void RotationTabController::setAutoTurnEnabled( bool value, bool notify )
 
     if ( !value )
     {
-        vr::VROverlay()->SetOverlayFromFile(
+        ovr_overlay_wrapper::setOverlayFromFile(
             m_autoturnValues.overlayHandle,
-            m_autoturnValues.noautoturnPath.c_str() );
+            m_autoturnValues.noautoturnPath );
     }
     else
     {
-        vr::VROverlay()->SetOverlayFromFile(
-            m_autoturnValues.overlayHandle,
-            m_autoturnValues.autoturnPath.c_str() );
+        ovr_overlay_wrapper::setOverlayFromFile(
+            m_autoturnValues.overlayHandle, m_autoturnValues.autoturnPath );
     }
 
     if ( autoTurnShowNotification()
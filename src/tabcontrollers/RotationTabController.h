@@ -9,6 +9,7 @@
 #include <optional>
 #include "../utils/FrameRateUtils.h"
 #include "../utils/ChaperoneUtils.h"
+#include "../utils/frame_context.h"
 #include "../settings/settings_object.h"
 #include "MoveCenterTabController.h"
 
@@ -113,7 +114,10 @@ class RotationTabController : public QObject
     std::chrono::steady_clock::time_point m_autoTurnLastUpdate;
     std::vector<bool> m_autoTurnWallActive;
     vr::HmdMatrix34_t m_autoTurnLastHmdUpdate;
-    std::vector<utils::ChaperoneQuadData> m_autoTurnChaperoneDistancesLast;
+    uint32_t m_chaperoneQuadsCountLast = 0;
+    // Reused every tick, so it doesn't allocate once the chaperone has been
+    // seen.
+    std::vector<utils::ChaperoneQuadData> m_chaperoneDistances;
     std::chrono::steady_clock::time_point::duration m_estimatedFrameRate;
     double m_ratchettingLastHmdRotation = 0.0;
     size_t m_ratchettingLastWall = 0;
@@ -124,20 +128,18 @@ class RotationTabController : public QObject
     bool m_isHMDActive = false;
 
     void doAutoTurn(
-        const vr::TrackedDevicePose_t& poseHmd,
-        const std::vector<utils::ChaperoneQuadData>& chaperoneDistances );
-    void doVestibularMotion(
-        const vr::TrackedDevicePose_t& poseHmd,
-        const std::vector<utils::ChaperoneQuadData>& chaperoneDistances );
-    void doViewRatchetting(
-        const vr::TrackedDevicePose_t& poseHmd,
+        const utils::FrameContext& frame,
         const std::vector<utils::ChaperoneQuadData>& chaperoneDistances );
+    void doVestibularMotion( const utils::FrameContext& frame,
+                             const utils::NearestSegment& nearestWall );
+    void doViewRatchetting( const utils::FrameContext& frame,
+                            const utils::NearestSegment& nearestWall );
 
 public:
     void initStage1();
     void initStage2( OverlayController* parent );
 
-    void eventLoopTick( vr::TrackedDevicePose_t* devicePoses );
+    void eventLoopTick( const utils::FrameContext& frame );
 
     float boundsVisibility() const;
 
@@ -2,6 +2,7 @@
 #include <QQuickWindow>
 #include "../overlaycontroller.h"
 #include "../utils/update_rate.h"
+#include "../utils/background_worker.h"
 
 // application namespace
 namespace advsettings
@@ -27,8 +28,32 @@ void SettingsTabController::dashboardLoopTick()
         return;
     }
 
-    setAutoStartEnabled( vr::VRApplications()->GetApplicationAutoLaunch(
-        application_strings::applicationKey ) );
+    if ( m_autoStartPollPending )
+    {
+        return;
+    }
+    m_autoStartPollPending = true;
+    const auto previousValue = m_autoStartEnabled;
+    const auto posted = utils::backgroundWorker.post(
+        [this, previousValue]() -> utils::BackgroundWorker::Completion
+        {
+            const auto enabled
+                = vr::VRApplications()->GetApplicationAutoLaunch(
+                    application_strings::applicationKey );
+            return [this, previousValue, enabled]
+            {
+                m_autoStartPollPending = false;
+                // Don't overwrite a change made while the query ran.
+                if ( m_autoStartEnabled == previousValue )
+                {
+                    setAutoStartEnabled( enabled );
+                }
+            };
+        } );
+    if ( !posted )
+    {
+        m_autoStartPollPending = false;
+    }
 }
 
 bool SettingsTabController::autoStartEnabled() const
@@ -27,6 +27,7 @@ class SettingsTabController : public QObject
     OverlayController* parent;
 
     bool m_autoStartEnabled = false;
+    bool m_autoStartPollPending = false;
 
 public:
     void initStage1();
@@ -1,6 +1,7 @@
 #include "StatisticsTabController.h"
 #include <QQuickWindow>
 #include "../overlaycontroller.h"
+#include "../openvr/ovr_recorded_queries.h"
 
 // application namespace
 namespace advsettings
@@ -10,14 +11,9 @@ void StatisticsTabController::initStage2( OverlayController* var_parent )
     this->parent = var_parent;
 }
 
-void StatisticsTabController::eventLoopTick(
-    vr::TrackedDevicePose_t* devicePoses,
-    float leftSpeed,
-    float rightSpeed )
+void StatisticsTabController::eventLoopTick( const utils::FrameContext& frame )
 {
-    vr::Compositor_CumulativeStats pStats;
-    vr::VRCompositor()->GetCumulativeStats(
-        &pStats, sizeof( vr::Compositor_CumulativeStats ) );
+    const auto pStats = ovr_recorded_queries::cumulativeStats();
     if ( pStats.m_nPid != m_cumStats.m_nPid )
     {
         m_cumStats = pStats;
@@ -29,14 +25,12 @@ void StatisticsTabController::eventLoopTick(
     }
     m_cumStats = pStats;
 
-    auto& m = devicePoses->mDeviceToAbsoluteTracking.m;
+    auto& m = frame.hmdPose().mDeviceToAbsoluteTracking.m;
 
     // Hmd Distance //
     if ( lastPosTimer == 0 )
     {
-        if ( devicePoses[0].bPoseIsValid
-             && devicePoses[0].eTrackingResult
-                    == vr::TrackingResult_Running_OK )
+        if ( frame.isHmdPoseValid() )
         {
             if ( !lastHmdPosValid )
             {
@@ -64,13 +58,13 @@ void StatisticsTabController::eventLoopTick(
     }
 
     // Controller speeds //
-    if ( leftSpeed > m_leftControllerMaxSpeed )
+    if ( frame.leftSpeed > m_leftControllerMaxSpeed )
     {
-        m_leftControllerMaxSpeed = leftSpeed;
+        m_leftControllerMaxSpeed = frame.leftSpeed;
     }
-    if ( rightSpeed > m_rightControllerMaxSpeed )
+    if ( frame.rightSpeed > m_rightControllerMaxSpeed )
     {
-        m_rightControllerMaxSpeed = rightSpeed;
+        m_rightControllerMaxSpeed = frame.rightSpeed;
     }
 
     // HMD Rotation //
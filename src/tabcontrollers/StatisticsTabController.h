@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <openvr.h>
+#include "../utils/frame_context.h"
 
 class QQuickWindow;
 // application namespace
@@ -53,9 +54,7 @@ class StatisticsTabController : public QObject
 public:
     void initStage2( OverlayController* parent );
 
-    void eventLoopTick( vr::TrackedDevicePose_t* devicePoses,
-                        float leftSpeed,
-                        float rightSpeed );
+    void eventLoopTick( const utils::FrameContext& frame );
 
     float hmdDistanceMoved() const;
     float hmdRotations() const;
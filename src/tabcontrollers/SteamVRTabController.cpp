@@ -2,6 +2,7 @@
 #include <QQuickWindow>
 #include "../overlaycontroller.h"
 #include "../utils/update_rate.h"
+#include "../utils/background_worker.h"
 #include <QDesktopServices>
 
 QT_USE_NAMESPACE
@@ -26,7 +27,38 @@ void SteamVRTabController::dashboardLoopTick()
     {
         return;
     }
-    synchSteamVR();
+
+    // Every setting is a round trip to vrserver, they are read on the
+    // background worker and applied on the next tick.
+    if ( m_steamVrSyncPending )
+    {
+        return;
+    }
+    m_steamVrSyncPending = true;
+    const auto generation = m_steamVrSettingsGeneration;
+    // Like the getters, a setting that can't be read keeps its current
+    // value. The current values are taken here, the job doesn't touch the
+    // controller.
+    auto current = currentSteamVrSettings();
+    const auto posted = utils::backgroundWorker.post(
+        [this, generation, current]() -> utils::BackgroundWorker::Completion
+        {
+            auto s = current;
+            readSteamVrSettings( s );
+            return [this, generation, s]
+            {
+                m_steamVrSyncPending = false;
+                // Values the user changed after the read was posted win.
+                if ( generation == m_steamVrSettingsGeneration )
+                {
+                    applySteamVrSettings( s );
+                }
+            };
+        } );
+    if ( !posted )
+    {
+        m_steamVrSyncPending = false;
+    }
 }
 
 void SteamVRTabController::synchSteamVR()
@@ -45,6 +77,75 @@ void SteamVRTabController::synchSteamVR()
     setNoHMD( noHMD() );
 }
 
+SteamVRTabController::SteamVrSettingsSnapshot
+    SteamVRTabController::currentSteamVrSettings() const
+{
+    SteamVrSettingsSnapshot s;
+    s.performanceGraph = m_performanceGraphToggle;
+    s.multipleDriver = m_multipleDriverToggle;
+    s.dnd = m_dnd;
+    s.noFadeToGrid = m_noFadeToGridToggle;
+    s.cameraActive = m_cameraActive;
+    s.cameraCont = m_cameraCont;
+    s.cameraBounds = m_cameraBounds;
+    s.controllerPower = m_controllerPower;
+    s.noHMD = m_noHMD;
+    return s;
+}
+
+void SteamVRTabController::readSteamVrSettings( SteamVrSettingsSnapshot& s )
+{
+    const auto read = []( const char* section, const char* key, bool& value )
+    {
+        const auto p = ovr_settings_wrapper::getBool( section, key );
+        if ( p.first == ovr_settings_wrapper::SettingsError::NoError )
+        {
+            value = p.second;
+        }
+    };
+    read( vr::k_pch_Perf_Section,
+          vr::k_pch_Perf_PerfGraphInHMD_Bool,
+          s.performanceGraph );
+    read( vr::k_pch_SteamVR_Section,
+          vr::k_pch_SteamVR_ActivateMultipleDrivers_Bool,
+          s.multipleDriver );
+    read( vr::k_pch_Notifications_Section,
+          vr::k_pch_Notifications_DoNotDisturb_Bool,
+          s.dnd );
+    read( vr::k_pch_SteamVR_Section,
+          vr::k_pch_SteamVR_DoNotFadeToGrid,
+          s.noFadeToGrid );
+    read( vr::k_pch_Camera_Section,
+          vr::k_pch_Camera_EnableCamera_Bool,
+          s.cameraActive );
+    read( vr::k_pch_Camera_Section,
+          vr::k_pch_Camera_ShowOnController_Bool,
+          s.cameraCont );
+    read( vr::k_pch_Camera_Section,
+          vr::k_pch_Camera_EnableCameraForCollisionBounds_Bool,
+          s.cameraBounds );
+    read( vr::k_pch_Power_Section,
+          vr::k_pch_Power_AutoLaunchSteamVROnButtonPress,
+          s.controllerPower );
+    read( vr::k_pch_SteamVR_Section,
+          vr::k_pch_SteamVR_RequireHmd_String,
+          s.noHMD );
+}
+
+void SteamVRTabController::applySteamVrSettings(
+    const SteamVrSettingsSnapshot& s )
+{
+    setPerformanceGraph( s.performanceGraph );
+    setMultipleDriver( s.multipleDriver );
+    setDND( s.dnd );
+    setNoFadeToGrid( s.noFadeToGrid );
+    setCameraActive( s.cameraActive );
+    setCameraCont( s.cameraCont );
+    setCameraBounds( s.cameraBounds );
+    setControllerPower( s.controllerPower );
+    setNoHMD( s.noHMD );
+}
+
 bool SteamVRTabController::performanceGraph() const
 {
     auto p = ovr_settings_wrapper::getBool(
@@ -62,6 +163,7 @@ void SteamVRTabController::setPerformanceGraph( const bool value,
 {
     if ( m_performanceGraphToggle != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_performanceGraphToggle = value;
         ovr_settings_wrapper::setBool( vr::k_pch_Perf_Section,
                                        vr::k_pch_Perf_PerfGraphInHMD_Bool,
@@ -89,6 +191,7 @@ void SteamVRTabController::setNoHMD( const bool value, const bool notify )
 {
     if ( m_noHMD != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_noHMD = value;
         ovr_settings_wrapper::setBool( vr::k_pch_SteamVR_Section,
                                        vr::k_pch_SteamVR_RequireHmd_String,
@@ -118,6 +221,7 @@ void SteamVRTabController::setMultipleDriver( const bool value,
 {
     if ( m_multipleDriverToggle != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_multipleDriverToggle = value;
         ovr_settings_wrapper::setBool(
             vr::k_pch_SteamVR_Section,
@@ -147,6 +251,7 @@ void SteamVRTabController::setNoFadeToGrid( const bool value,
 {
     if ( m_noFadeToGridToggle != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_noFadeToGridToggle = value;
         ovr_settings_wrapper::setBool( vr::k_pch_SteamVR_Section,
                                        vr::k_pch_SteamVR_DoNotFadeToGrid,
@@ -175,6 +280,7 @@ void SteamVRTabController::setControllerPower( const bool value,
 {
     if ( m_controllerPower != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_controllerPower = value;
         ovr_settings_wrapper::setBool(
             vr::k_pch_Power_Section,
@@ -234,6 +340,7 @@ void SteamVRTabController::setDND( const bool value, const bool notify )
 {
     if ( m_dnd != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_dnd = value;
         ovr_settings_wrapper::setBool(
             vr::k_pch_Notifications_Section,
@@ -266,6 +373,7 @@ void SteamVRTabController::setCameraActive( const bool value,
 {
     if ( m_cameraActive != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_cameraActive = value;
         ovr_settings_wrapper::setBool( vr::k_pch_Camera_Section,
                                        vr::k_pch_Camera_EnableCamera_Bool,
@@ -295,6 +403,7 @@ void SteamVRTabController::setCameraBounds( const bool value,
 {
     if ( m_cameraBounds != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_cameraBounds = value;
         ovr_settings_wrapper::setBool(
             vr::k_pch_Camera_Section,
@@ -323,6 +432,7 @@ void SteamVRTabController::setCameraCont( const bool value, const bool notify )
 {
     if ( m_cameraCont != value )
     {
+        ++m_steamVrSettingsGeneration;
         m_cameraCont = value;
         ovr_settings_wrapper::setBool( vr::k_pch_Camera_Section,
                                        vr::k_pch_Camera_ShowOnController_Bool,
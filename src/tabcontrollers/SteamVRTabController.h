@@ -101,6 +101,29 @@ class SteamVRTabController : public QObject
     void GatherDeviceInfo( DeviceInfo& device );
     void AddUnPairedDevice( DeviceInfo& device, std::string donSN );
     void synchSteamVR();
+
+    // SteamVR settings as read by the background worker.
+    struct SteamVrSettingsSnapshot
+    {
+        bool performanceGraph = false;
+        bool multipleDriver = false;
+        bool dnd = false;
+        bool noFadeToGrid = false;
+        bool cameraActive = false;
+        bool cameraCont = false;
+        bool cameraBounds = false;
+        bool controllerPower = false;
+        bool noHMD = false;
+    };
+    // Taken on the Qt thread.
+    SteamVrSettingsSnapshot currentSteamVrSettings() const;
+    // Runs on the background worker. Settings that can't be read keep the
+    // value s already has.
+    static void readSteamVrSettings( SteamVrSettingsSnapshot& s );
+    void applySteamVrSettings( const SteamVrSettingsSnapshot& s );
+    // Incremented whenever one of the synchronised settings is changed.
+    uint64_t m_steamVrSettingsGeneration = 0;
+    bool m_steamVrSyncPending = false;
     std::vector<QString> getDongleSerialList( std::string deviceString );
     bool isSteamVRTracked( QString sn );
     void applyBindingReq( std::string appID );
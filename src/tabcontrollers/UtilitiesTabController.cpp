@@ -5,6 +5,8 @@
 #include "../keyboard_input/input_sender.h"
 #include "../settings/settings.h"
 #include "../utils/update_rate.h"
+#include "../openvr/ovr_overlay_wrapper.h"
+#include "../openvr/ovr_recorded_queries.h"
 #include <chrono>
 #include <thread>
 
@@ -224,24 +226,13 @@ void UtilitiesTabController::setTrackerOvlEnabled( bool value, bool notify )
     }
 }
 
-QString getBatteryIconPath( int batteryState )
+// Relative to the binary directory, ovr_overlay_wrapper caches the decoded
+// images by this name.
+std::string getBatteryIconFileName( int batteryState )
 {
     constexpr auto batteryPrefix = "/res/img/battery/battery_";
 
-    const auto batteryFullPath
-        = ( batteryPrefix + QString::number( batteryState ) + ".png" )
-              .toStdString();
-
-    const auto batteryPath = paths::binaryDirectoryFindFile( batteryFullPath );
-
-    if ( !batteryPath.has_value() )
-    {
-        LOG( ERROR ) << "Unable to find battery image number '" << batteryState
-                     << "'.";
-        return "";
-    }
-
-    return QString::fromStdString( *batteryPath );
+    return batteryPrefix + std::to_string( batteryState ) + ".png";
 }
 
 vr::VROverlayHandle_t UtilitiesTabController::createBatteryOverlay(
@@ -255,11 +246,10 @@ vr::VROverlayHandle_t UtilitiesTabController::createBatteryOverlay(
         batteryKey.c_str(), batteryKey.c_str(), &handle );
     if ( overlayError == vr::VROverlayError_None )
     {
-        QString batteryIconPath = getBatteryIconPath( 0 );
-        if ( QFile::exists( batteryIconPath ) )
+        if ( ovr_overlay_wrapper::setOverlayFromFile(
+                 handle, getBatteryIconFileName( 0 ), " (battery icon)" )
+             == ovr_overlay_wrapper::OverlayError::NoError )
         {
-            vr::VROverlay()->SetOverlayFromFile(
-                handle, batteryIconPath.toStdString().c_str() );
             vr::VROverlay()->SetOverlayWidthInMeters( handle, 0.045f );
             vr::HmdMatrix34_t notificationTransform;
             if ( style == 1 )
@@ -278,11 +268,6 @@ vr::VROverlayHandle_t UtilitiesTabController::createBatteryOverlay(
                 handle, index, &notificationTransform );
             LOG( INFO ) << "Created battery overlay for device " << index;
         }
-        else
-        {
-            LOG( ERROR ) << "Could not find battery icon \"" << batteryIconPath
-                         << "\"";
-        }
     }
     else
     {
@@ -320,7 +305,7 @@ void UtilitiesTabController::handleTrackerBatOvl()
           i++ )
     {
         vr::ETrackedDeviceClass deviceClass
-            = vr::VRSystem()->GetTrackedDeviceClass( i );
+            = ovr_recorded_queries::deviceClass( i );
         if ( deviceClass
              == vr::ETrackedDeviceClass::TrackedDeviceClass_GenericTracker )
         {
@@ -342,7 +327,7 @@ void UtilitiesTabController::handleTrackerBatOvl()
                 m_batteryVisible[i] = true;
             }
 
-            bool shouldShow = vr::VROverlay()->IsDashboardVisible();
+            bool shouldShow = ovr_recorded_queries::dashboardVisible();
 
             if ( shouldShow != m_batteryVisible[i] )
             {
@@ -357,14 +342,13 @@ void UtilitiesTabController::handleTrackerBatOvl()
                 m_batteryVisible[i] = shouldShow;
             }
 
-            bool hasBatteryStatus
-                = vr::VRSystem()->GetBoolTrackedDeviceProperty(
-                    i,
-                    vr::ETrackedDeviceProperty::
-                        Prop_DeviceProvidesBatteryStatus_Bool );
+            bool hasBatteryStatus = ovr_recorded_queries::boolProperty(
+                i,
+                vr::ETrackedDeviceProperty::
+                    Prop_DeviceProvidesBatteryStatus_Bool );
             if ( hasBatteryStatus )
             {
-                float battery = vr::VRSystem()->GetFloatTrackedDeviceProperty(
+                float battery = ovr_recorded_queries::floatProperty(
                     i,
                     vr::ETrackedDeviceProperty::
                         Prop_DeviceBatteryPercentage_Float );
@@ -377,19 +361,10 @@ void UtilitiesTabController::handleTrackerBatOvl()
                         << "Updating battery overlay for device " << i << " to "
                         << batteryState << "(" << battery << ")"
                         << QString::number( m_batteryOverlayHandles[i] );
-                    QString batteryIconPath
-                        = getBatteryIconPath( batteryState );
-                    if ( QFile::exists( batteryIconPath ) )
-                    {
-                        vr::VROverlay()->SetOverlayFromFile(
-                            m_batteryOverlayHandles[i],
-                            batteryIconPath.toStdString().c_str() );
-                    }
-                    else
-                    {
-                        LOG( ERROR ) << "Could not find battery icon \""
-                                     << batteryIconPath << "\"";
-                    }
+                    ovr_overlay_wrapper::setOverlayFromFile(
+                        m_batteryOverlayHandles[i],
+                        getBatteryIconFileName( batteryState ),
+                        " (battery icon)" );
                     m_batteryState[i] = batteryState;
                 }
             }
@@ -4,6 +4,7 @@
 #include "../settings/settings.h"
 #include "../overlaycontroller.h"
 #include "../utils/update_rate.h"
+#include "../openvr/ovr_recorded_queries.h"
 #include <cmath>
 
 namespace advsettings
@@ -391,7 +392,7 @@ void VideoTabController::synchGain( bool setValue )
 {
     vr::EVRSettingsError vrSettingsError;
 
-    auto red = vr::VRSettings()->GetFloat(
+    auto red = ovr_recorded_queries::settingFloat(
         vr::k_pch_SteamVR_Section,
         vr::k_pch_SteamVR_HmdDisplayColorGainR_Float,
         &vrSettingsError );
@@ -412,7 +413,7 @@ void VideoTabController::synchGain( bool setValue )
                                   static_cast<double>( red ) );
         }
     }
-    auto blue = vr::VRSettings()->GetFloat(
+    auto blue = ovr_recorded_queries::settingFloat(
         vr::k_pch_SteamVR_Section,
         vr::k_pch_SteamVR_HmdDisplayColorGainB_Float,
         &vrSettingsError );
@@ -433,7 +434,7 @@ void VideoTabController::synchGain( bool setValue )
                                   static_cast<double>( blue ) );
         }
     }
-    auto green = vr::VRSettings()->GetFloat(
+    auto green = ovr_recorded_queries::settingFloat(
         vr::k_pch_SteamVR_Section,
         vr::k_pch_SteamVR_HmdDisplayColorGainG_Float,
         &vrSettingsError );
@@ -1,112 +1,134 @@
 #include "ChaperoneUtils.h"
+#include "../openvr/ovr_recorded_queries.h"
 #include <iostream>
+#include <chrono>
 #include <cmath>
+#include <thread>
 
 namespace utils
 {
-std::vector<ChaperoneQuadData>
-    ChaperoneUtils::_getDistancesToChaperone( const vr::HmdVector3_t& x )
+namespace
 {
-    std::vector<ChaperoneQuadData> result;
-    vr::HmdVector3_t* _cornersPtr = _corners.get();
-    for ( uint32_t i = 0; i < _quadsCount; i++ )
+    // Scratch space for the distance kernels. Per thread since readers no
+    // longer share a lock.
+    thread_local std::vector<float> t_distances;
+    thread_local std::vector<float> t_nearestX;
+    thread_local std::vector<float> t_nearestZ;
+
+    // How long loadChaperoneData() spins on readers of the slot it replaces
+    // before it sleeps between checks.
+    constexpr int k_reloadYields = 64;
+    constexpr auto k_reloadBackoff = std::chrono::microseconds( 50 );
+
+} // namespace
+
+ChaperoneUtils::Snapshot::Snapshot(
+    const ChaperoneUtils& chaperoneUtils ) noexcept
+    : m_owner( chaperoneUtils )
+{
+    // Sequentially consistent, the increment has to be visible before
+    // _current is read again.
+    for ( ;; )
     {
-        uint32_t i2 = ( i + 1 ) % _quadsCount;
-        vr::HmdVector3_t& r0 = _cornersPtr[i];
-        vr::HmdVector3_t& r1 = _cornersPtr[i2];
-        float u_x = r1.v[0] - r0.v[0];
-        float u_z = r1.v[2] - r0.v[2];
-        float r = ( ( x.v[0] - r0.v[0] ) * u_x + ( x.v[2] - r0.v[2] ) * u_z )
-                  / ( u_x * u_x + u_z * u_z );
-        // int mode = 0; // 0 .. projected point on segment, 1 .. projected
-        // point outside of segment (r0 closer than r1), 2 .. projected point
-        // outside of segment (r1 closer than r0)
-        float d;
-        float x1_x;
-        float x1_z;
-        if ( r < 0.0f || r > 1.0f )
-        { // projected point outside of segment
-            float d_x = r0.v[0] - x.v[0];
-            float d_z = r0.v[2] - x.v[2];
-            // Crazy casts because clang sees the sqrt call as wanting a double.
-            float d1 = static_cast<float>(
-                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
-            d_x = r1.v[0] - x.v[0];
-            d_z = r1.v[2] - x.v[2];
-            // Crazy casts because clang sees the sqrt call as wanting a double.
-            float d2 = static_cast<float>(
-                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
-            if ( d1 < d2 )
-            {
-                d = d1;
-                x1_x = r0.v[0];
-                x1_z = r0.v[2];
-            }
-            else
-            {
-                d = d2;
-                x1_x = r1.v[0];
-                x1_z = r1.v[2];
-            }
-        }
-        else
-        { // projected point on segment
-            x1_x = r0.v[0] + r * u_x;
-            x1_z = r0.v[2] + r * u_z;
-            float d_x = x1_x - x.v[0];
-            float d_z = x1_z - x.v[2];
-            // Crazy casts because clang sees the sqrt call as wanting a double.
-            d = static_cast<float>(
-                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
+        m_slot = m_owner._current.load();
+        m_owner._readers[m_slot].fetch_add( 1 );
+        if ( m_owner._current.load() == m_slot )
+        {
+            return;
         }
-        ChaperoneQuadData computedQuad;
-        computedQuad.distance = d;
-        computedQuad.nearestPoint = { x1_x, x.v[1], x1_z };
-        computedQuad.corners[0] = r0;
-        computedQuad.corners[1] = r1;
-        result.push_back( computedQuad );
+        // A reload switched slots in between and may be filling this one.
+        m_owner._readers[m_slot].fetch_sub( 1 );
     }
-    return result;
 }
 
-void ChaperoneUtils::loadChaperoneData( bool fromLiveBounds )
+ChaperoneUtils::Snapshot::~Snapshot()
 {
-    std::lock_guard<std::recursive_mutex> lock( _mutex );
+    m_owner._readers[m_slot].fetch_sub( 1 );
+}
 
-    if ( fromLiveBounds )
+void ChaperoneUtils::getDistancesToChaperone(
+    const vr::HmdVector3_t& x,
+    std::vector<ChaperoneQuadData>& result ) const
+{
+    const auto geometry = this->geometry();
+    const auto& segments = geometry->segments;
+    const auto& corners = geometry->corners;
+    segments.distances( x.v[0], x.v[2], t_distances, t_nearestX, t_nearestZ );
+    result.resize( segments.size() );
+    for ( uint32_t i = 0; i < segments.size(); i++ )
     {
-        vr::VRChaperoneSetup()->GetLiveCollisionBoundsInfo( nullptr,
-                                                            &_quadsCount );
+        auto& computedQuad = result[i];
+        computedQuad.distance = t_distances[i];
+        computedQuad.nearestPoint = { t_nearestX[i], x.v[1], t_nearestZ[i] };
+        computedQuad.corners[0] = corners[i];
+        computedQuad.corners[1] = corners[( i + 1 ) % segments.size()];
     }
-    else
+}
+
+ChaperoneQuadData
+    ChaperoneUtils::getDistanceToChaperone( const vr::HmdVector3_t& x,
+                                            std::size_t& segmentHint ) const
+{
+    const auto geometry = this->geometry();
+    const auto& segments = geometry->segments;
+    ChaperoneQuadData nearestQuad;
+    // t_distances and t_nearestX are only scratch space for the linear scan.
+    const auto nearest
+        = segments.size() < ChaperoneSegmentTree::k_minSegments
+              ? segments.nearest( x.v[0], x.v[2], t_distances, t_nearestX )
+              : geometry->segmentTree.nearest(
+                  segments, x.v[0], x.v[2], segmentHint );
+    nearestQuad.distance = nearest.distance;
+    if ( nearest.segment == segments.size() )
     {
-        vr::VRChaperoneSetup()->GetWorkingCollisionBoundsInfo( nullptr,
-                                                               &_quadsCount );
+        segmentHint = ChaperoneSegmentTree::k_noHint;
+        return nearestQuad;
     }
+    segmentHint = nearest.segment;
+    const auto i = nearest.segment;
+    nearestQuad.nearestPoint = { nearest.x, x.v[1], nearest.z };
+    nearestQuad.corners[0] = geometry->corners[i];
+    nearestQuad.corners[1] = geometry->corners[( i + 1 ) % segments.size()];
+    return nearestQuad;
+}
 
-    if ( _quadsCount > 0 )
+void ChaperoneUtils::queryChaperone( const vr::HmdVector3_t* points,
+                                     std::size_t count,
+                                     NearestSegment* results ) const
+{
+    const auto geometry = this->geometry();
+    const auto& segments = geometry->segments;
+    if ( segments.size() < ChaperoneSegmentTree::k_minSegments )
     {
-        std::unique_ptr<vr::HmdQuad_t> quadsBuffer(
-            new vr::HmdQuad_t[_quadsCount] );
-        vr::HmdQuad_t* quadsBufferPtr = quadsBuffer.get();
-        _corners.reset( reinterpret_cast<vr::HmdVector3_t*>(
-            new vr::HmdQuad_t[_quadsCount] ) );
-        vr::HmdVector3_t* _cornersPtr = _corners.get();
-        if ( fromLiveBounds )
-        {
-            vr::VRChaperoneSetup()->GetLiveCollisionBoundsInfo( quadsBufferPtr,
-                                                                &_quadsCount );
-        }
-        else
-        {
-            vr::VRChaperoneSetup()->GetWorkingCollisionBoundsInfo(
-                quadsBufferPtr, &_quadsCount );
-        }
+        // Few enough segments for a single pass over all of them.
+        segments.nearest( points, count, results, t_distances );
+        return;
+    }
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        results[i] = geometry->segmentTree.nearest(
+            segments, points[i].v[0], points[i].v[2], results[i].segment );
+    }
+}
+
+void ChaperoneUtils::loadChaperoneData( bool fromLiveBounds )
+{
+    // Readers keep using the current version while this one is fetched.
+    ChaperoneGeometry geometry;
+    const auto quads = fromLiveBounds
+                           ? ovr_recorded_queries::liveCollisionBounds()
+                           : ovr_recorded_queries::workingCollisionBounds();
+    const auto quadsCount = static_cast<uint32_t>( quads.size() );
 
-        for ( uint32_t i = 0; i < _quadsCount; i++ )
+    if ( quadsCount > 0 )
+    {
+        const vr::HmdQuad_t* quadsBufferPtr = quads.data();
+        auto& corners = geometry.corners;
+        corners.resize( quadsCount );
+        for ( uint32_t i = 0; i < quadsCount; i++ )
         {
-            _cornersPtr[i] = quadsBufferPtr[i].vCorners[0];
-            uint32_t i2 = ( i + 1 ) % _quadsCount;
+            corners[i] = quadsBufferPtr[i].vCorners[0];
+            uint32_t i2 = ( i + 1 ) % quadsCount;
             if ( quadsBufferPtr[i].vCorners[3].v[0]
                      != quadsBufferPtr[i2].vCorners[0].v[0]
                  || quadsBufferPtr[i].vCorners[3].v[1]
@@ -115,10 +137,34 @@ void ChaperoneUtils::loadChaperoneData( bool fromLiveBounds )
                         != quadsBufferPtr[i2].vCorners[0].v[2]
                  || quadsBufferPtr[i].vCorners[0].v[1] != 0.0f )
             {
-                _chaperoneWellFormed = false;
+                geometry.wellFormed = false;
             }
         }
+        geometry.segments.assign( corners.data(), corners.size() );
+    }
+    geometry.segmentTree.build( geometry.segments );
+
+    std::lock_guard<std::mutex> lock( _reloadMutex );
+    const auto next = 1 - _current.load();
+    // Readers that still hold the previous version, or that are about to
+    // notice they picked it up just as it was replaced. A reader holds a
+    // slot for one query, so a few yields are usually enough; after that
+    // back off with short sleeps so a writer sharing a core with a
+    // preempted reader does not keep that reader from finishing.
+    for ( int spins = 0; _readers[next].load() != 0; ++spins )
+    {
+        if ( spins < k_reloadYields )
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for( k_reloadBackoff );
+        }
     }
+    // The old vectors are freed here, on the reloading thread.
+    _slots[next] = std::move( geometry );
+    _current.store( next );
 }
 
 } // end namespace utils
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <openvr.h>
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include "chaperone_segments.h"
+#include "chaperone_segment_tree.h"
 
 namespace utils
 {
@@ -25,72 +29,116 @@ struct ChaperoneQuadData
     }
 };
 
+/*!
+One version of the chaperone bounds, never modified while readers can see it.
+*/
+struct ChaperoneGeometry
+{
+    // Floor corner of every wall quad, wall i runs from corner i to i + 1.
+    std::vector<vr::HmdVector3_t> corners;
+    bool wellFormed = true;
+    ChaperoneSegments segments;
+    ChaperoneSegmentTree segmentTree;
+};
+
+/*!
+The chaperone bounds, double buffered so readers never block.
+
+One slot holds the current ChaperoneGeometry, the other the previous one.
+A Snapshot counts itself as a reader of the current slot and checks that
+the slot is still current afterwards, retrying if a reload switched slots
+in between; that is two atomic operations and no lock. loadChaperoneData()
+fetches and prepares the new bounds without touching either slot, waits
+until the last reader has left the previous slot, fills it and makes it
+current. Readers never allocate or free, the reload does both.
+
+A Snapshot delays the reload after next, so hold it for a query, not a
+tick.
+*/
 class ChaperoneUtils
 {
+public:
+    class Snapshot
+    {
+    public:
+        explicit Snapshot( const ChaperoneUtils& chaperoneUtils ) noexcept;
+        ~Snapshot();
+        Snapshot( const Snapshot& ) = delete;
+        Snapshot& operator=( const Snapshot& ) = delete;
+
+        const ChaperoneGeometry& operator*() const noexcept
+        {
+            return m_owner._slots[m_slot];
+        }
+        const ChaperoneGeometry* operator->() const noexcept
+        {
+            return &m_owner._slots[m_slot];
+        }
+
+    private:
+        const ChaperoneUtils& m_owner;
+        std::size_t m_slot;
+    };
+
 private:
-    std::recursive_mutex _mutex;
-    uint32_t _quadsCount = 0;
-    std::unique_ptr<vr::HmdVector3_t> _corners;
-    bool _chaperoneWellFormed = true;
-    std::vector<ChaperoneQuadData>
-        _getDistancesToChaperone( const vr::HmdVector3_t& point );
+    std::array<ChaperoneGeometry, 2> _slots;
+    std::atomic<std::size_t> _current{ 0 };
+    mutable std::array<std::atomic<uint32_t>, 2> _readers{};
+    // Only serializes reloads against each other.
+    std::mutex _reloadMutex;
 
 public:
-    const vr::HmdVector3_t& getCorner( size_t i ) const noexcept
+    Snapshot geometry() const noexcept
     {
-        return ( _corners.get() )[i];
+        return Snapshot( *this );
     }
     uint32_t quadsCount() const noexcept
     {
-        return _quadsCount;
+        return static_cast<uint32_t>( geometry()->corners.size() );
     }
     bool isChaperoneWellFormed() const noexcept
     {
-        return _chaperoneWellFormed;
-    }
-
-    std::recursive_mutex& mutex() noexcept
-    {
-        return _mutex;
+        return geometry()->wellFormed;
     }
 
     void loadChaperoneData( bool fromLiveBounds = true );
 
-    std::vector<ChaperoneQuadData>
+    // Fills result with one entry per quad. Reusing result between calls
+    // avoids allocating once it is large enough.
+    void
         getDistancesToChaperone( const vr::HmdVector3_t& point,
-                                 bool doLock = false )
+                                 std::vector<ChaperoneQuadData>& result ) const;
+
+    std::vector<ChaperoneQuadData>
+        getDistancesToChaperone( const vr::HmdVector3_t& point ) const
     {
-        if ( doLock )
-        {
-            std::lock_guard<std::recursive_mutex> lock( _mutex );
-            return _getDistancesToChaperone( point );
-        }
-        else
-        {
-            return _getDistancesToChaperone( point );
-        }
+        std::vector<ChaperoneQuadData> result;
+        getDistancesToChaperone( point, result );
+        return result;
     }
 
+    // distance is NAN if there is no chaperone. segmentHint is the nearest
+    // segment of the previous query for the same device, or
+    // ChaperoneSegmentTree::k_noHint, and is updated to this query's nearest
+    // segment. Stale hints after the chaperone changed are ignored.
     ChaperoneQuadData getDistanceToChaperone( const vr::HmdVector3_t& point,
-                                              bool doLock = false )
-    {
-        auto distances = getDistancesToChaperone( point, doLock );
-        if ( distances.empty() )
-        {
-            ChaperoneQuadData ret;
-            ret.distance = NAN;
-            return ret;
-        }
+                                              std::size_t& segmentHint ) const;
 
-        return *std::min_element( distances.begin(),
-                                  distances.end(),
-                                  []( const ChaperoneQuadData& quadA,
-                                      const ChaperoneQuadData& quadB ) {
-                                      return std::isnan( quadA.distance )
-                                             || ( quadA.distance
-                                                  < quadB.distance );
-                                  } );
+    ChaperoneQuadData
+        getDistanceToChaperone( const vr::HmdVector3_t& point ) const
+    {
+        auto segmentHint = ChaperoneSegmentTree::k_noHint;
+        return getDistanceToChaperone( point, segmentHint );
     }
+
+    // Nearest segment to each of count points in a single version of the
+    // bounds, without allocating once the thread's scratch space has grown.
+    // results[i].segment is read first as the hint for points[i]: passing
+    // the previous frame's results for the same devices keeps the segment
+    // tree's queries short. distance is NAN if there is no chaperone.
+    void queryChaperone( const vr::HmdVector3_t* points,
+                         std::size_t count,
+                         NearestSegment* results ) const;
 };
 
 } // end namespace utils
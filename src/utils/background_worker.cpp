@@ -0,0 +1,197 @@
+#include "background_worker.h"
+#include "scheduling_policy.h"
+#include <easylogging++.h>
+#ifdef _WIN32
+#    include <objbase.h>
+#endif
+
+namespace utils
+{
+BackgroundWorker backgroundWorker{};
+
+BackgroundWorker::~BackgroundWorker()
+{
+    stop();
+}
+
+void BackgroundWorker::start()
+{
+    if ( m_running.exchange( true ) )
+    {
+        return;
+    }
+    m_thread = std::thread( &BackgroundWorker::run, this );
+}
+
+void BackgroundWorker::stop()
+{
+    if ( !m_running.exchange( false ) )
+    {
+        return;
+    }
+
+    wakeWorker();
+    if ( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+
+    Completion completion;
+    while ( m_completions.tryPop( completion ) )
+    {
+    }
+}
+
+bool BackgroundWorker::post( Job job )
+{
+    if ( !isRunning() )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto completion = job();
+        recordJobDuration( std::chrono::steady_clock::now() - start );
+        if ( completion )
+        {
+            completion();
+        }
+        return true;
+    }
+
+    if ( !m_jobs.tryPush( std::move( job ) ) )
+    {
+        m_jobsDropped.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    wakeWorker();
+    return true;
+}
+
+void BackgroundWorker::wakeWorker()
+{
+    // The worker checks the queue and goes to sleep while holding the
+    // mutex. Taking it here means the worker either sees the change or is
+    // already waiting, so the notification can't get lost.
+    {
+        std::lock_guard<std::mutex> lock( m_sleepMutex );
+    }
+    m_sleepCondition.notify_one();
+}
+
+std::size_t BackgroundWorker::runCompletions()
+{
+    std::size_t count = 0;
+    Completion completion;
+    while ( m_completions.tryPop( completion ) )
+    {
+        completion();
+        ++count;
+    }
+    return count;
+}
+
+BackgroundWorker::Statistics BackgroundWorker::statistics() const noexcept
+{
+    Statistics s;
+    s.jobsRun = m_jobsRun.load( std::memory_order_relaxed );
+    s.jobsDropped = m_jobsDropped.load( std::memory_order_relaxed );
+    s.busyUs = m_busyUs.load( std::memory_order_relaxed );
+    s.maxJobUs = m_maxJobUs.load( std::memory_order_relaxed );
+    return s;
+}
+
+void BackgroundWorker::resetStatistics() noexcept
+{
+    m_jobsRun.store( 0, std::memory_order_relaxed );
+    m_jobsDropped.store( 0, std::memory_order_relaxed );
+    m_busyUs.store( 0, std::memory_order_relaxed );
+    m_maxJobUs.store( 0, std::memory_order_relaxed );
+}
+
+void BackgroundWorker::run()
+{
+#ifdef _WIN32
+    // AudioTabController reads and writes the endpoint volumes from here.
+    // The Core Audio interfaces are agile, the ones created on the Qt thread
+    // may be called from this apartment; the controller serialises the calls.
+    // Switching devices (IPolicyConfig) stays on the Qt thread.
+    CoInitializeEx( nullptr, COINIT_MULTITHREADED );
+#endif
+    applyThreadRole( ThreadRole::Background );
+
+    while ( m_running.load( std::memory_order_acquire ) )
+    {
+        if ( runNextJob() )
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_sleepMutex );
+        m_sleepCondition.wait(
+            lock,
+            [this]
+            {
+                return !m_jobs.empty()
+                       || !m_running.load( std::memory_order_acquire );
+            } );
+    }
+
+    // Jobs posted before stop() still run, settings writes must not be lost.
+    while ( runNextJob() )
+    {
+    }
+
+#ifdef _WIN32
+    CoUninitialize();
+#endif
+}
+
+bool BackgroundWorker::runNextJob()
+{
+    Job job;
+    if ( !m_jobs.tryPop( job ) )
+    {
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto completion = job();
+    recordJobDuration( std::chrono::steady_clock::now() - start );
+
+    if ( !completion )
+    {
+        return true;
+    }
+
+    // The Qt thread drains completions every tick, so a full queue only
+    // happens while it is stalled. Wait for it instead of losing the result.
+    while ( !m_completions.tryPush( std::move( completion ) ) )
+    {
+        if ( !m_running.load( std::memory_order_acquire ) )
+        {
+            LOG( WARNING ) << "Dropping background job result on shutdown.";
+            break;
+        }
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return true;
+}
+
+void BackgroundWorker::recordJobDuration(
+    const std::chrono::steady_clock::duration duration )
+{
+    const auto microseconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>( duration )
+            .count() );
+
+    m_jobsRun.fetch_add( 1, std::memory_order_relaxed );
+    m_busyUs.fetch_add( microseconds, std::memory_order_relaxed );
+
+    auto previousMax = m_maxJobUs.load( std::memory_order_relaxed );
+    while ( microseconds > previousMax
+            && !m_maxJobUs.compare_exchange_weak(
+                previousMax, microseconds, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "spsc_queue.h"
+
+namespace utils
+{
+/*!
+Runs the non-realtime parts of the main event loop (audio device polling,
+SteamVR settings synchronisation, writing settings to disk) on a separate
+thread so that they can't delay pose driven work.
+
+The Qt thread posts jobs, the worker runs them and hands back a completion.
+Completions run on the Qt thread during the next runCompletions(), which is
+where results are applied to QObjects and signals are emitted. Both
+directions go through a lock-free SPSC queue, so the Qt thread never waits
+for a job. The idle worker sleeps until a job is posted; post() only takes
+the sleep mutex for as long as the worker needs to check the queue.
+
+post() and runCompletions() must only be called from the Qt thread.
+*/
+class BackgroundWorker
+{
+public:
+    // Runs on the Qt thread. May be empty if the job has nothing to apply.
+    using Completion = std::function<void()>;
+    // Runs on the worker thread.
+    using Job = std::function<Completion()>;
+
+    BackgroundWorker() = default;
+    ~BackgroundWorker();
+
+    BackgroundWorker( const BackgroundWorker& ) = delete;
+    BackgroundWorker& operator=( const BackgroundWorker& ) = delete;
+
+    void start();
+    // Runs the jobs that are still queued and joins the worker. Completions
+    // that haven't been collected are dropped.
+    void stop();
+    [[nodiscard]] bool isRunning() const noexcept
+    {
+        return m_running.load( std::memory_order_acquire );
+    }
+
+    // Returns false if the queue is full, the job is dropped in that case.
+    // While the worker isn't running the job and its completion run inline.
+    bool post( Job job );
+    // Returns the number of completions that ran.
+    std::size_t runCompletions();
+
+    struct Statistics
+    {
+        uint64_t jobsRun = 0;
+        uint64_t jobsDropped = 0;
+        uint64_t busyUs = 0;
+        uint64_t maxJobUs = 0;
+    };
+    [[nodiscard]] Statistics statistics() const noexcept;
+    void resetStatistics() noexcept;
+
+private:
+    static constexpr std::size_t k_queueSize = 64;
+
+    void wakeWorker();
+    void run();
+    bool runNextJob();
+    void
+        recordJobDuration( const std::chrono::steady_clock::duration duration );
+
+    SpscQueue<Job, k_queueSize> m_jobs;
+    SpscQueue<Completion, k_queueSize> m_completions;
+
+    std::thread m_thread;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<bool> m_running{ false };
+
+    std::atomic<uint64_t> m_jobsRun{ 0 };
+    std::atomic<uint64_t> m_jobsDropped{ 0 };
+    std::atomic<uint64_t> m_busyUs{ 0 };
+    std::atomic<uint64_t> m_maxJobUs{ 0 };
+};
+
+extern BackgroundWorker backgroundWorker;
+
+} // namespace utils
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace utils
+{
+/*!
+Collects change notifications of properties that are updated every tick, so
+their NOTIFY signals can be emitted once per rendered frame instead.
+
+Every emit re-evaluates the QML bindings of the property, whether or not the
+dashboard is open. Instead of emitting, a controller marks the property as
+changed. OverlayController::renderOverlay asks the controller to flush right
+before each dashboard frame is polished; flush() calls emitChange once for
+every property marked since the last flush, with the value the property has
+at that point. While the dashboard is hidden no frames are rendered and
+nothing is flushed, the first frame after it opens emits everything that
+changed.
+
+Property is an enum class ending in LAST_ENUMERATOR. Must only be used from
+the Qt thread.
+*/
+template <typename Property> class ChangeCoalescer
+{
+public:
+    void mark( const Property property ) noexcept
+    {
+        m_changed.set( static_cast<std::size_t>( property ) );
+        ++m_marked;
+    }
+
+    [[nodiscard]] bool hasChanges() const noexcept
+    {
+        return m_changed.any();
+    }
+
+    template <typename EmitChange> void flush( EmitChange&& emitChange )
+    {
+        if ( m_changed.none() )
+        {
+            return;
+        }
+        // emitChange may mark properties again, they go to the next flush.
+        const auto changed = m_changed;
+        m_changed.reset();
+        for ( std::size_t i = 0; i < changed.size(); ++i )
+        {
+            if ( changed.test( i ) )
+            {
+                ++m_emitted;
+                emitChange( static_cast<Property>( i ) );
+            }
+        }
+    }
+
+    // How many changes were marked and how many signals they turned into.
+    [[nodiscard]] uint64_t markedCount() const noexcept
+    {
+        return m_marked;
+    }
+    [[nodiscard]] uint64_t emittedCount() const noexcept
+    {
+        return m_emitted;
+    }
+    void resetCounters() noexcept
+    {
+        m_marked = 0;
+        m_emitted = 0;
+    }
+
+private:
+    static constexpr auto k_propertyCount
+        = static_cast<std::size_t>( Property::LAST_ENUMERATOR ) + 1;
+
+    std::bitset<k_propertyCount> m_changed;
+    uint64_t m_marked = 0;
+    uint64_t m_emitted = 0;
+};
+
+} // namespace utils
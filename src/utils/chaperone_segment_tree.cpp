@@ -0,0 +1,196 @@
+#include "chaperone_segment_tree.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace utils
+{
+namespace
+{
+    // Balanced over at most 2^32 segments, the depth never gets near this.
+    constexpr std::size_t k_maxStackSize = 64;
+
+} // namespace
+
+void ChaperoneSegmentTree::build( const ChaperoneSegments& segments )
+{
+    clear();
+    m_segmentCount = segments.size();
+    if ( segments.empty() )
+    {
+        return;
+    }
+    // A balanced binary tree over ceil(n / k_leafSize) leaves.
+    m_nodes.reserve( 2 * ( segments.size() / k_leafSize + 1 ) );
+    m_nodes.emplace_back();
+    buildNode( segments, 0, 0, segments.size() );
+}
+
+void ChaperoneSegmentTree::clear() noexcept
+{
+    m_nodes.clear();
+    m_segmentCount = 0;
+}
+
+void ChaperoneSegmentTree::buildNode( const ChaperoneSegments& segments,
+                                      const std::size_t index,
+                                      const std::size_t begin,
+                                      const std::size_t end )
+{
+    // Nodes are addressed by index throughout, m_nodes grows while the
+    // children are built.
+    Node node{};
+    if ( end - begin <= k_leafSize )
+    {
+        node.minX = node.maxX = segments.pointX( begin, 0.0f );
+        node.minZ = node.maxZ = segments.pointZ( begin, 0.0f );
+        for ( auto i = begin; i < end; ++i )
+        {
+            for ( const auto along : { 0.0f, 1.0f } )
+            {
+                const auto x = segments.pointX( i, along );
+                const auto z = segments.pointZ( i, along );
+                node.minX = std::min( node.minX, x );
+                node.minZ = std::min( node.minZ, z );
+                node.maxX = std::max( node.maxX, x );
+                node.maxZ = std::max( node.maxZ, z );
+            }
+        }
+        node.first = static_cast<uint32_t>( begin );
+        node.count = static_cast<uint32_t>( end - begin );
+    }
+    else
+    {
+        // Children are stored next to each other, the left one first.
+        const auto children = m_nodes.size();
+        m_nodes.emplace_back();
+        m_nodes.emplace_back();
+        // Leaf aligned, so only the last leaf can be partly filled.
+        const auto leaves = ( end - begin + k_leafSize - 1 ) / k_leafSize;
+        const auto middle = begin + ( leaves / 2 ) * k_leafSize;
+        buildNode( segments, children, begin, middle );
+        buildNode( segments, children + 1, middle, end );
+
+        const auto& left = m_nodes[children];
+        const auto& right = m_nodes[children + 1];
+        node.minX = std::min( left.minX, right.minX );
+        node.minZ = std::min( left.minZ, right.minZ );
+        node.maxX = std::max( left.maxX, right.maxX );
+        node.maxZ = std::max( left.maxZ, right.maxZ );
+        node.first = static_cast<uint32_t>( children );
+        node.count = 0;
+    }
+    m_nodes[index] = node;
+}
+
+float ChaperoneSegmentTree::squaredDistanceToBox( const Node& node,
+                                                  const float x,
+                                                  const float z ) noexcept
+{
+    const auto dx = std::max( std::max( node.minX - x, x - node.maxX ), 0.0f );
+    const auto dz = std::max( std::max( node.minZ - z, z - node.maxZ ), 0.0f );
+    return dx * dx + dz * dz;
+}
+
+NearestSegment
+    ChaperoneSegmentTree::nearest( const ChaperoneSegments& segments,
+                                   const float x,
+                                   const float z,
+                                   const std::size_t hint,
+                                   std::size_t* segmentsTested ) const
+{
+    NearestSegment result;
+    result.segment = segments.size();
+    if ( m_nodes.empty() || segments.size() != m_segmentCount )
+    {
+        result.distance = NAN;
+        return result;
+    }
+    std::size_t tested = 0;
+
+    auto best = std::numeric_limits<float>::infinity();
+    float bestAlong = 0.0f;
+    if ( hint < segments.size() )
+    {
+        best = segments.squaredDistance( hint, x, z, bestAlong );
+        result.segment = hint;
+        ++tested;
+    }
+
+    // Boxes are measured when their parent is opened and pruned again when
+    // popped, best may have shrunk in between.
+    struct Entry
+    {
+        uint32_t node;
+        float squaredDistance;
+    };
+    std::array<Entry, k_maxStackSize> stack;
+    std::size_t stackSize = 0;
+    stack[stackSize++] = { 0, squaredDistanceToBox( m_nodes[0], x, z ) };
+    while ( stackSize > 0 )
+    {
+        const auto entry = stack[--stackSize];
+        if ( entry.squaredDistance >= best )
+        {
+            continue;
+        }
+        const auto& node = m_nodes[entry.node];
+        if ( node.count > 0 )
+        {
+            for ( auto i = node.first; i < node.first + node.count; ++i )
+            {
+                if ( i == hint )
+                {
+                    continue;
+                }
+                float along = 0.0f;
+                const auto distance
+                    = segments.squaredDistance( i, x, z, along );
+                ++tested;
+                if ( distance < best )
+                {
+                    best = distance;
+                    bestAlong = along;
+                    result.segment = i;
+                }
+            }
+            continue;
+        }
+        // The nearer child is popped first, which tightens best sooner.
+        Entry left{ node.first,
+                    squaredDistanceToBox( m_nodes[node.first], x, z ) };
+        Entry right{ node.first + 1,
+                     squaredDistanceToBox( m_nodes[node.first + 1], x, z ) };
+        if ( left.squaredDistance > right.squaredDistance )
+        {
+            std::swap( left, right );
+        }
+        if ( right.squaredDistance < best )
+        {
+            stack[stackSize++] = right;
+        }
+        if ( left.squaredDistance < best )
+        {
+            stack[stackSize++] = left;
+        }
+    }
+
+    if ( segmentsTested )
+    {
+        *segmentsTested = tested;
+    }
+    // A non-finite point is never nearer than anything, without a hint there
+    // is no segment to measure along.
+    if ( result.segment == segments.size() )
+    {
+        result.distance = NAN;
+        return result;
+    }
+    result.distance = std::sqrt( best );
+    result.x = segments.pointX( result.segment, bestAlong );
+    result.z = segments.pointZ( result.segment, bestAlong );
+    return result;
+}
+
+} // namespace utils
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "chaperone_segments.h"
+
+namespace utils
+{
+/*!
+Bounding volume hierarchy over ChaperoneSegments for nearest segment
+queries that don't look at every segment.
+
+The boundary is a closed polyline, so neighbouring segments are also close
+in space. The tree uses that instead of sorting: every leaf holds
+k_leafSize consecutive segments and every inner node covers the range of
+its two children, each with an axis aligned box in the XZ plane. Building
+is linear and happens in ChaperoneUtils::loadChaperoneData().
+
+nearest() takes the segment that was nearest to the same tracked device on
+the previous frame as a hint. Its distance bounds the search from the start,
+so only boxes closer than that are opened. A device moves a few centimetres
+per frame, which usually leaves a handful of leaves to test. Without a hint
+(k_noHint, or a hint out of range after the chaperone changed) the search
+still prunes, just starting from an unbounded distance.
+*/
+class ChaperoneSegmentTree
+{
+public:
+    static constexpr std::size_t k_noHint
+        = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t k_leafSize = 4;
+    // Below this many segments the vectorised linear scan of
+    // ChaperoneSegments::nearest() is at least as fast as the tree.
+    static constexpr std::size_t k_minSegments = 64;
+
+    void build( const ChaperoneSegments& segments );
+    void clear() noexcept;
+
+    // segments must be the ones the tree was built from. The result's
+    // segment is the hint for the next query of the same device. If
+    // segmentsTested is set, it receives how many segment distances were
+    // computed.
+    [[nodiscard]] NearestSegment
+        nearest( const ChaperoneSegments& segments,
+                 const float x,
+                 const float z,
+                 const std::size_t hint = k_noHint,
+                 std::size_t* segmentsTested = nullptr ) const;
+
+private:
+    struct Node
+    {
+        float minX;
+        float minZ;
+        float maxX;
+        float maxZ;
+        // Leaves: the first segment and how many there are. Inner nodes:
+        // count is 0 and the children are first and first + 1.
+        uint32_t first;
+        uint32_t count;
+    };
+
+    void buildNode( const ChaperoneSegments& segments,
+                    const std::size_t index,
+                    const std::size_t begin,
+                    const std::size_t end );
+    static float squaredDistanceToBox( const Node& node,
+                                       const float x,
+                                       const float z ) noexcept;
+
+    std::vector<Node> m_nodes;
+    std::size_t m_segmentCount = 0;
+};
+
+} // namespace utils
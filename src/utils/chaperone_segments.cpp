@@ -0,0 +1,379 @@
+#include "chaperone_segments.h"
+#include <algorithm>
+#include <cmath>
+#if defined __SSE2__ || defined _M_X64                                         \
+    || ( defined _M_IX86_FP && _M_IX86_FP >= 2 )
+#    include <emmintrin.h>
+#    define CHAPERONE_SEGMENTS_SSE2
+#elif defined __ARM_NEON
+#    include <arm_neon.h>
+#    define CHAPERONE_SEGMENTS_NEON
+#endif
+
+namespace utils
+{
+namespace
+{
+    constexpr std::size_t k_laneCount = 4;
+    // Per point scratch of the batched nearest(): the best squared distance,
+    // along value and segment of each lane.
+    constexpr std::size_t k_bestSquared = 0;
+    constexpr std::size_t k_bestAlong = k_laneCount;
+    constexpr std::size_t k_bestSegment = 2 * k_laneCount;
+    constexpr std::size_t k_scratchPerPoint = 3 * k_laneCount;
+
+    // Shared by the vector loops' tails and builds without SIMD.
+    inline void segmentDistance( const float x,
+                                 const float z,
+                                 const float startX,
+                                 const float startZ,
+                                 const float deltaX,
+                                 const float deltaZ,
+                                 const float inverseLengthSquared,
+                                 float& squaredDistance,
+                                 float& along ) noexcept
+    {
+        const auto toX = x - startX;
+        const auto toZ = z - startZ;
+        const auto t = std::min(
+            std::max( ( toX * deltaX + toZ * deltaZ ) * inverseLengthSquared,
+                      0.0f ),
+            1.0f );
+        const auto offsetX = toX - t * deltaX;
+        const auto offsetZ = toZ - t * deltaZ;
+        squaredDistance = offsetX * offsetX + offsetZ * offsetZ;
+        along = t;
+    }
+
+} // namespace
+
+void ChaperoneSegments::assign( const vr::HmdVector3_t* corners,
+                                const std::size_t count )
+{
+    clear();
+    m_startX.reserve( count );
+    m_startZ.reserve( count );
+    m_deltaX.reserve( count );
+    m_deltaZ.reserve( count );
+    m_inverseLengthSquared.reserve( count );
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        const auto& start = corners[i];
+        const auto& end = corners[( i + 1 ) % count];
+        const auto deltaX = end.v[0] - start.v[0];
+        const auto deltaZ = end.v[2] - start.v[2];
+        const auto lengthSquared = deltaX * deltaX + deltaZ * deltaZ;
+        m_startX.push_back( start.v[0] );
+        m_startZ.push_back( start.v[2] );
+        m_deltaX.push_back( deltaX );
+        m_deltaZ.push_back( deltaZ );
+        m_inverseLengthSquared.push_back(
+            lengthSquared > 0.0f ? 1.0f / lengthSquared : 0.0f );
+    }
+}
+
+void ChaperoneSegments::clear() noexcept
+{
+    m_startX.clear();
+    m_startZ.clear();
+    m_deltaX.clear();
+    m_deltaZ.clear();
+    m_inverseLengthSquared.clear();
+}
+
+void ChaperoneSegments::distanceKernel( const float x,
+                                        const float z,
+                                        std::vector<float>& squaredDistances,
+                                        std::vector<float>& along ) const
+{
+    const auto count = size();
+    squaredDistances.resize( count );
+    along.resize( count );
+
+    std::size_t i = 0;
+#if defined CHAPERONE_SEGMENTS_SSE2
+    const auto pointX = _mm_set1_ps( x );
+    const auto pointZ = _mm_set1_ps( z );
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps( 1.0f );
+    for ( ; i + k_laneCount <= count; i += k_laneCount )
+    {
+        const auto deltaX = _mm_loadu_ps( &m_deltaX[i] );
+        const auto deltaZ = _mm_loadu_ps( &m_deltaZ[i] );
+        const auto toX = _mm_sub_ps( pointX, _mm_loadu_ps( &m_startX[i] ) );
+        const auto toZ = _mm_sub_ps( pointZ, _mm_loadu_ps( &m_startZ[i] ) );
+        const auto projection = _mm_mul_ps(
+            _mm_add_ps( _mm_mul_ps( toX, deltaX ), _mm_mul_ps( toZ, deltaZ ) ),
+            _mm_loadu_ps( &m_inverseLengthSquared[i] ) );
+        const auto t = _mm_min_ps( _mm_max_ps( projection, zero ), one );
+        const auto offsetX = _mm_sub_ps( toX, _mm_mul_ps( t, deltaX ) );
+        const auto offsetZ = _mm_sub_ps( toZ, _mm_mul_ps( t, deltaZ ) );
+        _mm_storeu_ps( &squaredDistances[i],
+                       _mm_add_ps( _mm_mul_ps( offsetX, offsetX ),
+                                   _mm_mul_ps( offsetZ, offsetZ ) ) );
+        _mm_storeu_ps( &along[i], t );
+    }
+#elif defined CHAPERONE_SEGMENTS_NEON
+    const auto pointX = vdupq_n_f32( x );
+    const auto pointZ = vdupq_n_f32( z );
+    const auto zero = vdupq_n_f32( 0.0f );
+    const auto one = vdupq_n_f32( 1.0f );
+    for ( ; i + k_laneCount <= count; i += k_laneCount )
+    {
+        const auto deltaX = vld1q_f32( &m_deltaX[i] );
+        const auto deltaZ = vld1q_f32( &m_deltaZ[i] );
+        const auto toX = vsubq_f32( pointX, vld1q_f32( &m_startX[i] ) );
+        const auto toZ = vsubq_f32( pointZ, vld1q_f32( &m_startZ[i] ) );
+        const auto projection = vmulq_f32(
+            vmlaq_f32( vmulq_f32( toX, deltaX ), toZ, deltaZ ),
+            vld1q_f32( &m_inverseLengthSquared[i] ) );
+        const auto t = vminq_f32( vmaxq_f32( projection, zero ), one );
+        const auto offsetX = vmlsq_f32( toX, t, deltaX );
+        const auto offsetZ = vmlsq_f32( toZ, t, deltaZ );
+        vst1q_f32(
+            &squaredDistances[i],
+            vmlaq_f32( vmulq_f32( offsetX, offsetX ), offsetZ, offsetZ ) );
+        vst1q_f32( &along[i], t );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        segmentDistance( x,
+                         z,
+                         m_startX[i],
+                         m_startZ[i],
+                         m_deltaX[i],
+                         m_deltaZ[i],
+                         m_inverseLengthSquared[i],
+                         squaredDistances[i],
+                         along[i] );
+    }
+}
+
+float ChaperoneSegments::squaredDistance( const std::size_t segment,
+                                         const float x,
+                                         const float z,
+                                         float& along ) const noexcept
+{
+    float result = 0.0f;
+    segmentDistance( x,
+                     z,
+                     m_startX[segment],
+                     m_startZ[segment],
+                     m_deltaX[segment],
+                     m_deltaZ[segment],
+                     m_inverseLengthSquared[segment],
+                     result,
+                     along );
+    return result;
+}
+
+void ChaperoneSegments::distances( const float x,
+                                   const float z,
+                                   std::vector<float>& distances,
+                                   std::vector<float>& nearestX,
+                                   std::vector<float>& nearestZ ) const
+{
+    // The squared distances go straight into distances, nearestX holds the
+    // along values until the points are known.
+    distanceKernel( x, z, distances, nearestX );
+    nearestZ.resize( size() );
+    for ( std::size_t i = 0; i < size(); ++i )
+    {
+        distances[i] = std::sqrt( distances[i] );
+        nearestZ[i] = pointZ( i, nearestX[i] );
+        nearestX[i] = pointX( i, nearestX[i] );
+    }
+}
+
+NearestSegment ChaperoneSegments::nearest( const float x,
+                                           const float z,
+                                           std::vector<float>& squaredDistances,
+                                           std::vector<float>& along ) const
+{
+    NearestSegment result;
+    result.segment = size();
+    if ( empty() )
+    {
+        result.distance = NAN;
+        return result;
+    }
+
+    distanceKernel( x, z, squaredDistances, along );
+    // The first of several equally near segments wins.
+    const auto nearest
+        = std::min_element( squaredDistances.begin(), squaredDistances.end() );
+    result.segment
+        = static_cast<std::size_t>( nearest - squaredDistances.begin() );
+    result.distance = std::sqrt( *nearest );
+    result.x = pointX( result.segment, along[result.segment] );
+    result.z = pointZ( result.segment, along[result.segment] );
+    return result;
+}
+
+void ChaperoneSegments::nearest( const vr::HmdVector3_t* points,
+                                 const std::size_t count,
+                                 NearestSegment* results,
+                                 std::vector<float>& scratch ) const
+{
+    if ( empty() )
+    {
+        for ( std::size_t p = 0; p < count; ++p )
+        {
+            results[p] = NearestSegment{};
+            results[p].segment = size();
+            results[p].distance = NAN;
+        }
+        return;
+    }
+
+    // Segment indices are kept as floats next to the distances, exact below
+    // 2^24 segments.
+    scratch.resize( count * k_scratchPerPoint );
+    for ( std::size_t p = 0; p < count; ++p )
+    {
+        auto best = &scratch[p * k_scratchPerPoint];
+        std::fill( best + k_bestSquared,
+                   best + k_bestSquared + k_laneCount,
+                   INFINITY );
+        std::fill( best + k_bestAlong, best + k_bestAlong + k_laneCount, 0.0f );
+        std::fill(
+            best + k_bestSegment, best + k_bestSegment + k_laneCount, 0.0f );
+    }
+
+    std::size_t i = 0;
+#if defined CHAPERONE_SEGMENTS_SSE2
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps( 1.0f );
+    const auto lanes = _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f );
+    for ( ; i + k_laneCount <= size(); i += k_laneCount )
+    {
+        const auto startX = _mm_loadu_ps( &m_startX[i] );
+        const auto startZ = _mm_loadu_ps( &m_startZ[i] );
+        const auto deltaX = _mm_loadu_ps( &m_deltaX[i] );
+        const auto deltaZ = _mm_loadu_ps( &m_deltaZ[i] );
+        const auto inverseLengthSquared
+            = _mm_loadu_ps( &m_inverseLengthSquared[i] );
+        const auto segment
+            = _mm_add_ps( _mm_set1_ps( static_cast<float>( i ) ), lanes );
+        for ( std::size_t p = 0; p < count; ++p )
+        {
+            const auto toX
+                = _mm_sub_ps( _mm_set1_ps( points[p].v[0] ), startX );
+            const auto toZ
+                = _mm_sub_ps( _mm_set1_ps( points[p].v[2] ), startZ );
+            const auto projection = _mm_mul_ps(
+                _mm_add_ps( _mm_mul_ps( toX, deltaX ),
+                            _mm_mul_ps( toZ, deltaZ ) ),
+                inverseLengthSquared );
+            const auto t = _mm_min_ps( _mm_max_ps( projection, zero ), one );
+            const auto offsetX = _mm_sub_ps( toX, _mm_mul_ps( t, deltaX ) );
+            const auto offsetZ = _mm_sub_ps( toZ, _mm_mul_ps( t, deltaZ ) );
+            const auto squared = _mm_add_ps( _mm_mul_ps( offsetX, offsetX ),
+                                             _mm_mul_ps( offsetZ, offsetZ ) );
+
+            auto best = &scratch[p * k_scratchPerPoint];
+            const auto bestSquared = _mm_loadu_ps( best + k_bestSquared );
+            const auto closer = _mm_cmplt_ps( squared, bestSquared );
+            const auto select = [closer]( const __m128 a, const __m128 b )
+            {
+                return _mm_or_ps( _mm_and_ps( closer, a ),
+                                  _mm_andnot_ps( closer, b ) );
+            };
+            _mm_storeu_ps( best + k_bestSquared,
+                           select( squared, bestSquared ) );
+            _mm_storeu_ps(
+                best + k_bestAlong,
+                select( t, _mm_loadu_ps( best + k_bestAlong ) ) );
+            _mm_storeu_ps(
+                best + k_bestSegment,
+                select( segment, _mm_loadu_ps( best + k_bestSegment ) ) );
+        }
+    }
+#elif defined CHAPERONE_SEGMENTS_NEON
+    const auto zero = vdupq_n_f32( 0.0f );
+    const auto one = vdupq_n_f32( 1.0f );
+    const float laneOffsets[k_laneCount] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const auto lanes = vld1q_f32( laneOffsets );
+    for ( ; i + k_laneCount <= size(); i += k_laneCount )
+    {
+        const auto startX = vld1q_f32( &m_startX[i] );
+        const auto startZ = vld1q_f32( &m_startZ[i] );
+        const auto deltaX = vld1q_f32( &m_deltaX[i] );
+        const auto deltaZ = vld1q_f32( &m_deltaZ[i] );
+        const auto inverseLengthSquared
+            = vld1q_f32( &m_inverseLengthSquared[i] );
+        const auto segment
+            = vaddq_f32( vdupq_n_f32( static_cast<float>( i ) ), lanes );
+        for ( std::size_t p = 0; p < count; ++p )
+        {
+            const auto toX = vsubq_f32( vdupq_n_f32( points[p].v[0] ), startX );
+            const auto toZ = vsubq_f32( vdupq_n_f32( points[p].v[2] ), startZ );
+            const auto projection = vmulq_f32(
+                vmlaq_f32( vmulq_f32( toX, deltaX ), toZ, deltaZ ),
+                inverseLengthSquared );
+            const auto t = vminq_f32( vmaxq_f32( projection, zero ), one );
+            const auto offsetX = vmlsq_f32( toX, t, deltaX );
+            const auto offsetZ = vmlsq_f32( toZ, t, deltaZ );
+            const auto squared
+                = vmlaq_f32( vmulq_f32( offsetX, offsetX ), offsetZ, offsetZ );
+
+            auto best = &scratch[p * k_scratchPerPoint];
+            const auto bestSquared = vld1q_f32( best + k_bestSquared );
+            const auto closer = vcltq_f32( squared, bestSquared );
+            vst1q_f32( best + k_bestSquared,
+                       vbslq_f32( closer, squared, bestSquared ) );
+            vst1q_f32(
+                best + k_bestAlong,
+                vbslq_f32( closer, t, vld1q_f32( best + k_bestAlong ) ) );
+            vst1q_f32(
+                best + k_bestSegment,
+                vbslq_f32(
+                    closer, segment, vld1q_f32( best + k_bestSegment ) ) );
+        }
+    }
+#endif
+
+    for ( std::size_t p = 0; p < count; ++p )
+    {
+        // The lanes hold the nearest segment of every fourth segment, the
+        // first of several equally near ones wins as in the single point
+        // nearest().
+        const auto best = &scratch[p * k_scratchPerPoint];
+        auto bestSquared = best[k_bestSquared];
+        auto bestAlong = best[k_bestAlong];
+        auto bestSegment = static_cast<std::size_t>( best[k_bestSegment] );
+        for ( std::size_t lane = 1; lane < k_laneCount; ++lane )
+        {
+            const auto segment
+                = static_cast<std::size_t>( best[k_bestSegment + lane] );
+            if ( best[k_bestSquared + lane] < bestSquared
+                 || ( best[k_bestSquared + lane] == bestSquared
+                      && segment < bestSegment ) )
+            {
+                bestSquared = best[k_bestSquared + lane];
+                bestAlong = best[k_bestAlong + lane];
+                bestSegment = segment;
+            }
+        }
+        for ( auto j = i; j < size(); ++j )
+        {
+            float along = 0.0f;
+            const auto squared
+                = squaredDistance( j, points[p].v[0], points[p].v[2], along );
+            if ( squared < bestSquared )
+            {
+                bestSquared = squared;
+                bestAlong = along;
+                bestSegment = j;
+            }
+        }
+        auto& result = results[p];
+        result.segment = bestSegment;
+        result.distance = std::sqrt( bestSquared );
+        result.x = pointX( bestSegment, bestAlong );
+        result.z = pointZ( bestSegment, bestAlong );
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <openvr.h>
+#include <cstddef>
+#include <vector>
+
+namespace utils
+{
+/*!
+Result of ChaperoneSegments::nearest(). segment is ChaperoneSegments::size()
+and distance NAN if there are no segments.
+*/
+struct NearestSegment
+{
+    std::size_t segment = 0;
+    float distance = 0.0f;
+    // Nearest point on the segment.
+    float x = 0.0f;
+    float z = 0.0f;
+};
+
+/*!
+The chaperone boundary as line segments in the XZ plane, stored as structure
+of arrays so distanceKernel() handles four segments per SSE2 or NEON
+instruction. Segment i runs from corner i to corner i + 1, the last one wraps
+around to corner 0.
+
+The per segment direction and inverse squared length are computed once in
+assign(). Queries don't allocate: the caller owns the buffers they write to
+and keeps them around between calls, resizing them is free once they are
+large enough. Degenerate segments (both corners in the same spot) behave like
+their start corner.
+*/
+class ChaperoneSegments
+{
+public:
+    void assign( const vr::HmdVector3_t* corners, const std::size_t count );
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_startX.size();
+    }
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_startX.empty();
+    }
+
+    // Squared distance from (x, z) to every segment, and how far along the
+    // segment the nearest point is (0 at the start corner, 1 at the end
+    // corner). Both buffers are resized to size().
+    void distanceKernel( const float x,
+                         const float z,
+                         std::vector<float>& squaredDistances,
+                         std::vector<float>& along ) const;
+
+    // Distance to every segment and the nearest point on it. All three
+    // buffers are resized to size().
+    void distances( const float x,
+                    const float z,
+                    std::vector<float>& distances,
+                    std::vector<float>& nearestX,
+                    std::vector<float>& nearestZ ) const;
+
+    // Squared distance from (x, z) to a single segment, along as in
+    // distanceKernel().
+    [[nodiscard]] float squaredDistance( const std::size_t segment,
+                                         const float x,
+                                         const float z,
+                                         float& along ) const noexcept;
+
+    // squaredDistances and along are scratch space for distanceKernel().
+    [[nodiscard]] NearestSegment
+        nearest( const float x,
+                 const float z,
+                 std::vector<float>& squaredDistances,
+                 std::vector<float>& along ) const;
+
+    // nearest() for count points in one pass over the segments, each block
+    // of segments is loaded once for every point. scratch is resized to 12
+    // floats per point.
+    void nearest( const vr::HmdVector3_t* points,
+                  const std::size_t count,
+                  NearestSegment* results,
+                  std::vector<float>& scratch ) const;
+
+    [[nodiscard]] float pointX( const std::size_t segment,
+                                const float along ) const noexcept
+    {
+        return m_startX[segment] + along * m_deltaX[segment];
+    }
+    [[nodiscard]] float pointZ( const std::size_t segment,
+                                const float along ) const noexcept
+    {
+        return m_startZ[segment] + along * m_deltaZ[segment];
+    }
+
+private:
+    std::vector<float> m_startX;
+    std::vector<float> m_startZ;
+    std::vector<float> m_deltaX;
+    std::vector<float> m_deltaZ;
+    // 0 for degenerate segments.
+    std::vector<float> m_inverseLengthSquared;
+};
+
+} // namespace utils
@@ -0,0 +1,73 @@
+#include "controller_roles.h"
+#include "../openvr/ovr_recorded_queries.h"
+#include <easylogging++.h>
+
+namespace utils
+{
+ControllerRoles controllerRoles{};
+
+ControllerRoles::ControllerRoles()
+{
+    for ( auto& index : m_indices )
+    {
+        index.store( vr::k_unTrackedDeviceIndexInvalid,
+                     std::memory_order_relaxed );
+    }
+}
+
+bool ControllerRoles::handleEvent( const vr::VREvent_t& event ) noexcept
+{
+    switch ( event.eventType )
+    {
+    case vr::VREvent_TrackedDeviceActivated:
+    case vr::VREvent_TrackedDeviceDeactivated:
+    case vr::VREvent_TrackedDeviceRoleChanged:
+        m_stale = true;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ControllerRoles::refreshIfStale()
+{
+    if ( !m_stale )
+    {
+        return false;
+    }
+    refresh();
+    return true;
+}
+
+void ControllerRoles::refresh()
+{
+    m_stale = false;
+
+    // Invalid is never asked for, its entry stays invalid.
+    for ( std::size_t role = vr::TrackedControllerRole_LeftHand;
+          role < k_roleCount;
+          ++role )
+    {
+        const auto index = ovr_recorded_queries::indexForControllerRole(
+            static_cast<vr::ETrackedControllerRole>( role ) );
+        m_indices[role].store( index, std::memory_order_relaxed );
+    }
+
+    LOG( DEBUG ) << "Controller roles: left "
+                 << indexForRole( vr::TrackedControllerRole_LeftHand )
+                 << ", right "
+                 << indexForRole( vr::TrackedControllerRole_RightHand );
+}
+
+vr::TrackedDeviceIndex_t ControllerRoles::indexForRole(
+    const vr::ETrackedControllerRole role ) const noexcept
+{
+    const auto i = static_cast<std::size_t>( role );
+    if ( i >= k_roleCount )
+    {
+        return vr::k_unTrackedDeviceIndexInvalid;
+    }
+    return m_indices[i].load( std::memory_order_relaxed );
+}
+
+} // namespace utils
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <openvr.h>
+#include <array>
+#include <atomic>
+
+namespace utils
+{
+/*!
+Cached answer of IVRSystem::GetTrackedDeviceIndexForControllerRole for every
+controller role.
+
+The runtime only changes the mapping when a device is activated, deactivated
+or changes its role. handleEvent() marks the table stale on those events and
+the next refreshIfStale() asks the runtime again, so a tick costs no IPC for
+role lookups unless the devices actually changed.
+
+handleEvent() and refreshIfStale() must be called from the Qt thread.
+indexForRole() may be called from any thread.
+*/
+class ControllerRoles
+{
+public:
+    ControllerRoles();
+
+    // Returns true if the event changes the role mapping.
+    bool handleEvent( const vr::VREvent_t& event ) noexcept;
+    void invalidate() noexcept
+    {
+        m_stale = true;
+    }
+    // Returns true if the table was refreshed.
+    bool refreshIfStale();
+    void refresh();
+
+    [[nodiscard]] vr::TrackedDeviceIndex_t
+        indexForRole( const vr::ETrackedControllerRole role ) const noexcept;
+
+private:
+    static constexpr auto k_roleCount
+        = static_cast<std::size_t>( vr::TrackedControllerRole_Max ) + 1;
+
+    std::array<std::atomic<vr::TrackedDeviceIndex_t>, k_roleCount> m_indices;
+    bool m_stale = true;
+};
+
+extern ControllerRoles controllerRoles;
+
+} // namespace utils
@@ -0,0 +1,248 @@
+#include "dashboard_benchmark.h"
+#include "frame_profiler.h"
+#include <QCoreApplication>
+#include <QJSValue>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+#include <QStringList>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <easylogging++.h>
+
+namespace utils
+{
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    uint32_t microsecondsBetween( const Clock::time_point start,
+                                  const Clock::time_point end ) noexcept
+    {
+        using std::chrono::microseconds;
+        const auto elapsed
+            = std::chrono::duration_cast<microseconds>( end - start );
+        return static_cast<uint32_t>( elapsed.count() );
+    }
+
+    struct ItemCounts
+    {
+        int items = 0;
+        int withContents = 0;
+    };
+
+    void countItems( const QQuickItem& item, ItemCounts& counts )
+    {
+        if ( !item.isVisible() )
+        {
+            return;
+        }
+        ++counts.items;
+        if ( item.flags() & QQuickItem::ItemHasContents )
+        {
+            ++counts.withContents;
+        }
+        for ( const auto child : item.childItems() )
+        {
+            countItems( *child, counts );
+        }
+    }
+
+    struct PageResult
+    {
+        std::string name;
+        ItemCounts counts;
+        uint32_t firstFrameUs = 0;
+        SectionHistogram polish;
+        SectionHistogram sync;
+        SectionHistogram render;
+    };
+
+    QQuickItem* findStackView( const QQuickItem& root )
+    {
+        for ( const auto child : root.childItems() )
+        {
+            if ( child->inherits( "QQuickStackView" ) )
+            {
+                return child;
+            }
+        }
+        return nullptr;
+    }
+
+    QStringList pageNames( const QQuickItem& root )
+    {
+        auto pages = root.property( "pageComponents" );
+        if ( pages.userType() == qMetaTypeId<QJSValue>() )
+        {
+            pages = pages.value<QJSValue>().toVariant();
+        }
+        return pages.toMap().keys();
+    }
+
+    QQuickItem* createPage( QQuickItem& root, const QString& name )
+    {
+        QVariant page;
+        QMetaObject::invokeMethod( &root,
+                                   "dashboardPage",
+                                   Q_RETURN_ARG( QVariant, page ),
+                                   Q_ARG( QVariant, name ) );
+        return qobject_cast<QQuickItem*>( page.value<QObject*>() );
+    }
+
+    void renderPage( QQuickRenderControl& renderControl,
+                     const int frames,
+                     PageResult& result )
+    {
+        for ( int frame = 0; frame < frames; ++frame )
+        {
+            // Timers and animations of the page run in between frames.
+            QCoreApplication::processEvents();
+
+            const auto start = Clock::now();
+            renderControl.polishItems();
+            const auto polished = Clock::now();
+            renderControl.sync();
+            const auto synced = Clock::now();
+            // With the software backend grab() marks everything dirty and
+            // repaints the whole window into an image.
+            renderControl.grab();
+            const auto rendered = Clock::now();
+
+            if ( frame == 0 )
+            {
+                result.firstFrameUs = microsecondsBetween( start, rendered );
+                continue;
+            }
+            result.polish.addSample( microsecondsBetween( start, polished ) );
+            result.sync.addSample( microsecondsBetween( polished, synced ) );
+            result.render.addSample( microsecondsBetween( synced, rendered ) );
+        }
+    }
+
+    void writeCsv( std::ostream& out, const std::vector<PageResult>& results )
+    {
+        out << "page,items,items_with_contents,first_frame_us,"
+               "polish_mean_us,polish_p99_us,sync_mean_us,sync_p99_us,"
+               "render_mean_us,render_p99_us\n";
+        out << std::fixed << std::setprecision( 1 );
+        for ( const auto& r : results )
+        {
+            const auto polish = r.polish.summary();
+            const auto sync = r.sync.summary();
+            const auto render = r.render.summary();
+            out << r.name << ',' << r.counts.items << ','
+                << r.counts.withContents << ',' << r.firstFrameUs << ','
+                << polish.meanUs << ',' << polish.p99Us << ',' << sync.meanUs
+                << ',' << sync.p99Us << ',' << render.meanUs << ','
+                << render.p99Us << '\n';
+        }
+    }
+
+    std::string summaryTable( const std::vector<PageResult>& results )
+    {
+        std::ostringstream text;
+        text << std::left << std::setw( 22 ) << "Page" << std::right
+             << std::setw( 7 ) << "items" << std::setw( 9 ) << "content"
+             << std::setw( 11 ) << "first us" << std::setw( 11 ) << "polish us"
+             << std::setw( 9 ) << "sync us" << std::setw( 11 ) << "render us"
+             << '\n';
+        text << std::fixed << std::setprecision( 1 );
+        for ( const auto& r : results )
+        {
+            text << std::left << std::setw( 22 ) << r.name << std::right
+                 << std::setw( 7 ) << r.counts.items << std::setw( 9 )
+                 << r.counts.withContents << std::setw( 11 ) << r.firstFrameUs
+                 << std::setw( 11 ) << r.polish.summary().meanUs
+                 << std::setw( 9 ) << r.sync.summary().meanUs
+                 << std::setw( 11 ) << r.render.summary().meanUs << '\n';
+        }
+        return text.str();
+    }
+
+} // namespace
+
+bool runDashboardBenchmark( QQuickItem& root,
+                            const int frames,
+                            const std::string& csvPath )
+{
+    if ( QQuickWindow::sceneGraphBackend() != "software" )
+    {
+        LOG( ERROR ) << "The dashboard benchmark needs the software scene "
+                        "graph backend.";
+        return false;
+    }
+
+    QQuickRenderControl renderControl;
+    QQuickWindow window( &renderControl );
+    root.setParentItem( window.contentItem() );
+    window.setGeometry( 0,
+                        0,
+                        static_cast<int>( root.width() ),
+                        static_cast<int>( root.height() ) );
+    renderControl.initialize( nullptr );
+
+    auto stackView = findStackView( root );
+    if ( !stackView )
+    {
+        LOG( ERROR ) << "No StackView in the dashboard root item.";
+        return false;
+    }
+
+    std::vector<PageResult> results;
+
+    // The page the dashboard opens on.
+    results.emplace_back();
+    results.back().name = "root";
+    renderPage( renderControl, frames, results.back() );
+    countItems( *stackView, results.back().counts );
+
+    // Every other page on its own, in place of the StackView.
+    stackView->setVisible( false );
+    for ( const auto& name : pageNames( root ) )
+    {
+        auto page = createPage( root, name );
+        if ( !page )
+        {
+            LOG( ERROR ) << "Could not create dashboard page '" << name
+                         << "'.";
+            continue;
+        }
+        page->setSize( QSizeF( root.width(), root.height() ) );
+        page->setVisible( true );
+
+        results.emplace_back();
+        results.back().name = name.toStdString();
+        renderPage( renderControl, frames, results.back() );
+        countItems( *page, results.back().counts );
+
+        page->setVisible( false );
+    }
+    stackView->setVisible( true );
+
+    renderControl.invalidate();
+    root.setParentItem( nullptr );
+
+    LOG( INFO ) << "Dashboard benchmark, " << frames << " frames per page:\n"
+                << summaryTable( results );
+    if ( csvPath.empty() )
+    {
+        return true;
+    }
+    std::ofstream csv( csvPath );
+    writeCsv( csv, results );
+    if ( !csv )
+    {
+        LOG( ERROR ) << "Could not write the dashboard benchmark to '"
+                     << csvPath << "'.";
+        return false;
+    }
+    LOG( INFO ) << "Dashboard benchmark written to '" << csvPath << "'.";
+    return true;
+}
+
+} // namespace utils
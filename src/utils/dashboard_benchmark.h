@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+class QQuickItem;
+
+namespace utils
+{
+/* Measures how expensive every dashboard page is to render, for
+ * --benchmark-dashboard.
+ *
+ * The root item of mainwidget.qml is moved into an offscreen QQuickWindow
+ * driven by its own QQuickRenderControl. The root page and then every page
+ * in the root item's pageComponents are shown on their own for the given
+ * number of frames. Each frame runs polishItems(), sync() and a full
+ * repaint, and each step is timed separately. The first frame of a page
+ * creates its scene graph nodes and is reported on its own, the summaries
+ * cover the remaining frames (at most the last
+ * SectionHistogram::k_windowSize).
+ *
+ * Needs the software scene graph backend, which has to be selected before
+ * the first QQuickWindow is created. Scene graph nodes are internal to Qt,
+ * visible items and items with ItemHasContents (the ones that add nodes)
+ * are counted instead.
+ *
+ * The results go to the log as a table and, if csvPath isn't empty, to
+ * csvPath as CSV. Returns false if the benchmark could not run or the CSV
+ * could not be written.
+ */
+bool runDashboardBenchmark( QQuickItem& root,
+                            const int frames,
+                            const std::string& csvPath );
+
+} // namespace utils
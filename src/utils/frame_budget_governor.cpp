@@ -0,0 +1,150 @@
+#include "frame_budget_governor.h"
+#include <iomanip>
+#include <sstream>
+
+namespace utils
+{
+FrameBudgetGovernor frameBudgetGovernor{};
+
+const char* deferrableSubjectName( const DeferrableSubject subject ) noexcept
+{
+    switch ( subject )
+    {
+    case DeferrableSubject::Statistics:
+        return "Statistics";
+    case DeferrableSubject::DashboardTicks:
+        return "DashboardTicks";
+    case DeferrableSubject::CenterMarkerRotationCount:
+        return "CenterMarkerRotationCount";
+    case DeferrableSubject::AlarmCheck:
+        return "AlarmCheck";
+    }
+
+    return "Unknown";
+}
+
+void FrameBudgetGovernor::setFramePeriod(
+    const Clock::duration period ) noexcept
+{
+    if ( period > Clock::duration::zero() )
+    {
+        m_budget = period;
+    }
+}
+
+void FrameBudgetGovernor::beginTick( const Clock::time_point now ) noexcept
+{
+    m_tickStart = now;
+    m_shedThisTick = false;
+    m_decidedThisTick.fill( false );
+}
+
+void FrameBudgetGovernor::endTick( const Clock::time_point now ) noexcept
+{
+    const auto duration = now - m_tickStart;
+
+    ++m_counters.ticks;
+    m_previousTickOverBudget = duration > m_budget;
+    if ( m_previousTickOverBudget )
+    {
+        ++m_counters.ticksOverBudget;
+        const auto overrunUs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                duration - m_budget )
+                .count() );
+        if ( overrunUs > m_counters.maxOverrunUs )
+        {
+            m_counters.maxOverrunUs = overrunUs;
+        }
+    }
+    if ( m_shedThisTick )
+    {
+        ++m_counters.ticksShed;
+    }
+}
+
+bool FrameBudgetGovernor::shouldDefer(
+    const DeferrableSubject subject,
+    const Clock::time_point now ) noexcept
+{
+    const auto index = static_cast<std::size_t>( subject );
+    if ( m_decidedThisTick[index] )
+    {
+        return m_deferredThisTick[index];
+    }
+    m_decidedThisTick[index] = true;
+    m_deferredThisTick[index] = false;
+
+    const auto overBudget
+        = m_previousTickOverBudget || now - m_tickStart > m_budget;
+    if ( !overBudget )
+    {
+        m_consecutiveDeferrals[index] = 0;
+        return false;
+    }
+
+    if ( m_consecutiveDeferrals[index] >= k_maxConsecutiveDeferrals )
+    {
+        m_consecutiveDeferrals[index] = 0;
+        ++m_counters.forcedRuns[index];
+        return false;
+    }
+
+    ++m_consecutiveDeferrals[index];
+    ++m_counters.deferrals[index];
+    m_shedThisTick = true;
+    m_deferredThisTick[index] = true;
+    return true;
+}
+
+void FrameBudgetGovernor::resetCounters() noexcept
+{
+    m_counters = Counters{};
+}
+
+std::string FrameBudgetGovernor::summaryText() const
+{
+    const auto budgetUs
+        = std::chrono::duration_cast<std::chrono::microseconds>( m_budget )
+              .count();
+
+    std::ostringstream text;
+    text << "Frame budget " << budgetUs << " us: " << m_counters.ticks
+         << " ticks, " << m_counters.ticksOverBudget << " over budget, "
+         << m_counters.ticksShed << " shed, max overrun "
+         << m_counters.maxOverrunUs << " us\n";
+    text << std::left << std::setw( 28 ) << "Deferred subject" << std::right
+         << std::setw( 10 ) << "deferred" << std::setw( 10 ) << "forced"
+         << '\n';
+    for ( std::size_t i = 0; i < Counters::subjectCount; ++i )
+    {
+        text << std::left << std::setw( 28 )
+             << deferrableSubjectName( static_cast<DeferrableSubject>( i ) )
+             << std::right << std::setw( 10 ) << m_counters.deferrals[i]
+             << std::setw( 10 ) << m_counters.forcedRuns[i] << '\n';
+    }
+
+    return text.str();
+}
+
+bool withinBudget( const UpdateSubject subject ) noexcept
+{
+    switch ( subject )
+    {
+    case UpdateSubject::AlarmClock:
+        return frameBudgetGovernor.shouldRun( DeferrableSubject::AlarmCheck );
+    case UpdateSubject::ChaperoneTabController:
+    case UpdateSubject::SettingsTabController:
+    case UpdateSubject::SteamVrTabController:
+    case UpdateSubject::VideoDashboard:
+        return frameBudgetGovernor.shouldRun(
+            DeferrableSubject::DashboardTicks );
+    case UpdateSubject::AudioTabController:
+    case UpdateSubject::UtilitiesTabController:
+        return true;
+    }
+
+    return true;
+}
+
+} // namespace utils
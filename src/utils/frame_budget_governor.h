@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "update_rate.h"
+
+namespace utils
+{
+// Low priority work in mainEventLoop that may be pushed to a later tick when
+// the loop runs over its frame budget. Motion, chaperone proximity warnings
+// and push-to-talk are deliberately not part of this list.
+enum class DeferrableSubject
+{
+    Statistics,
+    DashboardTicks,
+    CenterMarkerRotationCount,
+    AlarmCheck,
+    // LAST_ENUMERATOR must always be set to the last value
+    LAST_ENUMERATOR = AlarmCheck,
+};
+
+const char* deferrableSubjectName( const DeferrableSubject subject ) noexcept;
+
+/*!
+Measures every tick of the main event loop against the frame period of the
+display and sheds low priority work when the loop can't keep up.
+
+A subject is deferred if the previous tick went over budget, or if the
+current tick has already used up the budget by the time the subject is
+reached. To avoid starving a subject it runs anyway after
+k_maxConsecutiveDeferrals deferred ticks in a row.
+
+Subjects that only run when UpdateRate picks them (the dashboard ticks and
+the alarm check) are asked through withinBudget() while UpdateRate picks, so
+a deferred one stays due instead of losing its run. The others are asked
+where they run in the tick.
+
+beginTick() and endTick() bracket each tick. shouldDefer() answers the same
+for a subject until the next beginTick().
+*/
+class FrameBudgetGovernor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t k_maxConsecutiveDeferrals = 30;
+
+    struct Counters
+    {
+        static constexpr auto subjectCount
+            = static_cast<std::size_t>( DeferrableSubject::LAST_ENUMERATOR )
+              + 1;
+
+        uint64_t ticks = 0;
+        uint64_t ticksOverBudget = 0;
+        // Ticks in which at least one subject was deferred.
+        uint64_t ticksShed = 0;
+        uint64_t maxOverrunUs = 0;
+        std::array<uint64_t, subjectCount> deferrals{};
+        // Deferred subjects that had to run because they hit the limit.
+        std::array<uint64_t, subjectCount> forcedRuns{};
+    };
+
+    void setFramePeriod( const Clock::duration period ) noexcept;
+    [[nodiscard]] Clock::duration framePeriod() const noexcept
+    {
+        return m_budget;
+    }
+
+    void beginTick( const Clock::time_point now = Clock::now() ) noexcept;
+    void endTick( const Clock::time_point now = Clock::now() ) noexcept;
+
+    [[nodiscard]] bool
+        shouldDefer( const DeferrableSubject subject,
+                     const Clock::time_point now = Clock::now() ) noexcept;
+    [[nodiscard]] bool shouldRun( const DeferrableSubject subject ) noexcept
+    {
+        return !shouldDefer( subject );
+    }
+
+    [[nodiscard]] const Counters& counters() const noexcept
+    {
+        return m_counters;
+    }
+    void resetCounters() noexcept;
+    [[nodiscard]] std::string summaryText() const;
+
+private:
+    Clock::duration m_budget = std::chrono::microseconds( 11111 );
+    Clock::time_point m_tickStart{};
+    bool m_previousTickOverBudget = false;
+    bool m_shedThisTick = false;
+    std::array<bool, Counters::subjectCount> m_decidedThisTick{};
+    std::array<bool, Counters::subjectCount> m_deferredThisTick{};
+    std::array<uint32_t, Counters::subjectCount> m_consecutiveDeferrals{};
+    Counters m_counters;
+};
+
+extern FrameBudgetGovernor frameBudgetGovernor;
+
+// UpdateRate::SubjectFilter that holds back the subjects frameBudgetGovernor
+// defers this tick.
+bool withinBudget( const UpdateSubject subject ) noexcept;
+
+} // namespace utils
@@ -0,0 +1,97 @@
+#include "frame_context.h"
+#include <cmath>
+#include "../quaternion/quaternion.h"
+#include "controller_roles.h"
+#include "ChaperoneUtils.h"
+
+namespace utils
+{
+namespace
+{
+    float linearSpeed( const vr::TrackedDevicePose_t& pose ) noexcept
+    {
+        const auto& vel = pose.vVelocity.v;
+        return std::sqrt( vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2] );
+    }
+
+} // namespace
+
+void FrameContext::update( const vr::ETrackingUniverseOrigin trackingUniverse,
+                           const bool isDashboardVisible )
+{
+    universe = trackingUniverse;
+    dashboardVisible = isDashboardVisible;
+    hasPoses = true;
+
+    for ( vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount;
+          ++i )
+    {
+        poseValid[i] = poses[i].bPoseIsValid && poses[i].bDeviceIsConnected
+                       && poses[i].eTrackingResult
+                              == vr::TrackingResult_Running_OK;
+    }
+
+    leftHandIndex
+        = controllerRoles.indexForRole( vr::TrackedControllerRole_LeftHand );
+    rightHandIndex
+        = controllerRoles.indexForRole( vr::TrackedControllerRole_RightHand );
+
+    leftSpeed
+        = isPoseValid( leftHandIndex ) ? linearSpeed( poses[leftHandIndex] )
+                                       : 0.0f;
+    rightSpeed
+        = isPoseValid( rightHandIndex ) ? linearSpeed( poses[rightHandIndex] )
+                                        : 0.0f;
+
+    if ( isHmdPoseValid() )
+    {
+        hmdQuaternion = quaternion::fromHmdMatrix34(
+            hmdPose().mDeviceToAbsoluteTracking );
+        hmdYaw = quaternion::getYaw( hmdQuaternion );
+    }
+}
+
+void FrameContext::updateChaperone( const ChaperoneUtils& chaperoneUtils )
+{
+    std::array<vr::HmdVector3_t, vr::k_unMaxTrackedDeviceCount> points;
+    std::array<NearestSegment, vr::k_unMaxTrackedDeviceCount> results;
+    std::array<vr::TrackedDeviceIndex_t, vr::k_unMaxTrackedDeviceCount>
+        devices;
+    std::size_t count = 0;
+    for ( vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount;
+          ++i )
+    {
+        if ( !poseValid[i] )
+        {
+            // The segment stays as the hint for when the device is back.
+            chaperone[i].distance = NAN;
+            continue;
+        }
+        const auto& matrix = poses[i].mDeviceToAbsoluteTracking.m;
+        points[count] = { matrix[0][3], matrix[1][3], matrix[2][3] };
+        results[count] = chaperone[i];
+        devices[count] = i;
+        ++count;
+    }
+    chaperoneUtils.queryChaperone( points.data(), count, results.data() );
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        chaperone[devices[i]] = results[i];
+    }
+}
+
+vr::TrackedDeviceIndex_t FrameContext::indexForRole(
+    const vr::ETrackedControllerRole role ) const noexcept
+{
+    switch ( role )
+    {
+    case vr::TrackedControllerRole_LeftHand:
+        return leftHandIndex;
+    case vr::TrackedControllerRole_RightHand:
+        return rightHandIndex;
+    default:
+        return vr::k_unTrackedDeviceIndexInvalid;
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <openvr.h>
+#include <array>
+#include "chaperone_segments.h"
+
+namespace utils
+{
+class ChaperoneUtils;
+
+/*!
+Everything the per tick controllers derive from the device poses, computed
+once at the start of OverlayController::mainEventLoop and handed to every
+controller by const reference. Controllers should take hand indices, pose
+validity and the HMD orientation from here instead of asking the runtime or
+converting the HMD matrix themselves.
+
+The hand indices are the ones controllerRoles held when update() ran. A
+context without poses (hasPoses false) is used while initialising, every
+pose is invalid in that case.
+*/
+struct FrameContext
+{
+    vr::ETrackingUniverseOrigin universe = vr::TrackingUniverseStanding;
+    bool hasPoses = false;
+    std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount>
+        poses{};
+    // bPoseIsValid, bDeviceIsConnected and Running_OK.
+    std::array<bool, vr::k_unMaxTrackedDeviceCount> poseValid{};
+
+    vr::TrackedDeviceIndex_t leftHandIndex = vr::k_unTrackedDeviceIndexInvalid;
+    vr::TrackedDeviceIndex_t rightHandIndex
+        = vr::k_unTrackedDeviceIndexInvalid;
+
+    // Only meaningful if the HMD pose is valid.
+    vr::HmdQuaternion_t hmdQuaternion{ 1.0, 0.0, 0.0, 0.0 };
+    double hmdYaw = 0.0;
+
+    // Linear speed in m/s, 0 if the hand has no valid pose.
+    float leftSpeed = 0.0f;
+    float rightSpeed = 0.0f;
+
+    bool dashboardVisible = false;
+
+    // Nearest chaperone segment of every device, distance NAN if its pose is
+    // invalid or there is no chaperone. Filled in by updateChaperone().
+    std::array<NearestSegment, vr::k_unMaxTrackedDeviceCount> chaperone{};
+
+    // Derives everything else from poses, which the caller has filled in
+    // already. The hand indices come from controllerRoles.
+    void update( const vr::ETrackingUniverseOrigin trackingUniverse,
+                 const bool isDashboardVisible );
+
+    // One ChaperoneUtils::queryChaperone() for every device with a valid
+    // pose, trackers included. The previous results are the hints. Runs after
+    // the space has been moved for the tick, not in update().
+    void updateChaperone( const ChaperoneUtils& chaperoneUtils );
+
+    [[nodiscard]] vr::TrackedDeviceIndex_t
+        indexForRole( const vr::ETrackedControllerRole role ) const noexcept;
+
+    [[nodiscard]] bool
+        isPoseValid( const vr::TrackedDeviceIndex_t index ) const noexcept
+    {
+        return index < vr::k_unMaxTrackedDeviceCount && poseValid[index];
+    }
+
+    [[nodiscard]] const vr::TrackedDevicePose_t& hmdPose() const noexcept
+    {
+        return poses[vr::k_unTrackedDeviceIndex_Hmd];
+    }
+    [[nodiscard]] bool isHmdPoseValid() const noexcept
+    {
+        return poseValid[vr::k_unTrackedDeviceIndex_Hmd];
+    }
+};
+
+} // namespace utils
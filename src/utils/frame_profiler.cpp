@@ -0,0 +1,216 @@
+#include "frame_profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace utils
+{
+const char* profiledSectionName( const ProfiledSection section ) noexcept
+{
+    switch ( section )
+    {
+    case ProfiledSection::WholeTick:
+        return "WholeTick";
+    case ProfiledSection::BackgroundResults:
+        return "BackgroundResults";
+    case ProfiledSection::UpdateActionStates:
+        return "UpdateActionStates";
+    case ProfiledSection::InputBindings:
+        return "InputBindings";
+    case ProfiledSection::EventPolling:
+        return "EventPolling";
+    case ProfiledSection::DevicePoses:
+        return "DevicePoses";
+    case ProfiledSection::MoveCenterTick:
+        return "MoveCenterTick";
+    case ProfiledSection::UtilitiesTick:
+        return "UtilitiesTick";
+    case ProfiledSection::StatisticsTick:
+        return "StatisticsTick";
+    case ProfiledSection::ChaperoneTick:
+        return "ChaperoneTick";
+    case ProfiledSection::AudioTick:
+        return "AudioTick";
+    case ProfiledSection::RotationTick:
+        return "RotationTick";
+    case ProfiledSection::AlarmTick:
+        return "AlarmTick";
+    case ProfiledSection::SettingsDashboardTick:
+        return "SettingsDashboardTick";
+    case ProfiledSection::SteamVrDashboardTick:
+        return "SteamVrDashboardTick";
+    case ProfiledSection::FixFloorDashboardTick:
+        return "FixFloorDashboardTick";
+    case ProfiledSection::VideoDashboardTick:
+        return "VideoDashboardTick";
+    case ProfiledSection::ChaperoneDashboardTick:
+        return "ChaperoneDashboardTick";
+    case ProfiledSection::PropertyChanges:
+        return "PropertyChanges";
+    }
+
+    return "Unknown";
+}
+
+std::size_t
+    SectionHistogram::bucketForSample( const uint32_t microseconds ) noexcept
+{
+    std::size_t bucket = 0;
+    auto value = microseconds >> 1;
+    while ( value != 0 && bucket < k_bucketCount - 1 )
+    {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void SectionHistogram::addSample( const uint32_t microseconds ) noexcept
+{
+    if ( m_count == k_windowSize )
+    {
+        // Window is full, the oldest sample drops out of the histogram.
+        --m_buckets[bucketForSample( m_samples[m_next] )];
+    }
+    else
+    {
+        ++m_count;
+    }
+
+    m_samples[m_next] = microseconds;
+    ++m_buckets[bucketForSample( microseconds )];
+    m_next = ( m_next + 1 ) % k_windowSize;
+}
+
+void SectionHistogram::clear() noexcept
+{
+    m_buckets.fill( 0 );
+    m_next = 0;
+    m_count = 0;
+}
+
+SectionHistogram::Summary SectionHistogram::summary() const
+{
+    Summary s;
+    s.samples = m_count;
+    if ( m_count == 0 )
+    {
+        return s;
+    }
+
+    const auto end
+        = m_samples.begin() + static_cast<std::ptrdiff_t>( m_count );
+    std::vector<uint32_t> sorted( m_samples.begin(), end );
+    std::sort( sorted.begin(), sorted.end() );
+
+    double total = 0.0;
+    for ( const auto sample : sorted )
+    {
+        total += sample;
+    }
+    s.meanUs = total / static_cast<double>( m_count );
+    s.p50Us = sorted[m_count / 2];
+    s.p99Us = sorted[std::min( m_count - 1, ( m_count * 99 ) / 100 )];
+    s.maxUs = sorted.back();
+
+    return s;
+}
+
+void FrameProfiler::setEnabled( const bool value ) noexcept
+{
+    if ( value && !m_enabled )
+    {
+        // Don't mix data from different profiling sessions.
+        clear();
+    }
+    m_enabled = value;
+}
+
+void FrameProfiler::record(
+    const ProfiledSection section,
+    const std::chrono::steady_clock::duration duration ) noexcept
+{
+    const auto microseconds
+        = std::chrono::duration_cast<std::chrono::microseconds>( duration )
+              .count();
+    m_sections[static_cast<std::size_t>( section )].addSample(
+        static_cast<uint32_t>( std::max<decltype( microseconds )>(
+            0, microseconds ) ) );
+}
+
+void FrameProfiler::clear() noexcept
+{
+    for ( auto& section : m_sections )
+    {
+        section.clear();
+    }
+}
+
+std::string FrameProfiler::summaryText() const
+{
+    std::ostringstream text;
+    text << std::left << std::setw( 24 ) << "Section" << std::right
+         << std::setw( 10 ) << "mean us" << std::setw( 10 ) << "p50 us"
+         << std::setw( 10 ) << "p99 us" << std::setw( 10 ) << "max us"
+         << '\n';
+
+    for ( std::size_t i = 0; i < sectionCount; ++i )
+    {
+        const auto s = m_sections[i].summary();
+        if ( s.samples == 0 )
+        {
+            continue;
+        }
+        text << std::left << std::setw( 24 )
+             << profiledSectionName( static_cast<ProfiledSection>( i ) )
+             << std::right << std::fixed << std::setprecision( 1 )
+             << std::setw( 10 ) << s.meanUs << std::setw( 10 ) << s.p50Us
+             << std::setw( 10 ) << s.p99Us << std::setw( 10 ) << s.maxUs
+             << '\n';
+    }
+
+    return text.str();
+}
+
+bool FrameProfiler::writeCsv( const std::string& filePath ) const
+{
+    std::ofstream file( filePath );
+    if ( !file )
+    {
+        return false;
+    }
+
+    file << "section,samples,mean_us,p50_us,p99_us,max_us";
+    for ( std::size_t b = 0; b < SectionHistogram::k_bucketCount; ++b )
+    {
+        if ( b == SectionHistogram::k_bucketCount - 1 )
+        {
+            file << ",ge_" << ( 1u << b ) << "us";
+        }
+        else
+        {
+            file << ",lt_" << ( 2u << b ) << "us";
+        }
+    }
+    file << '\n';
+
+    for ( std::size_t i = 0; i < sectionCount; ++i )
+    {
+        const auto& section = m_sections[i];
+        const auto s = section.summary();
+        file << profiledSectionName( static_cast<ProfiledSection>( i ) ) << ','
+             << s.samples << ',' << s.meanUs << ',' << s.p50Us << ','
+             << s.p99Us << ',' << s.maxUs;
+        for ( const auto count : section.buckets() )
+        {
+            file << ',' << count;
+        }
+        file << '\n';
+    }
+
+    return static_cast<bool>( file );
+}
+
+} // namespace utils
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace utils
+{
+enum class ProfiledSection
+{
+    WholeTick,
+    BackgroundResults,
+    UpdateActionStates,
+    InputBindings,
+    EventPolling,
+    DevicePoses,
+    MoveCenterTick,
+    UtilitiesTick,
+    StatisticsTick,
+    ChaperoneTick,
+    AudioTick,
+    RotationTick,
+    AlarmTick,
+    SettingsDashboardTick,
+    SteamVrDashboardTick,
+    FixFloorDashboardTick,
+    VideoDashboardTick,
+    ChaperoneDashboardTick,
+    PropertyChanges,
+    // LAST_ENUMERATOR must always be set to the last value
+    LAST_ENUMERATOR = PropertyChanges,
+};
+
+const char* profiledSectionName( const ProfiledSection section ) noexcept;
+
+/*!
+Rolling record of how long a section of the main event loop took on the last
+k_windowSize ticks it ran. Samples are kept in microseconds, both as a ring
+buffer (for exact percentiles) and as a log2 histogram.
+*/
+class SectionHistogram
+{
+public:
+    static constexpr std::size_t k_windowSize = 1024;
+    // Bucket 0 holds [0, 2) us, bucket n holds [2^n, 2^(n+1)) us, the last
+    // bucket holds everything above.
+    static constexpr std::size_t k_bucketCount = 21;
+
+    struct Summary
+    {
+        std::size_t samples = 0;
+        double meanUs = 0.0;
+        uint32_t p50Us = 0;
+        uint32_t p99Us = 0;
+        uint32_t maxUs = 0;
+    };
+
+    void addSample( const uint32_t microseconds ) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] Summary summary() const;
+    [[nodiscard]] const std::array<uint32_t, k_bucketCount>&
+        buckets() const noexcept
+    {
+        return m_buckets;
+    }
+
+    static std::size_t bucketForSample( const uint32_t microseconds ) noexcept;
+
+private:
+    std::array<uint32_t, k_windowSize> m_samples{};
+    std::array<uint32_t, k_bucketCount> m_buckets{};
+    std::size_t m_next = 0;
+    std::size_t m_count = 0;
+};
+
+/*!
+Per-section frame cost profiler for OverlayController::mainEventLoop.
+
+The profiler is always compiled in. While it is disabled the only cost of an
+instrumented section is a single branch in ProfilerSequence::mark().
+*/
+class FrameProfiler
+{
+public:
+    static constexpr auto sectionCount
+        = static_cast<std::size_t>( ProfiledSection::LAST_ENUMERATOR ) + 1;
+
+    [[nodiscard]] bool enabled() const noexcept
+    {
+        return m_enabled;
+    }
+    void setEnabled( const bool value ) noexcept;
+
+    void record( const ProfiledSection section,
+                 const std::chrono::steady_clock::duration duration ) noexcept;
+    void clear() noexcept;
+
+    // Human readable table for the settings page debug section.
+    [[nodiscard]] std::string summaryText() const;
+    // Writes all sections and their histograms to a CSV file. Returns false on
+    // failure.
+    bool writeCsv( const std::string& filePath ) const;
+
+private:
+    bool m_enabled = false;
+    std::array<SectionHistogram, sectionCount> m_sections{};
+};
+
+/*!
+Measures consecutive sections of a tick with one clock read per section.
+
+    utils::ProfilerSequence profile( m_frameProfiler );
+    doA();
+    profile.mark( ProfiledSection::A );
+    doB();
+    profile.mark( ProfiledSection::B );
+
+Each mark() records the time since the previous mark (or construction). The
+whole lifetime is recorded as ProfiledSection::WholeTick on destruction.
+*/
+class ProfilerSequence
+{
+public:
+    explicit ProfilerSequence( FrameProfiler& profiler ) noexcept
+        : m_profiler( profiler ), m_enabled( profiler.enabled() )
+    {
+        if ( m_enabled )
+        {
+            m_start = std::chrono::steady_clock::now();
+            m_last = m_start;
+        }
+    }
+
+    ~ProfilerSequence()
+    {
+        if ( m_enabled )
+        {
+            m_profiler.record( ProfiledSection::WholeTick,
+                               std::chrono::steady_clock::now() - m_start );
+        }
+    }
+
+    ProfilerSequence( const ProfilerSequence& ) = delete;
+    ProfilerSequence& operator=( const ProfilerSequence& ) = delete;
+
+    void mark( const ProfiledSection section ) noexcept
+    {
+        if ( m_enabled )
+        {
+            const auto now = std::chrono::steady_clock::now();
+            m_profiler.record( section, now - m_last );
+            m_last = now;
+        }
+    }
+
+private:
+    FrameProfiler& m_profiler;
+    const bool m_enabled;
+    std::chrono::steady_clock::time_point m_start{};
+    std::chrono::steady_clock::time_point m_last{};
+};
+
+} // namespace utils
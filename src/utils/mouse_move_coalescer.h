@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace utils
+{
+/*!
+Collects the mouse moves of one overlay event drain, so Qt gets one move
+instead of one per VREvent_MouseMove.
+
+OverlayController::mainEventLoop calls move() for every VREvent_MouseMove
+and take() before every button or scroll event and once the queue is
+drained; take() hands out the latest position if it differs from where the
+pointer was last sent, so presses, releases and wheel events still see the
+pointer where the runtime had it.
+
+Point is anything copyable with operator==, QPoint in the overlay. Must only
+be used from the Qt thread.
+*/
+template <typename Point> class MouseMoveCoalescer
+{
+public:
+    void move( const Point& position ) noexcept
+    {
+        m_pending = position;
+        ++m_received;
+    }
+
+    [[nodiscard]] std::optional<Point> take( const Point& lastSent ) noexcept
+    {
+        if ( !m_pending )
+        {
+            return std::nullopt;
+        }
+        const auto position = *m_pending;
+        m_pending.reset();
+        if ( position == lastSent )
+        {
+            return std::nullopt;
+        }
+        ++m_sent;
+        return position;
+    }
+
+    // How many moves were received and how many of them were sent.
+    [[nodiscard]] uint64_t receivedCount() const noexcept
+    {
+        return m_received;
+    }
+    [[nodiscard]] uint64_t sentCount() const noexcept
+    {
+        return m_sent;
+    }
+    void resetCounters() noexcept
+    {
+        m_received = 0;
+        m_sent = 0;
+    }
+
+private:
+    std::optional<Point> m_pending;
+    uint64_t m_received = 0;
+    uint64_t m_sent = 0;
+};
+
+} // namespace utils
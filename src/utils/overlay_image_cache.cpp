@@ -0,0 +1,92 @@
+#include "overlay_image_cache.h"
+#include "paths.h"
+#include <easylogging++.h>
+
+namespace utils
+{
+OverlayImageCache overlayImageCache{};
+
+std::optional<vr::EVROverlayError> OverlayImageCache::setOverlayImage(
+    const vr::VROverlayHandle_t overlayHandle,
+    const std::string& fileName )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto entry = findOrLoad( fileName );
+    if ( !entry )
+    {
+        return std::nullopt;
+    }
+
+    if ( !entry->useFile )
+    {
+        const auto error = vr::VROverlay()->SetOverlayRaw(
+            overlayHandle,
+            entry->image.bits(),
+            static_cast<uint32_t>( entry->image.width() ),
+            static_cast<uint32_t>( entry->image.height() ),
+            4 );
+        if ( error == vr::VROverlayError_None )
+        {
+            return error;
+        }
+
+        LOG( WARNING ) << "SetOverlayRaw failed for '" << fileName << "' ("
+                       << entry->image.width() << "x"
+                       << entry->image.height() << "): "
+                       << vr::VROverlay()->GetOverlayErrorNameFromEnum( error )
+                       << ", loading it from file from now on.";
+        entry->useFile = true;
+        entry->image = QImage();
+    }
+
+    ++m_counters.fromFile;
+    return vr::VROverlay()->SetOverlayFromFile( overlayHandle,
+                                                entry->filePath.c_str() );
+}
+
+OverlayImageCache::Entry*
+    OverlayImageCache::findOrLoad( const std::string& fileName )
+{
+    const auto cached = m_entries.find( fileName );
+    if ( cached != m_entries.end() )
+    {
+        ++m_counters.hits;
+        return &cached->second;
+    }
+
+    const auto filePath = paths::binaryDirectoryFindFile( fileName );
+    if ( !filePath.has_value() )
+    {
+        // Not remembered, the file may still show up.
+        return nullptr;
+    }
+    ++m_counters.misses;
+
+    Entry entry;
+    entry.filePath = *filePath;
+    entry.image = QImage( QString::fromStdString( *filePath ) )
+                      .convertToFormat( QImage::Format_RGBA8888 );
+    if ( entry.image.isNull() )
+    {
+        LOG( WARNING ) << "Could not decode '" << *filePath
+                       << "', loading it from file.";
+        entry.useFile = true;
+    }
+
+    return &m_entries.emplace( fileName, std::move( entry ) ).first->second;
+}
+
+void OverlayImageCache::clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_entries.clear();
+}
+
+OverlayImageCache::Counters OverlayImageCache::counters() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_counters;
+}
+
+} // namespace utils
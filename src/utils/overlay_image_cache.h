@@ -0,0 +1,62 @@
+#pragma once
+
+#include <openvr.h>
+#include <QImage>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace utils
+{
+/*!
+Notification and marker images, decoded once and kept in memory.
+
+The first setOverlayImage() for a file looks it up in the binary directory
+and decodes it to RGBA8888. Every call then pushes the pixels with
+SetOverlayRaw, so switching between images that were shown before costs no
+file system access and no decoding. Images Qt can't decode, or that
+SteamVR refuses through SetOverlayRaw, are remembered and shown with
+SetOverlayFromFile instead.
+*/
+class OverlayImageCache
+{
+public:
+    struct Counters
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        // Calls that went to SetOverlayFromFile.
+        uint64_t fromFile = 0;
+    };
+
+    // fileName is relative to the binary directory, like the names
+    // ovr_overlay_wrapper::setOverlayFromFile() takes. Empty if the file
+    // doesn't exist.
+    std::optional<vr::EVROverlayError>
+        setOverlayImage( const vr::VROverlayHandle_t overlayHandle,
+                         const std::string& fileName );
+
+    void clear();
+    [[nodiscard]] Counters counters() const;
+
+private:
+    struct Entry
+    {
+        std::string filePath;
+        QImage image;
+        bool useFile = false;
+    };
+
+    // nullptr if the file doesn't exist. m_mutex must be held.
+    Entry* findOrLoad( const std::string& fileName );
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    Counters m_counters;
+};
+
+extern OverlayImageCache overlayImageCache;
+
+} // namespace utils
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QPoint>
+#include <QQuickRenderControl>
+#include <QWindow>
+
+namespace utils
+{
+/*!
+QQuickRenderControl that names the window it renders as its render window.
+
+Without a render window Qt sets the projection to the render target, so an
+FBO larger or smaller than the window shows the scene cropped or leaves part
+of the texture empty. With one, Qt projects the window's rect onto the whole
+render target, which is how the dashboard render scale is applied. Mouse
+events stay in window coordinates.
+*/
+class OverlayRenderControl : public QQuickRenderControl
+{
+public:
+    void setRenderWindow( QWindow* window ) noexcept
+    {
+        m_renderWindow = window;
+    }
+
+    QWindow* renderWindow( QPoint* offset ) override
+    {
+        if ( offset && m_renderWindow )
+        {
+            *offset = QPoint( 0, 0 );
+        }
+        return m_renderWindow;
+    }
+
+private:
+    QWindow* m_renderWindow = nullptr;
+};
+
+} // namespace utils
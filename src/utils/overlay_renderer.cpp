@@ -0,0 +1,172 @@
+#include "overlay_renderer.h"
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFramebufferObject>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+#include <easylogging++.h>
+
+namespace utils
+{
+namespace
+{
+    // Waiting for a fence this long means the GPU is hung, rendering goes on
+    // rather than blocking the Qt thread forever.
+    constexpr GLuint64 k_fenceTimeoutNs = 100'000'000;
+
+    bool supportsFenceSync( const QOpenGLContext& context )
+    {
+        const auto version = context.format().version();
+        if ( context.isOpenGLES() )
+        {
+            return version >= qMakePair( 3, 0 );
+        }
+        return version >= qMakePair( 3, 2 )
+               || context.hasExtension( "GL_ARB_sync" );
+    }
+
+} // namespace
+
+OverlayRenderer::OverlayRenderer( QQuickRenderControl& renderControl,
+                                  QQuickWindow& window,
+                                  QOpenGLContext& context,
+                                  QOffscreenSurface& surface )
+    : m_renderControl( renderControl ), m_window( window ),
+      m_context( context ), m_surface( surface )
+{
+}
+
+OverlayRenderer::~OverlayRenderer()
+{
+    stop();
+}
+
+void OverlayRenderer::start( const vr::VROverlayHandle_t overlayHandle,
+                             const QSize& size,
+                             const bool withDepthStencil )
+{
+    if ( isRunning() )
+    {
+        return;
+    }
+    m_overlayHandle = overlayHandle;
+    m_started = true;
+
+    m_context.makeCurrent( &m_surface );
+    m_renderControl.initialize( &m_context );
+
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(
+        withDepthStencil ? QOpenGLFramebufferObject::CombinedDepthStencil
+                         : QOpenGLFramebufferObject::NoAttachment );
+    fboFormat.setTextureTarget( GL_TEXTURE_2D );
+    for ( auto& fbo : m_fbos )
+    {
+        fbo.reset( new QOpenGLFramebufferObject( size, fboFormat ) );
+    }
+    m_backBuffer = 0;
+    m_window.setRenderTarget( m_fbos[m_backBuffer].get() );
+
+    m_hasFenceSync = supportsFenceSync( m_context );
+    LOG( INFO ) << "Overlay renderer initialized, "
+                << ( m_hasFenceSync ? "using fence sync."
+                                    : "no fence sync, flushing every frame." );
+}
+
+void OverlayRenderer::stop()
+{
+    if ( !isRunning() )
+    {
+        return;
+    }
+    m_started = false;
+
+    m_context.makeCurrent( &m_surface );
+    m_renderControl.invalidate();
+    m_window.setRenderTarget( nullptr );
+    for ( std::size_t buffer = 0; buffer < k_bufferCount; ++buffer )
+    {
+        waitForBuffer( buffer );
+        m_fbos[buffer].reset();
+    }
+    m_context.doneCurrent();
+    LOG( INFO ) << "Overlay renderer stopped.";
+}
+
+bool OverlayRenderer::renderFrame()
+{
+    if ( !isRunning() )
+    {
+        return false;
+    }
+
+    const auto buffer = m_backBuffer;
+    m_context.makeCurrent( &m_surface );
+    m_renderControl.polishItems();
+    m_window.setRenderTarget( m_fbos[buffer].get() );
+    m_renderControl.sync();
+
+    waitForBuffer( buffer );
+    m_renderControl.render();
+
+    auto gl = m_context.extraFunctions();
+    if ( m_hasFenceSync )
+    {
+        m_fences[buffer] = gl->glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        // Flushes the frame to the GPU without waiting for it, otherwise the
+        // texture may be empty when SteamVR reads it.
+        gl->glClientWaitSync( m_fences[buffer], GL_SYNC_FLUSH_COMMANDS_BIT, 0 );
+    }
+    else
+    {
+        gl->glFlush();
+    }
+    submitTexture( buffer );
+    m_backBuffer = ( buffer + 1 ) % k_bufferCount;
+    return true;
+}
+
+void OverlayRenderer::waitForBuffer( const std::size_t buffer )
+{
+    auto& fence = m_fences[buffer];
+    if ( !fence )
+    {
+        return;
+    }
+    // Usually signalled long ago, the other FBO was rendered in between.
+    auto gl = m_context.extraFunctions();
+    if ( gl->glClientWaitSync( fence, 0, k_fenceTimeoutNs )
+         == GL_TIMEOUT_EXPIRED )
+    {
+        LOG( WARNING ) << "Overlay FBO " << buffer
+                       << " still in use by the GPU after "
+                       << k_fenceTimeoutNs / 1'000'000 << " ms.";
+    }
+    gl->glDeleteSync( fence );
+    fence = nullptr;
+}
+
+void OverlayRenderer::submitTexture( const std::size_t buffer )
+{
+    GLuint unTexture = m_fbos[buffer]->texture();
+    if ( unTexture == 0 )
+    {
+        return;
+    }
+#if defined _WIN64 || defined _LP64
+    // To avoid any compiler warning because of cast to a larger
+    // pointer type (warning C4312 on VC)
+    vr::Texture_t texture
+        = { reinterpret_cast<void*>( static_cast<uint64_t>( unTexture ) ),
+            vr::TextureType_OpenGL,
+            vr::ColorSpace_Auto };
+#else
+    vr::Texture_t texture = { reinterpret_cast<void*>( unTexture ),
+                              vr::TextureType_OpenGL,
+                              vr::ColorSpace_Auto };
+#endif
+    vr::VROverlay()->SetOverlayTexture( m_overlayHandle, &texture );
+}
+
+} // namespace utils
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <openvr.h>
+#include <QSize>
+#include <qopengl.h>
+#include <array>
+#include <memory>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QOpenGLFramebufferObject;
+class QQuickRenderControl;
+class QQuickWindow;
+
+namespace utils
+{
+/* Renders the dashboard's QQuickWindow into an FBO and submits it to the
+ * overlay.
+ *
+ * Frames alternate between two FBOs so the texture SteamVR was last given
+ * is never drawn into. Every frame gets a fence which is flushed, not
+ * waited on, before the texture is submitted. The fence is only waited on
+ * when the same FBO is rendered into again two frames later, which makes
+ * sure the GPU is done with it. Without fence sync support (the context is
+ * requested as OpenGL 2.1, which only has it as GL_ARB_sync) every frame
+ * falls back to glFlush().
+ *
+ * Everything runs on the Qt thread.
+ */
+class OverlayRenderer
+{
+public:
+    OverlayRenderer( QQuickRenderControl& renderControl,
+                     QQuickWindow& window,
+                     QOpenGLContext& context,
+                     QOffscreenSurface& surface );
+    ~OverlayRenderer();
+
+    OverlayRenderer( const OverlayRenderer& ) = delete;
+    OverlayRenderer& operator=( const OverlayRenderer& ) = delete;
+
+    // size is the texture size, which may differ from the window size.
+    void start( const vr::VROverlayHandle_t overlayHandle,
+                const QSize& size,
+                const bool withDepthStencil );
+    // Waits for the GPU to finish with both FBOs and releases the context.
+    void stop();
+    [[nodiscard]] bool isRunning() const noexcept
+    {
+        return m_started;
+    }
+
+    // Returns false if the renderer isn't running.
+    bool renderFrame();
+
+private:
+    void waitForBuffer( const std::size_t buffer );
+    void submitTexture( const std::size_t buffer );
+
+    QQuickRenderControl& m_renderControl;
+    QQuickWindow& m_window;
+    QOpenGLContext& m_context;
+    QOffscreenSurface& m_surface;
+
+    vr::VROverlayHandle_t m_overlayHandle = vr::k_ulOverlayHandleInvalid;
+    static constexpr std::size_t k_bufferCount = 2;
+    std::array<std::unique_ptr<QOpenGLFramebufferObject>, k_bufferCount>
+        m_fbos;
+    // Signalled once the GPU finished the last frame rendered into the FBO.
+    std::array<GLsync, k_bufferCount> m_fences{};
+    std::size_t m_backBuffer = 0;
+    bool m_hasFenceSync = false;
+    bool m_started = false;
+};
+
+} // namespace utils
@@ -0,0 +1,82 @@
+#include "render_throttle.h"
+#include <sstream>
+
+namespace utils
+{
+namespace
+{
+    constexpr auto k_rateWindow = std::chrono::seconds( 1 );
+
+} // namespace
+
+bool RenderThrottle::isInteracting( const Clock::time_point now ) const
+    noexcept
+{
+    return m_lastInteraction != Clock::time_point{}
+           && now - m_lastInteraction < k_interactionHold;
+}
+
+std::chrono::milliseconds
+    RenderThrottle::nextRenderDelay( const float displayFrequency,
+                                     const Clock::time_point now ) const
+    noexcept
+{
+    Clock::duration interval = k_passiveInterval;
+    if ( isInteracting( now ) && displayFrequency > 0.0f )
+    {
+        interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float>( 1.0f / displayFrequency ) );
+    }
+
+    const auto earliest = m_lastRender + interval;
+    if ( m_lastRender == Clock::time_point{} || earliest <= now )
+    {
+        return std::chrono::milliseconds( 0 );
+    }
+    // Rounded up, rendering a little late beats rendering twice.
+    return std::chrono::ceil<std::chrono::milliseconds>( earliest - now );
+}
+
+void RenderThrottle::frameRendered( const Clock::time_point now ) noexcept
+{
+    ++m_counters.framesRendered;
+    if ( isInteracting( now ) )
+    {
+        ++m_counters.interactiveFrames;
+    }
+    m_lastRender = now;
+
+    if ( now - m_windowStart >= k_rateWindow )
+    {
+        // A window without any frames in between counts as zero.
+        m_counters.lastSecondFrames
+            = now - m_windowStart < 2 * k_rateWindow ? m_windowFrames : 0;
+        m_windowStart = now;
+        m_windowFrames = 0;
+    }
+    ++m_windowFrames;
+}
+
+void RenderThrottle::resetCounters() noexcept
+{
+    m_counters = Counters{};
+    m_windowStart = Clock::time_point{};
+    m_windowFrames = 0;
+}
+
+std::string RenderThrottle::summaryText( const Clock::time_point now ) const
+{
+    // Nothing was rendered for a while, the last window is stale.
+    const auto rate = now - m_lastRender < 2 * k_rateWindow
+                          ? m_counters.lastSecondFrames
+                          : 0u;
+
+    std::ostringstream text;
+    text << "Dashboard renders: " << rate << " Hz, "
+         << m_counters.framesRendered << " frames ("
+         << m_counters.interactiveFrames << " interactive), "
+         << m_counters.skippedHidden << " skipped while hidden\n";
+    return text.str();
+}
+
+} // namespace utils
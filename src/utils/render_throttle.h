@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace utils
+{
+/*!
+Decides how soon the dashboard may be rendered again after Qt asks for a new
+frame.
+
+While the laser pointer is interacting with the dashboard (any mouse event in
+the last k_interactionHold) frames are rendered at the display frequency.
+Otherwise the scene only changes because of passive updates like the
+statistics page timers, which are rendered at most every k_passiveInterval.
+Render requests while neither overlay is visible are dropped, the
+VREvent_OverlayShown handler requests a fresh frame.
+
+Also counts rendered and skipped frames for the profiler summary.
+*/
+class RenderThrottle
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto k_interactionHold = std::chrono::milliseconds( 500 );
+    static constexpr auto k_passiveInterval = std::chrono::milliseconds( 50 );
+
+    struct Counters
+    {
+        uint64_t framesRendered = 0;
+        uint64_t interactiveFrames = 0;
+        // Requests dropped because neither overlay was visible.
+        uint64_t skippedHidden = 0;
+        // Frames rendered in the last complete one second window.
+        uint32_t lastSecondFrames = 0;
+    };
+
+    void noteInteraction( const Clock::time_point now = Clock::now() ) noexcept
+    {
+        m_lastInteraction = now;
+    }
+    [[nodiscard]] bool
+        isInteracting( const Clock::time_point now = Clock::now() ) const
+        noexcept;
+
+    // Delay before the requested frame may be rendered.
+    [[nodiscard]] std::chrono::milliseconds
+        nextRenderDelay( const float displayFrequency,
+                         const Clock::time_point now = Clock::now() ) const
+        noexcept;
+
+    void frameRendered( const Clock::time_point now = Clock::now() ) noexcept;
+    void frameSkippedHidden() noexcept
+    {
+        ++m_counters.skippedHidden;
+    }
+
+    [[nodiscard]] const Counters& counters() const noexcept
+    {
+        return m_counters;
+    }
+    void resetCounters() noexcept;
+    [[nodiscard]] std::string
+        summaryText( const Clock::time_point now = Clock::now() ) const;
+
+private:
+    Clock::time_point m_lastInteraction{};
+    Clock::time_point m_lastRender{};
+    Clock::time_point m_windowStart{};
+    uint32_t m_windowFrames = 0;
+    Counters m_counters;
+};
+
+} // namespace utils
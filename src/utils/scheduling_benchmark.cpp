@@ -0,0 +1,476 @@
+#include "scheduling_benchmark.h"
+#include "scheduling_policy.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <easylogging++.h>
+
+namespace utils
+{
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // The game and the overlay both run at the HMD's refresh rate.
+    constexpr auto k_framePeriod = std::chrono::microseconds( 11'111 );
+    constexpr double k_gameFrameWorkMs = 4.0;
+    // Per tick, roughly what a dashboard-open tick costs on a desktop CPU.
+    constexpr double k_qtTickWorkMs = 1.0;
+    constexpr double k_qtLockedWorkMs = 0.2;
+    constexpr double k_renderWorkMs = 2.0;
+    constexpr double k_workerJobWorkMs = 3.0;
+    constexpr double k_workerLockedWorkMs = 0.5;
+    constexpr uint64_t k_calibrationIterations = 2'000'000;
+
+    // Arithmetic the compiler can't drop, stands in for real work.
+    void spin( const uint64_t iterations ) noexcept
+    {
+        volatile double value = 1.0;
+        for ( uint64_t i = 0; i < iterations; ++i )
+        {
+            value = value * 1.000'000'1 + 1e-9;
+        }
+    }
+
+    double iterationsPerMillisecond()
+    {
+        // The first round warms up the CPU clock.
+        spin( k_calibrationIterations );
+        const auto start = Clock::now();
+        spin( k_calibrationIterations );
+        const Milliseconds elapsed = Clock::now() - start;
+        return static_cast<double>( k_calibrationIterations )
+               / elapsed.count();
+    }
+
+    // Hands a count of posts from one thread to the threads waiting for it,
+    // like the queued signals between the overlay's threads.
+    class Mailbox
+    {
+    public:
+        void post( const bool everyone = false )
+        {
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                ++m_posted;
+                m_postedAt = Clock::now();
+            }
+            if ( everyone )
+            {
+                m_changed.notify_all();
+            }
+            else
+            {
+                m_changed.notify_one();
+            }
+        }
+
+        // Returns false once running is cleared and stop() was called.
+        bool wait( uint64_t& seen,
+                   Clock::time_point& postedAt,
+                   const std::atomic<bool>& running )
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_changed.wait( lock,
+                            [&]
+                            {
+                                return m_posted != seen
+                                       || !running.load(
+                                           std::memory_order_relaxed );
+                            } );
+            if ( !running.load( std::memory_order_relaxed ) )
+            {
+                return false;
+            }
+            seen = m_posted;
+            postedAt = m_postedAt;
+            return true;
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+            }
+            m_changed.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        uint64_t m_posted = 0;
+        Clock::time_point m_postedAt;
+    };
+
+    struct Work
+    {
+        uint64_t gameFrame = 0;
+        uint64_t qtTick = 0;
+        uint64_t qtLocked = 0;
+        uint64_t render = 0;
+        uint64_t workerJob = 0;
+        uint64_t workerLocked = 0;
+    };
+
+    Work calibratedWork()
+    {
+        const auto perMs = iterationsPerMillisecond();
+        const auto iterations = [perMs]( const double ms )
+        { return static_cast<uint64_t>( perMs * ms ); };
+        Work work;
+        work.gameFrame = iterations( k_gameFrameWorkMs );
+        work.qtTick = iterations( k_qtTickWorkMs - k_qtLockedWorkMs );
+        work.qtLocked = iterations( k_qtLockedWorkMs );
+        work.render = iterations( k_renderWorkMs );
+        work.workerJob = iterations( k_workerJobWorkMs - k_workerLockedWorkMs );
+        work.workerLocked = iterations( k_workerLockedWorkMs );
+        return work;
+    }
+
+    /* The overlay's threads with the priorities they really run at:
+     *
+     * - the tick thread wakes the Qt thread every frame, raised by
+     *   ThreadRole::Tick in low priority mode,
+     * - the Qt thread runs the tick, posts one job to the background worker
+     *   and renders the dashboard, always at normal priority,
+     * - the background worker runs the job, lowered by ThreadRole::Background
+     *   in low priority mode.
+     *
+     * The worker and the Qt thread share a lock, like the audio device
+     * lock, so a starved worker shows up as a late tick. The time from the
+     * tick thread waking to the Qt thread finishing the tick is recorded.
+     */
+    class OverlayModel
+    {
+    public:
+        OverlayModel( const bool lowPriority,
+                      const std::vector<unsigned>& cpus,
+                      const Work& work )
+            : m_lowPriority( lowPriority ), m_cpus( cpus ), m_work( work )
+        {
+            m_threads.emplace_back( [this] { runTick(); } );
+            m_threads.emplace_back( [this] { runQt(); } );
+            m_threads.emplace_back( [this] { runWorker(); } );
+        }
+
+        ~OverlayModel()
+        {
+            stop();
+        }
+
+        // Stops every thread and returns the tick latencies in ms.
+        std::vector<double> stop()
+        {
+            m_running = false;
+            m_ticks.stop();
+            m_jobs.stop();
+            for ( auto& thread : m_threads )
+            {
+                if ( thread.joinable() )
+                {
+                    thread.join();
+                }
+            }
+            return std::move( m_tickLatencies );
+        }
+
+    private:
+        void startThread( const std::optional<ThreadRole> role )
+        {
+            // Low priority mode pins the whole process, the threads inherit
+            // the mask from main().
+            pinCurrentThread( m_lowPriority ? m_cpus
+                                            : std::vector<unsigned>{} );
+            if ( m_lowPriority && role )
+            {
+                setCurrentThreadRole( *role );
+            }
+        }
+
+        void runTick()
+        {
+            startThread( ThreadRole::Tick );
+            auto deadline = Clock::now();
+            while ( m_running.load( std::memory_order_relaxed ) )
+            {
+                deadline += k_framePeriod;
+                std::this_thread::sleep_until( deadline );
+                m_ticks.post();
+            }
+        }
+
+        void runQt()
+        {
+            startThread( std::nullopt );
+            uint64_t seen = 0;
+            Clock::time_point tickedAt;
+            while ( m_ticks.wait( seen, tickedAt, m_running ) )
+            {
+                spin( m_work.qtTick );
+                {
+                    std::lock_guard<std::mutex> lock( m_shared );
+                    spin( m_work.qtLocked );
+                }
+                const Milliseconds latency = Clock::now() - tickedAt;
+                m_tickLatencies.push_back( latency.count() );
+                m_jobs.post();
+                spin( m_work.render );
+            }
+        }
+
+        void runWorker()
+        {
+            startThread( ThreadRole::Background );
+            uint64_t seen = 0;
+            Clock::time_point postedAt;
+            while ( m_jobs.wait( seen, postedAt, m_running ) )
+            {
+                spin( m_work.workerJob );
+                std::lock_guard<std::mutex> lock( m_shared );
+                spin( m_work.workerLocked );
+            }
+        }
+
+        const bool m_lowPriority;
+        const std::vector<unsigned> m_cpus;
+        const Work m_work;
+        std::atomic<bool> m_running{ true };
+        std::mutex m_shared;
+        Mailbox m_ticks;
+        Mailbox m_jobs;
+        // Only touched by the Qt thread until it is joined.
+        std::vector<double> m_tickLatencies;
+        std::vector<std::thread> m_threads;
+    };
+
+    /* A CPU bound game, one thread per hardware thread. Every frame each of
+     * them does the same amount of work and the frame is done when the
+     * slowest one is. The game is never pinned or deprioritised, it stands
+     * in for a separate process.
+     */
+    class GameModel
+    {
+    public:
+        GameModel( const unsigned threads, const uint64_t frameWork )
+            : m_frameWork( frameWork )
+        {
+            for ( unsigned i = 1; i < threads; ++i )
+            {
+                m_helpers.emplace_back( [this] { runHelper(); } );
+            }
+        }
+
+        ~GameModel()
+        {
+            m_running = false;
+            m_frameStart.stop();
+            m_frameDone.stop();
+            for ( auto& thread : m_helpers )
+            {
+                thread.join();
+            }
+        }
+
+        // Runs one frame on the calling thread and the helpers, returns how
+        // long it took in ms.
+        double frame()
+        {
+            const auto start = Clock::now();
+            m_pending = static_cast<unsigned>( m_helpers.size() ) + 1;
+            m_frameStart.post( true );
+            spin( m_frameWork );
+            // Only the last helper to finish posts, and only if this thread
+            // wasn't last.
+            if ( m_pending.fetch_sub( 1 ) != 1 )
+            {
+                Clock::time_point doneAt;
+                m_frameDone.wait( m_doneSeen, doneAt, m_running );
+            }
+            const Milliseconds frameTime = Clock::now() - start;
+            return frameTime.count();
+        }
+
+    private:
+        void runHelper()
+        {
+            pinCurrentThread( {} );
+            uint64_t seen = 0;
+            Clock::time_point postedAt;
+            while ( m_frameStart.wait( seen, postedAt, m_running ) )
+            {
+                spin( m_frameWork );
+                if ( m_pending.fetch_sub( 1 ) == 1 )
+                {
+                    m_frameDone.post();
+                }
+            }
+        }
+
+        const uint64_t m_frameWork;
+        std::atomic<bool> m_running{ true };
+        std::atomic<unsigned> m_pending{ 0 };
+        Mailbox m_frameStart;
+        Mailbox m_frameDone;
+        uint64_t m_doneSeen = 0;
+        std::vector<std::thread> m_helpers;
+    };
+
+    struct FrameStats
+    {
+        double meanMs = 0.0;
+        double stddevMs = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    FrameStats frameStats( std::vector<double> times )
+    {
+        FrameStats stats;
+        if ( times.empty() )
+        {
+            return stats;
+        }
+        const auto count = static_cast<double>( times.size() );
+        stats.meanMs
+            = std::accumulate( times.begin(), times.end(), 0.0 ) / count;
+        double squares = 0.0;
+        for ( const auto time : times )
+        {
+            squares += ( time - stats.meanMs ) * ( time - stats.meanMs );
+        }
+        stats.stddevMs = std::sqrt( squares / count );
+        std::sort( times.begin(), times.end() );
+        const auto p99Index = static_cast<std::size_t>( count * 0.99 );
+        stats.p99Ms = times[std::min( p99Index, times.size() - 1 )];
+        stats.maxMs = times.back();
+        return stats;
+    }
+
+    struct PhaseResult
+    {
+        std::string mode;
+        std::size_t frames = 0;
+        FrameStats game;
+        FrameStats overlayTick;
+    };
+
+    PhaseResult runPhase( const bool lowPriority,
+                          const std::vector<unsigned>& cpus,
+                          const std::size_t frames,
+                          const Work& work )
+    {
+        const auto gameThreads
+            = std::max( std::thread::hardware_concurrency(), 1u );
+        GameModel game( gameThreads, work.gameFrame );
+        OverlayModel overlay( lowPriority, cpus, work );
+
+        std::vector<double> frameTimes;
+        frameTimes.reserve( frames );
+        auto deadline = Clock::now();
+        for ( std::size_t frame = 0; frame < frames; ++frame )
+        {
+            frameTimes.push_back( game.frame() );
+            deadline += k_framePeriod;
+            std::this_thread::sleep_until( deadline );
+        }
+
+        PhaseResult result;
+        result.mode = lowPriority ? "low_priority" : "normal";
+        result.frames = frameTimes.size();
+        result.overlayTick = frameStats( overlay.stop() );
+        result.game = frameStats( std::move( frameTimes ) );
+        return result;
+    }
+
+    void writeCsv( std::ostream& out, const std::vector<PhaseResult>& results )
+    {
+        out << "mode,frames,mean_ms,stddev_ms,p99_ms,max_ms,"
+               "overlay_tick_p99_ms,overlay_tick_max_ms\n";
+        out << std::fixed << std::setprecision( 3 );
+        for ( const auto& r : results )
+        {
+            out << r.mode << ',' << r.frames << ',' << r.game.meanMs << ','
+                << r.game.stddevMs << ',' << r.game.p99Ms << ','
+                << r.game.maxMs << ',' << r.overlayTick.p99Ms << ','
+                << r.overlayTick.maxMs << '\n';
+        }
+    }
+
+    std::string summaryTable( const std::vector<PhaseResult>& results )
+    {
+        std::ostringstream text;
+        text << std::left << std::setw( 14 ) << "Overlay" << std::right
+             << std::setw( 10 ) << "mean ms" << std::setw( 11 ) << "stddev ms"
+             << std::setw( 9 ) << "p99 ms" << std::setw( 9 ) << "max ms"
+             << std::setw( 14 ) << "tick p99 ms" << std::setw( 14 )
+             << "tick max ms" << '\n';
+        text << std::fixed << std::setprecision( 3 );
+        for ( const auto& r : results )
+        {
+            text << std::left << std::setw( 14 ) << r.mode << std::right
+                 << std::setw( 10 ) << r.game.meanMs << std::setw( 11 )
+                 << r.game.stddevMs << std::setw( 9 ) << r.game.p99Ms
+                 << std::setw( 9 ) << r.game.maxMs << std::setw( 14 )
+                 << r.overlayTick.p99Ms << std::setw( 14 )
+                 << r.overlayTick.maxMs << '\n';
+        }
+        return text.str();
+    }
+
+} // namespace
+
+bool runSchedulingBenchmark( const int seconds,
+                             const std::vector<unsigned>& cpus,
+                             const std::string& csvPath )
+{
+    // The game is a separate process in reality, it may use every CPU.
+    if ( !pinCurrentThread( {} ) )
+    {
+        LOG( WARNING ) << "Could not unpin the benchmark's game thread.";
+    }
+    const auto work = calibratedWork();
+    const auto frames = static_cast<std::size_t>(
+        std::chrono::seconds( seconds ) / k_framePeriod );
+    if ( frames == 0 || work.gameFrame == 0 )
+    {
+        LOG( ERROR ) << "Scheduling benchmark has nothing to measure.";
+        return false;
+    }
+
+    std::vector<PhaseResult> results;
+    results.push_back( runPhase( false, cpus, frames, work ) );
+    results.push_back( runPhase( true, cpus, frames, work ) );
+
+    LOG( INFO ) << "Scheduling benchmark, " << frames << " game frames on "
+                << std::max( std::thread::hardware_concurrency(), 1u )
+                << " game threads against the overlay's threads:\n"
+                << summaryTable( results );
+    if ( csvPath.empty() )
+    {
+        return true;
+    }
+    std::ofstream csv( csvPath );
+    writeCsv( csv, results );
+    if ( !csv )
+    {
+        LOG( ERROR ) << "Could not write the scheduling benchmark to '"
+                     << csvPath << "'.";
+        return false;
+    }
+    LOG( INFO ) << "Scheduling benchmark written to '" << csvPath << "'.";
+    return true;
+}
+
+} // namespace utils
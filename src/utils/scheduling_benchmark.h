@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace utils
+{
+/* Shows what low priority mode does for a game, for --benchmark-scheduling.
+ *
+ * The game is one thread per hardware thread: every 11.1 ms (90 Hz) each
+ * of them does a fixed amount of CPU work, calibrated to about 4 ms on an
+ * idle machine, and the frame time is how long the slowest one took. Next
+ * to it run models of the overlay's threads at the priorities the real ones
+ * use: a tick thread and a Qt thread that also renders at normal priority and
+ * a background worker that shares a lock with the Qt thread. Both run for
+ * the given number of seconds twice, first as without low priority mode,
+ * then with the tick and worker threads given their ThreadRole and the
+ * overlay pinned to cpus if that isn't empty. The game itself is never
+ * pinned or deprioritised, it stands in for a separate process.
+ *
+ * Mean, standard deviation, p99 and maximum of the game's frame times and
+ * p99 and maximum of the overlay's tick latency go to the log as a table
+ * and, if csvPath isn't empty, to csvPath as CSV.
+ */
+bool runSchedulingBenchmark( const int seconds,
+                             const std::vector<unsigned>& cpus,
+                             const std::string& csvPath );
+
+} // namespace utils
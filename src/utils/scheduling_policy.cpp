@@ -0,0 +1,247 @@
+#include "scheduling_policy.h"
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <easylogging++.h>
+#ifdef _WIN32
+#    include <windows.h>
+#elif defined __linux__
+#    include <sched.h>
+#    include <sys/resource.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace utils
+{
+namespace
+{
+    std::atomic<bool> g_lowPriorityMode{ false };
+
+    // Largest CPU index accepted in a CPU list.
+    constexpr unsigned k_maxCpu = 1023;
+
+    std::optional<unsigned> parseCpu( const std::string& text )
+    {
+        if ( text.empty()
+             || text.find_first_not_of( "0123456789" ) != std::string::npos
+             || text.size() > 4 )
+        {
+            return std::nullopt;
+        }
+        const auto cpu = static_cast<unsigned>( std::stoul( text ) );
+        if ( cpu > k_maxCpu )
+        {
+            return std::nullopt;
+        }
+        return cpu;
+    }
+
+    std::string cpuListText( const std::vector<unsigned>& cpus )
+    {
+        std::ostringstream text;
+        for ( std::size_t i = 0; i < cpus.size(); ++i )
+        {
+            text << ( i == 0 ? "" : "," ) << cpus[i];
+        }
+        return text.str();
+    }
+
+#ifdef __linux__
+    // glibc only has gettid() since 2.30.
+    pid_t currentThreadId() noexcept
+    {
+        return static_cast<pid_t>( syscall( SYS_gettid ) );
+    }
+
+    // Nice values are per thread on Linux.
+    bool setCurrentThreadNice( const int nice ) noexcept
+    {
+        return setpriority(
+                   PRIO_PROCESS, static_cast<id_t>( currentThreadId() ), nice )
+               == 0;
+    }
+
+    bool fillCpuSet( const std::vector<unsigned>& cpus, cpu_set_t& set )
+    {
+        CPU_ZERO( &set );
+        if ( cpus.empty() )
+        {
+            for ( unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+            {
+                CPU_SET( cpu, &set );
+            }
+            return true;
+        }
+        for ( const auto cpu : cpus )
+        {
+            if ( cpu >= CPU_SETSIZE )
+            {
+                return false;
+            }
+            CPU_SET( cpu, &set );
+        }
+        return true;
+    }
+#elif defined _WIN32
+    std::optional<DWORD_PTR> affinityMask( const std::vector<unsigned>& cpus )
+    {
+        if ( cpus.empty() )
+        {
+            DWORD_PTR processMask = 0;
+            DWORD_PTR systemMask = 0;
+            if ( !GetProcessAffinityMask(
+                     GetCurrentProcess(), &processMask, &systemMask ) )
+            {
+                return std::nullopt;
+            }
+            return systemMask;
+        }
+        DWORD_PTR mask = 0;
+        for ( const auto cpu : cpus )
+        {
+            // Processor groups are not supported, only the first 64 CPUs.
+            if ( cpu >= sizeof( DWORD_PTR ) * 8 )
+            {
+                return std::nullopt;
+            }
+            mask |= static_cast<DWORD_PTR>( 1 ) << cpu;
+        }
+        return mask;
+    }
+#endif
+
+} // namespace
+
+bool enableLowPriorityMode( const std::vector<unsigned>& cpus )
+{
+    g_lowPriorityMode = true;
+    if ( cpus.empty() )
+    {
+        LOG( INFO ) << "Low priority mode enabled.";
+        return true;
+    }
+
+#ifdef _WIN32
+    const auto mask = affinityMask( cpus );
+    const auto pinned
+        = mask && SetProcessAffinityMask( GetCurrentProcess(), *mask );
+#else
+    // On Linux the mask of the calling thread is inherited by every thread
+    // created afterwards, which is the whole process this early on.
+    const auto pinned = pinCurrentThread( cpus );
+#endif
+    if ( !pinned )
+    {
+        LOG( ERROR ) << "Low priority mode enabled, could not pin the "
+                        "process to CPUs "
+                     << cpuListText( cpus ) << ".";
+        return false;
+    }
+    LOG( INFO ) << "Low priority mode enabled, pinned to CPUs "
+                << cpuListText( cpus ) << ".";
+    return true;
+}
+
+bool isLowPriorityModeEnabled() noexcept
+{
+    return g_lowPriorityMode;
+}
+
+void applyThreadRole( const ThreadRole role )
+{
+    if ( !isLowPriorityModeEnabled() )
+    {
+        return;
+    }
+    if ( !setCurrentThreadRole( role ) )
+    {
+        LOG( WARNING ) << "Could not change the scheduling priority of a "
+                       << ( role == ThreadRole::Tick ? "tick" : "background" )
+                       << " thread.";
+    }
+}
+
+bool setCurrentThreadRole( const ThreadRole role )
+{
+#ifdef _WIN32
+    switch ( role )
+    {
+    case ThreadRole::Tick:
+        return SetThreadPriority( GetCurrentThread(),
+                                  THREAD_PRIORITY_ABOVE_NORMAL );
+    case ThreadRole::Background:
+        // Not THREAD_MODE_BACKGROUND_BEGIN, that also lowers the I/O and
+        // memory priority far enough to stall whoever waits for the thread.
+        return SetThreadPriority( GetCurrentThread(),
+                                  THREAD_PRIORITY_LOWEST );
+    }
+    return false;
+#elif defined __linux__
+    switch ( role )
+    {
+    case ThreadRole::Tick:
+        return setCurrentThreadNice( -5 );
+    case ThreadRole::Background:
+        // Not SCHED_IDLE, a background thread holding a lock the Qt thread
+        // needs could then wait for the game indefinitely. Nice 19 still
+        // gets a small share of a busy CPU.
+        return setCurrentThreadNice( 19 );
+    }
+    return false;
+#else
+    ( void ) role;
+    return false;
+#endif
+}
+
+bool pinCurrentThread( const std::vector<unsigned>& cpus )
+{
+#ifdef _WIN32
+    const auto mask = affinityMask( cpus );
+    return mask && SetThreadAffinityMask( GetCurrentThread(), *mask ) != 0;
+#elif defined __linux__
+    cpu_set_t set;
+    if ( !fillCpuSet( cpus, set ) )
+    {
+        return false;
+    }
+    return sched_setaffinity( 0, sizeof( set ), &set ) == 0;
+#else
+    ( void ) cpus;
+    return false;
+#endif
+}
+
+std::optional<std::vector<unsigned>> parseCpuList( const std::string& list )
+{
+    std::vector<unsigned> cpus;
+    std::istringstream stream( list );
+    std::string entry;
+    while ( std::getline( stream, entry, ',' ) )
+    {
+        entry.erase( 0, entry.find_first_not_of( ' ' ) );
+        entry.erase( entry.find_last_not_of( ' ' ) + 1 );
+        const auto dash = entry.find( '-' );
+        const auto first = parseCpu( entry.substr( 0, dash ) );
+        const auto last = dash == std::string::npos
+                              ? first
+                              : parseCpu( entry.substr( dash + 1 ) );
+        if ( !first || !last || *last < *first )
+        {
+            return std::nullopt;
+        }
+        for ( auto cpu = *first; cpu <= *last; ++cpu )
+        {
+            cpus.push_back( cpu );
+        }
+    }
+    // getline() drops a trailing empty entry, "1," is still malformed.
+    if ( !list.empty() && list.back() == ',' )
+    {
+        return std::nullopt;
+    }
+    return cpus;
+}
+
+} // namespace utils
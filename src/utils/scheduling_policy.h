@@ -0,0 +1,54 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+enum class ThreadRole
+{
+    // VsyncTickThread, wakes the main event loop on vsync.
+    Tick,
+    // BackgroundWorker, the alarm and anything else that can wait for the
+    // game. Not the chaperone haptics, they are a safety warning.
+    Background,
+    // LAST_ENUMERATOR must always be set to the last value
+    LAST_ENUMERATOR = Background,
+};
+
+/*!
+Low priority mode keeps the overlay out of the game's way.
+
+enableLowPriorityMode() is called once from main() before any other thread
+exists and pins the process to the given CPUs, every thread created later
+inherits the mask. Threads call applyThreadRole() when they start:
+
+- Background threads run at nice 19 on Linux and THREAD_PRIORITY_LOWEST on
+  Windows, so the game wins any contested CPU. They still make progress
+  under load, background threads take locks the Qt thread waits for and an
+  idle-only policy would hand that wait to the game.
+- The tick thread is raised slightly (nice -5, THREAD_PRIORITY_ABOVE_NORMAL)
+  so the main event loop still wakes up on time. Without CAP_SYS_NICE or a
+  matching RLIMIT_NICE Linux refuses that, the thread stays at nice 0.
+
+The Qt thread, which also renders the dashboard, keeps its normal priority.
+Without low priority mode applyThreadRole() does nothing.
+*/
+bool enableLowPriorityMode( const std::vector<unsigned>& cpus );
+[[nodiscard]] bool isLowPriorityModeEnabled() noexcept;
+void applyThreadRole( const ThreadRole role );
+
+// Applies the role to the calling thread whether or not low priority mode is
+// enabled. Returns false if the system refused.
+bool setCurrentThreadRole( const ThreadRole role );
+// Restricts the calling thread to cpus, or allows every CPU if cpus is
+// empty.
+bool pinCurrentThread( const std::vector<unsigned>& cpus );
+
+// Parses a list like "2,3" or "4-7,10". An empty list is valid and means
+// every CPU. Returns nullopt if the list is malformed.
+[[nodiscard]] std::optional<std::vector<unsigned>>
+    parseCpuList( const std::string& list );
+
+} // namespace utils
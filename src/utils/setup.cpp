@@ -1,4 +1,5 @@
 #include "setup.h"
+#include <algorithm>
 #ifdef ENABLE_DEBUG_LOGGING
 constexpr auto debugLoggingEnabled = true;
 #else
@@ -71,6 +72,36 @@ CommandLineOptions returnCommandLineParser( const MyQApplication& application )
                                       k_resetSettingsDescription );
     parser.addOption( resetSettings );
 
+    QCommandLineOption recordTicks(
+        k_recordTicks, k_recordTicksDescription, "file" );
+    parser.addOption( recordTicks );
+
+    QCommandLineOption replayTicks(
+        k_replayTicks, k_replayTicksDescription, "file" );
+    parser.addOption( replayTicks );
+
+    QCommandLineOption pageLoading( k_pageLoading,
+                                    k_pageLoadingDescription,
+                                    "mode",
+                                    k_pageLoadingModes[0] );
+    parser.addOption( pageLoading );
+
+    QCommandLineOption traceStartup(
+        k_traceStartup, k_traceStartupDescription, "file" );
+    parser.addOption( traceStartup );
+
+    QCommandLineOption benchmarkDashboard(
+        k_benchmarkDashboard, k_benchmarkDashboardDescription, "frames" );
+    parser.addOption( benchmarkDashboard );
+
+    QCommandLineOption benchmarkScheduling(
+        k_benchmarkScheduling, k_benchmarkSchedulingDescription, "seconds" );
+    parser.addOption( benchmarkScheduling );
+
+    QCommandLineOption benchmarkCsv(
+        k_benchmarkCsv, k_benchmarkCsvDescription, "file" );
+    parser.addOption( benchmarkCsv );
+
     parser.process( application );
 
     const bool desktopModeEnabled = parser.isSet( desktopMode );
@@ -94,10 +125,70 @@ CommandLineOptions returnCommandLineParser( const MyQApplication& application )
     const bool resetSettingsEnabled = parser.isSet( resetSettings );
     LOG_IF( resetSettingsEnabled, INFO ) << "Reset SteamVR Settings.";
 
+    const auto recordTicksPath = parser.value( recordTicks ).toStdString();
+    const auto replayTicksPath = parser.value( replayTicks ).toStdString();
+    if ( !recordTicksPath.empty() && !replayTicksPath.empty() )
+    {
+        LOG( ERROR ) << "--" << k_recordTicks << " and --" << k_replayTicks
+                     << " can't be combined, not recording.";
+    }
+
+    auto pageLoadingMode = parser.value( pageLoading ).toStdString();
+    if ( std::find( std::begin( k_pageLoadingModes ),
+                    std::end( k_pageLoadingModes ),
+                    pageLoadingMode )
+         == std::end( k_pageLoadingModes ) )
+    {
+        LOG( ERROR ) << "Unknown --" << k_pageLoading << " mode '"
+                     << pageLoadingMode << "', using '" << k_pageLoadingModes[0]
+                     << "'.";
+        pageLoadingMode = k_pageLoadingModes[0];
+    }
+
+    int benchmarkDashboardFrames = 0;
+    if ( parser.isSet( benchmarkDashboard ) )
+    {
+        bool isNumber = false;
+        benchmarkDashboardFrames
+            = parser.value( benchmarkDashboard ).toInt( &isNumber );
+        if ( !isNumber || benchmarkDashboardFrames < 1 )
+        {
+            LOG( ERROR ) << "--" << k_benchmarkDashboard
+                         << " needs a positive number of frames, not "
+                         << "benchmarking.";
+            benchmarkDashboardFrames = 0;
+        }
+    }
+
+    int benchmarkSchedulingSeconds = 0;
+    if ( parser.isSet( benchmarkScheduling ) )
+    {
+        bool isNumber = false;
+        benchmarkSchedulingSeconds
+            = parser.value( benchmarkScheduling ).toInt( &isNumber );
+        if ( !isNumber || benchmarkSchedulingSeconds < 1 )
+        {
+            LOG( ERROR ) << "--" << k_benchmarkScheduling
+                         << " needs a positive number of seconds, not "
+                         << "benchmarking.";
+            benchmarkSchedulingSeconds = 0;
+        }
+    }
+
     const CommandLineOptions commandLineArgs{
-        desktopModeEnabled,         forceNoSoundEnabled,
-        forceNoManifestEnabled,     forceInstallManifestEnabled,
-        forceRemoveManifestEnabled, resetSettingsEnabled
+        desktopModeEnabled,
+        forceNoSoundEnabled,
+        forceNoManifestEnabled,
+        forceInstallManifestEnabled,
+        forceRemoveManifestEnabled,
+        resetSettingsEnabled,
+        replayTicksPath.empty() ? recordTicksPath : std::string{},
+        replayTicksPath,
+        pageLoadingMode,
+        parser.value( traceStartup ).toStdString(),
+        benchmarkDashboardFrames,
+        benchmarkSchedulingSeconds,
+        parser.value( benchmarkCsv ).toStdString()
     };
 
     LOG( INFO ) << "Command line arguments processed.";
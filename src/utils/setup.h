@@ -8,6 +8,7 @@
 #include <QStandardPaths>
 #include <openvr.h>
 #include <iostream>
+#include <string>
 #include <easylogging++.h>
 #include "../openvr/openvr_init.h"
 
@@ -27,6 +28,19 @@ struct CommandLineOptions
     const bool forceInstallManifest = false;
     const bool forceRemoveManifest = false;
     const bool resetSettings = false;
+    // Empty when not set.
+    const std::string recordTicksPath;
+    const std::string replayTicksPath;
+    // One of k_pageLoadingModes.
+    const std::string pageLoading;
+    // Empty when not set.
+    const std::string traceStartupPath;
+    // 0 when not set.
+    const int benchmarkDashboardFrames = 0;
+    // 0 when not set.
+    const int benchmarkSchedulingSeconds = 0;
+    // Empty when not set.
+    const std::string benchmarkCsvPath;
 };
 
 // Manages the programs control flow and main settings.
@@ -92,6 +106,46 @@ constexpr auto k_resetSettings = "reset-steamvr-settings";
 constexpr auto k_resetSettingsDescription
     = "Resets all SteamVR values that can be modified in OVRAS to defaults.";
 
+constexpr auto k_recordTicks = "record-ticks";
+constexpr auto k_recordTicksDescription
+    = "Records the input of every main loop tick (poses, events and actions) "
+      "to <file>.";
+
+constexpr auto k_replayTicks = "replay-ticks";
+constexpr auto k_replayTicksDescription
+    = "Replays a tick recording made with --record-ticks as fast as possible "
+      "with the frame profiler enabled, writes the profile to the settings "
+      "directory and exits.";
+
+constexpr auto k_pageLoading = "page-loading";
+constexpr auto k_pageLoadingDescription
+    = "How the dashboard pages are created: 'lazy' (default) when they are "
+      "first opened, 'preload' in the background after startup or 'eager' "
+      "all at startup.";
+constexpr const char* k_pageLoadingModes[] = { "lazy", "preload", "eager" };
+
+constexpr auto k_traceStartup = "trace-startup";
+constexpr auto k_traceStartupDescription
+    = "Writes the time spent in each startup stage to <file> as a Chrome "
+      "trace_event JSON (open it in chrome://tracing or ui.perfetto.dev).";
+
+constexpr auto k_benchmarkDashboard = "benchmark-dashboard";
+constexpr auto k_benchmarkDashboardDescription
+    = "Renders every dashboard page offscreen with the software scene graph "
+      "for <frames> frames, logs the polish, sync and render times per page "
+      "and exits. Implies --desktop-mode.";
+
+constexpr auto k_benchmarkScheduling = "benchmark-scheduling";
+constexpr auto k_benchmarkSchedulingDescription
+    = "Runs a synthetic game next to synthetic overlay load for <seconds>, "
+      "once at normal priority and once as in low priority mode, logs the "
+      "game's frame times and exits.";
+
+constexpr auto k_benchmarkCsv = "benchmark-csv";
+constexpr auto k_benchmarkCsvDescription
+    = "Also writes the results of --benchmark-dashboard or "
+      "--benchmark-scheduling to <file> as CSV.";
+
 CommandLineOptions returnCommandLineParser( const MyQApplication& application );
 
 } // namespace argument
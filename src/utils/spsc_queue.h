@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace utils
+{
+/*!
+Bounded lock-free queue for exactly one producer thread and one consumer
+thread.
+
+tryPush() may only be called from the producer and tryPop() only from the
+consumer. Neither of them blocks or allocates, a full queue makes tryPush()
+fail and an empty one makes tryPop() fail. Capacity must be a power of two.
+*/
+template <typename T, std::size_t Capacity> class SpscQueue
+{
+    static_assert( Capacity >= 2 && ( Capacity & ( Capacity - 1 ) ) == 0,
+                   "SpscQueue capacity must be a power of two." );
+
+public:
+    bool tryPush( T&& value )
+    {
+        const auto tail = m_tail.load( std::memory_order_relaxed );
+        if ( tail - m_cachedHead == Capacity )
+        {
+            m_cachedHead = m_head.load( std::memory_order_acquire );
+            if ( tail - m_cachedHead == Capacity )
+            {
+                return false;
+            }
+        }
+
+        m_slots[tail & k_mask] = std::move( value );
+        m_tail.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    bool tryPop( T& value )
+    {
+        const auto head = m_head.load( std::memory_order_relaxed );
+        if ( head == m_cachedTail )
+        {
+            m_cachedTail = m_tail.load( std::memory_order_acquire );
+            if ( head == m_cachedTail )
+            {
+                return false;
+            }
+        }
+
+        value = std::move( m_slots[head & k_mask] );
+        // Don't keep whatever the moved-from value still owns alive until the
+        // slot is reused.
+        m_slots[head & k_mask] = T{};
+        m_head.store( head + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Approximate when called while the other side is active.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_head.load( std::memory_order_acquire )
+               == m_tail.load( std::memory_order_acquire );
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+private:
+    static constexpr std::size_t k_mask = Capacity - 1;
+    // Keeps the producer and consumer indices on separate cache lines.
+    static constexpr std::size_t k_cacheLine = 64;
+
+    std::array<T, Capacity> m_slots{};
+
+    // Written by the consumer.
+    alignas( k_cacheLine ) std::atomic<std::size_t> m_head{ 0 };
+    std::size_t m_cachedTail = 0;
+
+    // Written by the producer.
+    alignas( k_cacheLine ) std::atomic<std::size_t> m_tail{ 0 };
+    std::size_t m_cachedHead = 0;
+};
+
+} // namespace utils
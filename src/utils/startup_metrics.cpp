@@ -0,0 +1,59 @@
+#include "startup_metrics.h"
+#include <chrono>
+#include <fstream>
+#ifdef _WIN32
+// K32GetProcessMemoryInfo lives in kernel32, no extra import library needed.
+#    define PSAPI_VERSION 2
+#    include <windows.h>
+#    include <psapi.h>
+#elif defined __linux__
+#    include <unistd.h>
+#endif
+
+namespace utils
+{
+namespace
+{
+    std::chrono::steady_clock::time_point g_processStart
+        = std::chrono::steady_clock::now();
+
+} // namespace
+
+void markProcessStart() noexcept
+{
+    g_processStart = std::chrono::steady_clock::now();
+}
+
+double millisecondsSinceProcessStart() noexcept
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - g_processStart )
+        .count();
+}
+
+std::optional<uint64_t> residentMemoryBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if ( !GetProcessMemoryInfo(
+             GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>( counters.WorkingSetSize );
+#elif defined __linux__
+    // Second field is the resident set in pages.
+    std::ifstream statm( "/proc/self/statm" );
+    uint64_t totalPages = 0;
+    uint64_t residentPages = 0;
+    if ( !( statm >> totalPages >> residentPages ) )
+    {
+        return std::nullopt;
+    }
+    return residentPages * static_cast<uint64_t>( sysconf( _SC_PAGESIZE ) );
+#else
+    return std::nullopt;
+#endif
+}
+
+} // namespace utils
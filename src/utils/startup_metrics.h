@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace utils
+{
+// Should be called first thing in main(), the other startup measurements are
+// relative to it.
+void markProcessStart() noexcept;
+[[nodiscard]] double millisecondsSinceProcessStart() noexcept;
+
+// Resident set size of the process. Empty where it can't be determined.
+[[nodiscard]] std::optional<uint64_t> residentMemoryBytes();
+
+} // namespace utils
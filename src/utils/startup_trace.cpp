@@ -0,0 +1,162 @@
+#include "startup_trace.h"
+#include "startup_metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+namespace
+{
+    struct TraceEvent
+    {
+        const char* name;
+        double startUs;
+        double durationUs;
+        std::size_t threadIndex;
+    };
+
+    std::atomic<bool> g_collecting{ true };
+    std::mutex g_eventsMutex;
+    std::vector<TraceEvent> g_events;
+    // Chrome wants small integer thread ids, the index into this is used.
+    std::vector<std::thread::id> g_threads;
+
+    double microsecondsSinceProcessStart() noexcept
+    {
+        return millisecondsSinceProcessStart() * 1000.0;
+    }
+
+    void addEvent( const char* name, const double startUs, const double endUs )
+    {
+        std::lock_guard<std::mutex> lock( g_eventsMutex );
+        if ( !g_collecting.load( std::memory_order_relaxed ) )
+        {
+            return;
+        }
+
+        const auto thread = std::this_thread::get_id();
+        auto threadIt = std::find( g_threads.begin(), g_threads.end(), thread );
+        if ( threadIt == g_threads.end() )
+        {
+            threadIt = g_threads.insert( g_threads.end(), thread );
+        }
+
+        g_events.push_back( TraceEvent{
+            name,
+            startUs,
+            endUs - startUs,
+            static_cast<std::size_t>( threadIt - g_threads.begin() ) } );
+    }
+
+    void writeJsonString( std::ostream& out, const char* text )
+    {
+        out << '"';
+        for ( ; *text != '\0'; ++text )
+        {
+            if ( *text == '"' || *text == '\\' )
+            {
+                out << '\\';
+            }
+            out << *text;
+        }
+        out << '"';
+    }
+
+} // namespace
+
+StartupSpan::StartupSpan( const char* name ) noexcept
+    : m_name( name ), m_startUs( 0.0 )
+{
+    if ( g_collecting.load( std::memory_order_relaxed ) )
+    {
+        m_startUs = microsecondsSinceProcessStart();
+    }
+}
+
+StartupSpan::~StartupSpan()
+{
+    end();
+}
+
+void StartupSpan::next( const char* name ) noexcept
+{
+    end();
+    m_name = name;
+    if ( g_collecting.load( std::memory_order_relaxed ) )
+    {
+        m_startUs = microsecondsSinceProcessStart();
+    }
+}
+
+void StartupSpan::end() noexcept
+{
+    if ( m_name == nullptr )
+    {
+        return;
+    }
+    if ( g_collecting.load( std::memory_order_relaxed ) )
+    {
+        try
+        {
+            addEvent( m_name, m_startUs, microsecondsSinceProcessStart() );
+        }
+        catch ( ... )
+        {
+            // Out of memory while tracing, the span is lost.
+        }
+    }
+    m_name = nullptr;
+}
+
+bool writeStartupTrace( const std::string& filePath )
+{
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock( g_eventsMutex );
+        g_collecting = false;
+        events.swap( g_events );
+    }
+    // Outer spans end after their children, sorting by start puts them
+    // first which makes the file easier to read.
+    std::stable_sort( events.begin(),
+                      events.end(),
+                      []( const TraceEvent& a, const TraceEvent& b )
+                      { return a.startUs < b.startUs; } );
+
+    std::ofstream out( filePath, std::ios::trunc );
+    if ( !out )
+    {
+        return false;
+    }
+
+    // Timestamps are in us, anything finer than 0.1 us is noise.
+    out << std::fixed << std::setprecision( 1 );
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"OVR Advanced Settings startup\"}}";
+    for ( const auto& event : events )
+    {
+        out << ",\n{\"name\":";
+        writeJsonString( out, event.name );
+        out << ",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":" << event.startUs
+            << ",\"dur\":" << event.durationUs
+            << ",\"pid\":1,\"tid\":" << event.threadIndex << "}";
+    }
+    out << "\n]}\n";
+
+    return static_cast<bool>( out );
+}
+
+void discardStartupTrace()
+{
+    std::lock_guard<std::mutex> lock( g_eventsMutex );
+    g_collecting = false;
+    std::vector<TraceEvent>().swap( g_events );
+}
+
+} // namespace utils
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+namespace utils
+{
+/*!
+Named span of the startup sequence for the --trace-startup Chrome trace.
+
+A span begins on construction and ends on destruction, end() or next().
+Spans that are open at the same time on one thread nest in the trace.
+
+    utils::StartupSpan stage( "initStage1" );
+    utils::StartupSpan controller( "SteamVRTabController" );
+    m_steamVRTabController.initStage1();
+    controller.next( "ChaperoneTabController" );
+    m_chaperoneTabController.initStage1();
+
+Spans are collected from process start until the trace is written or
+discarded, after that a span costs one atomic load. Names must be string
+literals, only the pointer is kept.
+*/
+class StartupSpan
+{
+public:
+    explicit StartupSpan( const char* name ) noexcept;
+    ~StartupSpan();
+
+    StartupSpan( const StartupSpan& ) = delete;
+    StartupSpan& operator=( const StartupSpan& ) = delete;
+
+    // Ends the current span and begins a sibling.
+    void next( const char* name ) noexcept;
+    void end() noexcept;
+
+private:
+    const char* m_name;
+    double m_startUs;
+};
+
+// Writes every span collected so far as Chrome trace_event JSON (open with
+// chrome://tracing or ui.perfetto.dev) and stops collecting. Returns false
+// if the file could not be written.
+bool writeStartupTrace( const std::string& filePath );
+// Stops collecting and frees the spans without writing them.
+void discardStartupTrace();
+
+} // namespace utils
@@ -0,0 +1,445 @@
+#include "tick_recording.h"
+#include <cstring>
+#include <easylogging++.h>
+
+namespace utils
+{
+TickRecording tickRecording{};
+
+namespace
+{
+    enum class ChunkType : uint8_t
+    {
+        Name = 1,
+        Tick = 2,
+    };
+
+    template <typename T> void writeValue( std::ofstream& file, const T& value )
+    {
+        file.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+    }
+
+    template <typename T> bool readValue( std::ifstream& file, T& value )
+    {
+        file.read( reinterpret_cast<char*>( &value ), sizeof( T ) );
+        return static_cast<bool>( file );
+    }
+
+    bool poseIsRecorded( const vr::TrackedDevicePose_t& pose )
+    {
+        return pose.bDeviceIsConnected;
+    }
+} // namespace
+
+bool TickRecordWriter::open( const std::string& filePath )
+{
+    m_file.open( filePath, std::ios::binary | std::ios::trunc );
+    if ( !m_file )
+    {
+        LOG( ERROR ) << "Could not open tick recording '" << filePath
+                     << "' for writing.";
+        return false;
+    }
+
+    m_nameIds.clear();
+    m_file.write( k_tickRecordingMagic, sizeof( k_tickRecordingMagic ) );
+    writeValue( m_file, k_tickRecordingVersion );
+    return static_cast<bool>( m_file );
+}
+
+void TickRecordWriter::close()
+{
+    if ( m_file.is_open() )
+    {
+        m_file.close();
+    }
+}
+
+uint16_t TickRecordWriter::nameId( const std::string_view name )
+{
+    const auto existing = m_nameIds.find( name );
+    if ( existing != m_nameIds.end() )
+    {
+        return existing->second;
+    }
+
+    const auto id = static_cast<uint16_t>( m_nameIds.size() );
+    m_nameIds.emplace( std::string( name ), id );
+
+    // Names are written before the first tick that references them.
+    writeValue( m_file, ChunkType::Name );
+    writeValue( m_file, id );
+    writeValue( m_file, static_cast<uint16_t>( name.size() ) );
+    m_file.write( name.data(), static_cast<std::streamsize>( name.size() ) );
+
+    return id;
+}
+
+bool TickRecordWriter::writeTick( const RecordedTick& tick )
+{
+    uint64_t connectedMask = 0;
+    for ( uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i )
+    {
+        if ( poseIsRecorded( tick.poses[i] ) )
+        {
+            connectedMask |= uint64_t{ 1 } << i;
+        }
+    }
+
+    writeValue( m_file, ChunkType::Tick );
+    writeValue( m_file, tick.tick );
+    writeValue( m_file, tick.secondsSinceStart );
+    writeValue( m_file, static_cast<int32_t>( tick.universe ) );
+    writeValue( m_file, connectedMask );
+    for ( uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i )
+    {
+        if ( connectedMask & ( uint64_t{ 1 } << i ) )
+        {
+            writeValue( m_file, tick.poses[i] );
+        }
+    }
+
+    writeValue( m_file, static_cast<uint16_t>( tick.events.size() ) );
+    for ( const auto& event : tick.events )
+    {
+        writeValue( m_file, event.queue );
+        writeValue( m_file, event.event );
+    }
+
+    writeValue( m_file, static_cast<uint16_t>( tick.queries.size() ) );
+    for ( const auto& query : tick.queries )
+    {
+        writeValue( m_file, query.nameId );
+        writeValue( m_file, query.index );
+        writeValue( m_file, query.size );
+        m_file.write( tick.queryValues.data() + query.offset, query.size );
+    }
+
+    return static_cast<bool>( m_file );
+}
+
+bool TickRecordReader::open( const std::string& filePath )
+{
+    m_file.open( filePath, std::ios::binary );
+    if ( !m_file )
+    {
+        LOG( ERROR ) << "Could not open tick recording '" << filePath
+                     << "' for reading.";
+        return false;
+    }
+
+    char magic[sizeof( k_tickRecordingMagic )] = {};
+    uint32_t version = 0;
+    m_file.read( magic, sizeof( magic ) );
+    if ( !m_file || !readValue( m_file, version )
+         || std::memcmp( magic, k_tickRecordingMagic, sizeof( magic ) ) != 0 )
+    {
+        LOG( ERROR ) << "'" << filePath << "' is not a tick recording.";
+        m_file.close();
+        return false;
+    }
+    if ( version != k_tickRecordingVersion )
+    {
+        LOG( ERROR ) << "Tick recording '" << filePath << "' has version "
+                     << version << ", expected " << k_tickRecordingVersion
+                     << ".";
+        m_file.close();
+        return false;
+    }
+
+    m_nameIds.clear();
+    return true;
+}
+
+void TickRecordReader::close()
+{
+    if ( m_file.is_open() )
+    {
+        m_file.close();
+    }
+}
+
+uint16_t TickRecordReader::nameId( const std::string_view name ) const
+{
+    const auto id = m_nameIds.find( name );
+    return id != m_nameIds.end() ? id->second : k_unknownName;
+}
+
+bool TickRecordReader::readTick( RecordedTick& tick )
+{
+    ChunkType type{};
+    while ( readValue( m_file, type ) )
+    {
+        if ( type == ChunkType::Name )
+        {
+            uint16_t id = 0;
+            uint16_t length = 0;
+            if ( !readValue( m_file, id ) || !readValue( m_file, length ) )
+            {
+                return false;
+            }
+            std::string name( length, '\0' );
+            m_file.read( name.data(), length );
+            m_nameIds[std::move( name )] = id;
+            continue;
+        }
+
+        if ( type != ChunkType::Tick )
+        {
+            LOG( ERROR ) << "Unknown chunk type "
+                         << static_cast<int>( type )
+                         << " in tick recording.";
+            return false;
+        }
+
+        int32_t universe = 0;
+        uint64_t connectedMask = 0;
+        if ( !readValue( m_file, tick.tick )
+             || !readValue( m_file, tick.secondsSinceStart )
+             || !readValue( m_file, universe )
+             || !readValue( m_file, connectedMask ) )
+        {
+            return false;
+        }
+        tick.universe = static_cast<vr::ETrackingUniverseOrigin>( universe );
+
+        tick.poses.fill( vr::TrackedDevicePose_t{} );
+        for ( uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i )
+        {
+            if ( ( connectedMask & ( uint64_t{ 1 } << i ) )
+                 && !readValue( m_file, tick.poses[i] ) )
+            {
+                return false;
+            }
+        }
+
+        uint16_t eventCount = 0;
+        if ( !readValue( m_file, eventCount ) )
+        {
+            return false;
+        }
+        tick.events.resize( eventCount );
+        for ( auto& event : tick.events )
+        {
+            if ( !readValue( m_file, event.queue )
+                 || static_cast<std::size_t>( event.queue )
+                        >= k_eventQueueCount
+                 || !readValue( m_file, event.event ) )
+            {
+                return false;
+            }
+        }
+
+        uint16_t queryCount = 0;
+        if ( !readValue( m_file, queryCount ) )
+        {
+            return false;
+        }
+        tick.queries.resize( queryCount );
+        tick.queryValues.clear();
+        for ( auto& query : tick.queries )
+        {
+            if ( !readValue( m_file, query.nameId )
+                 || !readValue( m_file, query.index )
+                 || !readValue( m_file, query.size ) )
+            {
+                return false;
+            }
+            query.offset = static_cast<uint32_t>( tick.queryValues.size() );
+            tick.queryValues.resize( tick.queryValues.size() + query.size );
+            m_file.read( tick.queryValues.data() + query.offset, query.size );
+            if ( !m_file )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool TickRecording::startRecording( const std::string& filePath )
+{
+    stop();
+    if ( !m_writer.open( filePath ) )
+    {
+        return false;
+    }
+
+    LOG( INFO ) << "Recording ticks to '" << filePath << "'.";
+    m_mode = TickRecordingMode::Record;
+    m_thread = std::this_thread::get_id();
+    m_tickCount = 0;
+    m_startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool TickRecording::startReplay( const std::string& filePath )
+{
+    stop();
+    if ( !m_reader.open( filePath ) )
+    {
+        return false;
+    }
+
+    LOG( INFO ) << "Replaying ticks from '" << filePath << "'.";
+    m_mode = TickRecordingMode::Replay;
+    m_thread = std::this_thread::get_id();
+    m_tickCount = 0;
+    return true;
+}
+
+void TickRecording::stop()
+{
+    if ( m_mode == TickRecordingMode::Off )
+    {
+        return;
+    }
+
+    LOG( INFO ) << ( isRecording() ? "Recorded " : "Replayed " )
+                << m_tickCount << " ticks.";
+    m_writer.close();
+    m_reader.close();
+    m_mode = TickRecordingMode::Off;
+}
+
+bool TickRecording::beginTick()
+{
+    m_nextReplayEvent.fill( 0 );
+
+    if ( isReplaying() )
+    {
+        if ( !m_reader.readTick( m_current ) )
+        {
+            return false;
+        }
+        m_queryReplayed.assign( m_current.queries.size(), false );
+        ++m_tickCount;
+        return true;
+    }
+
+    if ( isRecording() )
+    {
+        m_current.tick = m_tickCount;
+        m_current.secondsSinceStart
+            = std::chrono::duration<double>( std::chrono::steady_clock::now()
+                                             - m_startTime )
+                  .count();
+        m_current.events.clear();
+        m_current.queries.clear();
+        m_current.queryValues.clear();
+    }
+    return true;
+}
+
+void TickRecording::endTick()
+{
+    if ( !isRecording() )
+    {
+        return;
+    }
+
+    if ( !m_writer.writeTick( m_current ) )
+    {
+        LOG( ERROR ) << "Could not write tick recording, stopping.";
+        stop();
+        return;
+    }
+    ++m_tickCount;
+}
+
+void TickRecording::recordEvent( const EventQueue queue,
+                                 const vr::VREvent_t& event )
+{
+    if ( isRecording() )
+    {
+        m_current.events.push_back( { queue, event } );
+    }
+}
+
+bool TickRecording::replayNextEvent( const EventQueue queue,
+                                     vr::VREvent_t& event )
+{
+    auto& next = m_nextReplayEvent[static_cast<std::size_t>( queue )];
+    for ( ; next < m_current.events.size(); ++next )
+    {
+        if ( m_current.events[next].queue == queue )
+        {
+            event = m_current.events[next++].event;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TickRecording::recordValue( const std::string_view name,
+                                 const uint32_t index,
+                                 const void* value,
+                                 const std::size_t size )
+{
+    if ( !isRecording() )
+    {
+        return;
+    }
+
+    RecordedQuery query;
+    query.nameId = m_writer.nameId( name );
+    query.index = index;
+    query.offset = static_cast<uint32_t>( m_current.queryValues.size() );
+    query.size = static_cast<uint32_t>( size );
+    const auto bytes = static_cast<const char*>( value );
+    m_current.queryValues.insert(
+        m_current.queryValues.end(), bytes, bytes + query.size );
+    m_current.queries.push_back( query );
+}
+
+const RecordedQuery*
+    TickRecording::replayValue( const std::string_view name,
+                                const uint32_t index )
+{
+    const auto nameId = m_reader.nameId( name );
+    if ( nameId == TickRecordReader::k_unknownName )
+    {
+        return nullptr;
+    }
+
+    // The first result not handed out yet, otherwise the last one again.
+    const RecordedQuery* last = nullptr;
+    for ( std::size_t i = 0; i < m_current.queries.size(); ++i )
+    {
+        const auto& query = m_current.queries[i];
+        if ( query.nameId != nameId || query.index != index )
+        {
+            continue;
+        }
+        if ( !m_queryReplayed[i] )
+        {
+            m_queryReplayed[i] = true;
+            return &query;
+        }
+        last = &query;
+    }
+    return last;
+}
+
+void TickRecording::recordPoses( const vr::ETrackingUniverseOrigin universe,
+                                 const vr::TrackedDevicePose_t* poses )
+{
+    if ( !isRecording() )
+    {
+        return;
+    }
+
+    m_current.universe = universe;
+    std::copy(
+        poses, poses + vr::k_unMaxTrackedDeviceCount, m_current.poses.begin() );
+}
+
+void TickRecording::replayPoses( vr::TrackedDevicePose_t* poses ) const
+{
+    std::copy( m_current.poses.begin(), m_current.poses.end(), poses );
+}
+
+} // namespace utils
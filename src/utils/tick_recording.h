@@ -0,0 +1,341 @@
+#pragma once
+
+#include <openvr.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils
+{
+/*
+ * Record and replay of the per tick input of OverlayController::mainEventLoop.
+ *
+ * A recording contains, for every tick, the tracking universe, the poses of
+ * all connected devices, every polled VREvent_t with the queue it came from
+ * and the result of every other runtime query the tick makes: action states
+ * (digital, analog and pose), controller roles, device properties, settings
+ * and the like. Replaying a recording feeds exactly that data back into
+ * mainEventLoop instead of asking the runtime for it, so a replay needs no
+ * runtime to answer queries. Calls that only change runtime state still go
+ * out, a replay without SteamVR runs against test/openvr_stub.
+ *
+ * Queries are identified by a name and an index (a device index, a
+ * controller role, 0 if there is nothing to tell apart). When the same query
+ * is made more than once in a tick, replay returns the recorded results in
+ * order and repeats the last one if the replay asks more often.
+ *
+ * File layout (native endianness, recordings are not portable between
+ * architectures):
+ *     header:  char[8] magic "OVRASREC", uint32 version
+ *     chunks:  uint8 chunk type followed by the chunk payload
+ *         Name:  uint16 id, uint16 length, char[length] name
+ *         Tick:  uint64 tick, double seconds since start, int32
+ *                universe, uint64 connected device mask,
+ *                TrackedDevicePose_t for every bit in the mask,
+ *                uint16 event count, { uint8 queue, VREvent_t }[count],
+ *                uint16 query count,
+ *                { uint16 name id, uint32 index, uint32 size,
+ *                  char[size] value }[count]
+ */
+constexpr char k_tickRecordingMagic[8]
+    = { 'O', 'V', 'R', 'A', 'S', 'R', 'E', 'C' };
+constexpr uint32_t k_tickRecordingVersion = 2;
+
+// Only the first 64 device indices are recorded, which covers
+// k_unMaxTrackedDeviceCount.
+static_assert( vr::k_unMaxTrackedDeviceCount <= 64,
+               "Connected device mask is too small." );
+
+// Where mainEventLoop polled an event from.
+enum class EventQueue : uint8_t
+{
+    Overlay = 0,
+    System = 1,
+    Thumbnail = 2,
+};
+constexpr std::size_t k_eventQueueCount = 3;
+
+struct RecordedEvent
+{
+    EventQueue queue = EventQueue::Overlay;
+    vr::VREvent_t event{};
+};
+
+struct RecordedQuery
+{
+    uint16_t nameId = 0;
+    uint32_t index = 0;
+    // Range of the value in RecordedTick::queryValues.
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+struct RecordedTick
+{
+    uint64_t tick = 0;
+    double secondsSinceStart = 0.0;
+    vr::ETrackingUniverseOrigin universe = vr::TrackingUniverseStanding;
+    std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount> poses{};
+    std::vector<RecordedEvent> events;
+    std::vector<RecordedQuery> queries;
+    std::vector<char> queryValues;
+};
+
+class TickRecordWriter
+{
+public:
+    bool open( const std::string& filePath );
+    void close();
+    [[nodiscard]] bool isOpen() const noexcept
+    {
+        return m_file.is_open();
+    }
+
+    uint16_t nameId( const std::string_view name );
+    bool writeTick( const RecordedTick& tick );
+
+private:
+    std::ofstream m_file;
+    std::map<std::string, uint16_t, std::less<>> m_nameIds;
+};
+
+class TickRecordReader
+{
+public:
+    static constexpr uint16_t k_unknownName = 0xFFFF;
+
+    bool open( const std::string& filePath );
+    void close();
+    [[nodiscard]] bool isOpen() const noexcept
+    {
+        return m_file.is_open();
+    }
+
+    // Returns false at the end of the recording or on a corrupt file.
+    bool readTick( RecordedTick& tick );
+    // k_unknownName if no name chunk so far had this name.
+    [[nodiscard]] uint16_t nameId( const std::string_view name ) const;
+
+private:
+    std::ifstream m_file;
+    std::map<std::string, uint16_t, std::less<>> m_nameIds;
+};
+
+enum class TickRecordingMode
+{
+    Off,
+    Record,
+    Replay,
+};
+
+/*!
+Facade used by mainEventLoop, the input layer and the controllers. Depending
+on the mode the per tick data is either written to a file or served from one.
+
+Only the thread that started recording or replay (the Qt thread) takes part,
+queries from other threads always go to the runtime.
+*/
+class TickRecording
+{
+public:
+    bool startRecording( const std::string& filePath );
+    bool startReplay( const std::string& filePath );
+    void stop();
+
+    [[nodiscard]] TickRecordingMode mode() const noexcept
+    {
+        return m_mode;
+    }
+    [[nodiscard]] bool isRecording() const noexcept
+    {
+        return m_mode == TickRecordingMode::Record;
+    }
+    [[nodiscard]] bool isReplaying() const noexcept
+    {
+        return m_mode == TickRecordingMode::Replay;
+    }
+    [[nodiscard]] uint64_t tickCount() const noexcept
+    {
+        return m_tickCount;
+    }
+    // Time of the current tick relative to the start of the recording.
+    [[nodiscard]] double currentTickSeconds() const noexcept
+    {
+        return m_current.secondsSinceStart;
+    }
+
+    // Start of a tick. While replaying this loads the next recorded tick and
+    // returns false once the recording is exhausted.
+    bool beginTick();
+    // End of a tick. While recording this writes the tick to disk.
+    void endTick();
+
+    // Polls the next event of a queue through poll( event ), or serves it
+    // from the recording.
+    template <typename Poll>
+    bool pollEvent( const EventQueue queue, vr::VREvent_t& event, Poll&& poll );
+
+    // The result of query(), or the recorded result while replaying. The
+    // result has to be trivially copyable, a std::string or a std::vector of
+    // trivially copyable elements; it is stored as raw bytes.
+    template <typename Query,
+              typename T = std::decay_t<std::invoke_result_t<Query&>>>
+    T query( const char* name, const uint32_t index, Query&& query );
+    template <typename Query,
+              typename T = std::decay_t<std::invoke_result_t<Query&>>>
+    T query( const std::string& name, const uint32_t index, Query&& query );
+
+    void recordPoses( const vr::ETrackingUniverseOrigin universe,
+                      const vr::TrackedDevicePose_t* poses );
+    [[nodiscard]] vr::ETrackingUniverseOrigin replayUniverse() const noexcept
+    {
+        return m_current.universe;
+    }
+    void replayPoses( vr::TrackedDevicePose_t* poses ) const;
+
+private:
+    [[nodiscard]] bool isActiveOnThisThread() const noexcept
+    {
+        return m_mode != TickRecordingMode::Off
+               && std::this_thread::get_id() == m_thread;
+    }
+    void recordEvent( const EventQueue queue, const vr::VREvent_t& event );
+    bool replayNextEvent( const EventQueue queue, vr::VREvent_t& event );
+    void recordValue( const std::string_view name,
+                      const uint32_t index,
+                      const void* value,
+                      const std::size_t size );
+    // Returns the recorded value, nullptr if the recording has none.
+    const RecordedQuery* replayValue( const std::string_view name,
+                                      const uint32_t index );
+
+    template <typename T, typename Query>
+    T queryValue( const std::string_view name,
+                  const uint32_t index,
+                  Query& query );
+
+    TickRecordingMode m_mode = TickRecordingMode::Off;
+    std::thread::id m_thread;
+    TickRecordWriter m_writer;
+    TickRecordReader m_reader;
+    RecordedTick m_current;
+    std::array<std::size_t, k_eventQueueCount> m_nextReplayEvent{};
+    // Replay position for repeated queries, parallel to m_current.queries.
+    std::vector<bool> m_queryReplayed;
+    uint64_t m_tickCount = 0;
+    std::chrono::steady_clock::time_point m_startTime{};
+};
+
+extern TickRecording tickRecording;
+
+template <typename Poll>
+bool TickRecording::pollEvent( const EventQueue queue,
+                               vr::VREvent_t& event,
+                               Poll&& poll )
+{
+    if ( !isActiveOnThisThread() )
+    {
+        return poll( event );
+    }
+    if ( isReplaying() )
+    {
+        return replayNextEvent( queue, event );
+    }
+    if ( !poll( event ) )
+    {
+        return false;
+    }
+    recordEvent( queue, event );
+    return true;
+}
+
+// std::string and std::vector are recorded as their elements.
+template <typename T> struct RecordedElements
+{
+    static constexpr bool value = false;
+};
+template <> struct RecordedElements<std::string>
+{
+    static constexpr bool value = true;
+};
+template <typename U> struct RecordedElements<std::vector<U>>
+{
+    static constexpr bool value = std::is_trivially_copyable<U>::value;
+};
+
+template <typename T, typename Query>
+T TickRecording::queryValue( const std::string_view name,
+                             const uint32_t index,
+                             Query& query )
+{
+    constexpr auto elements = RecordedElements<T>::value;
+    static_assert( elements || std::is_trivially_copyable<T>::value,
+                   "Recorded query results are stored as raw bytes." );
+    if ( isReplaying() )
+    {
+        T value{};
+        const auto recorded = replayValue( name, index );
+        if ( !recorded )
+        {
+            return value;
+        }
+        const auto bytes = m_current.queryValues.data() + recorded->offset;
+        if constexpr ( elements )
+        {
+            value.resize( recorded->size / sizeof( value[0] ) );
+            std::memcpy(
+                value.data(), bytes, value.size() * sizeof( value[0] ) );
+        }
+        else if ( recorded->size == sizeof( T ) )
+        {
+            std::memcpy( &value, bytes, sizeof( T ) );
+        }
+        return value;
+    }
+    T value = query();
+    if constexpr ( elements )
+    {
+        recordValue(
+            name, index, value.data(), value.size() * sizeof( value[0] ) );
+    }
+    else
+    {
+        recordValue( name, index, &value, sizeof( T ) );
+    }
+    return value;
+}
+
+template <typename Query, typename T>
+T TickRecording::query( const char* name,
+                        const uint32_t index,
+                        Query&& query )
+{
+    if ( !isActiveOnThisThread() )
+    {
+        return query();
+    }
+    return queryValue<T>( name, index, query );
+}
+
+template <typename Query, typename T>
+T TickRecording::query( const std::string& name,
+                        const uint32_t index,
+                        Query&& query )
+{
+    if ( !isActiveOnThisThread() )
+    {
+        return query();
+    }
+    return queryValue<T>( name, index, query );
+}
+
+} // namespace utils
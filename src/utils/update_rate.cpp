@@ -3,55 +3,182 @@
 UpdateRate updateRate{};
 
 /**
-   @brief getSubjectRate returns the amount of frames before a subject is run
-   again.
+   @brief getSubjectPeriod returns the time between two runs of a subject.
    @param Subject
-   @return Amount of frames before subject is run again.
+   @return Minimum amount of time before the subject is run again.
 
-    So a return value of 19 would mean that every 19 frames, the subject is run.
-    Divide the expected framerate with the return value to get the amount of
-   times per second the subject is run.
+    The period is wall clock time, so a subject runs just as often on a 144Hz
+    headset as on a 90Hz one.
  */
-constexpr unsigned int getSubjectRate( const UpdateSubject subject )
+constexpr std::chrono::milliseconds
+    getSubjectPeriod( const UpdateSubject subject )
 {
-    /*
-       Return values are primes in order to reduce the amount of times where
-       multiple subjects are run on the same frame.
-    */
     switch ( subject )
     {
     case UpdateSubject::UtilitiesTabController:
-        return 19;
+        return std::chrono::milliseconds( 200 );
+    case UpdateSubject::AlarmClock:
+        return std::chrono::milliseconds( 500 );
     case UpdateSubject::VideoDashboard:
-        return 47;
+        return std::chrono::milliseconds( 500 );
     case UpdateSubject::AudioTabController:
-        return 89;
+        return std::chrono::milliseconds( 1000 );
     case UpdateSubject::SteamVrTabController:
-        return 97;
+        return std::chrono::milliseconds( 1100 );
     case UpdateSubject::ChaperoneTabController:
-        return 101;
+        return std::chrono::milliseconds( 1100 );
     case UpdateSubject::SettingsTabController:
-        return 157;
+        return std::chrono::milliseconds( 1750 );
+    }
+
+    return std::chrono::milliseconds( 1000 );
+}
+
+/**
+   @brief getSubjectPriority returns which subject wins when several are due.
+   @param Subject
+   @return Higher values are run first.
+ */
+constexpr int getSubjectPriority( const UpdateSubject subject )
+{
+    switch ( subject )
+    {
+    case UpdateSubject::AudioTabController:
+        return 5;
+    case UpdateSubject::UtilitiesTabController:
+        return 4;
+    case UpdateSubject::AlarmClock:
+        return 4;
+    case UpdateSubject::ChaperoneTabController:
+        return 3;
+    case UpdateSubject::VideoDashboard:
+        return 2;
+    case UpdateSubject::SteamVrTabController:
+        return 1;
+    case UpdateSubject::SettingsTabController:
+        return 0;
     }
 
     return 0;
 }
 
-bool UpdateRate::shouldSubjectRun( const UpdateSubject subject ) noexcept
+// Subjects that are due at the same time get spread over consecutive ticks.
+constexpr int k_maxSubjectsPerTick = 1;
+
+namespace
 {
-    const auto subjectTarget = getSubjectRate( subject );
+/*!
+Whether due subject a should run before due subject b.
 
-    const auto shouldRun = ( m_counter % subjectTarget ) == 0;
+A subject that is overdue by a whole period or more is starving and goes
+before every subject that isn't, the one that has been due the longest first.
+Otherwise the higher priority wins. Without this the highest priority
+subjects would be overdue on every tick once the tick rate is slower than
+their period, and the others would never run.
+*/
+bool runsBefore( const UpdateSubject a,
+                 const UpdateRate::Clock::time_point deadlineA,
+                 const UpdateSubject b,
+                 const UpdateRate::Clock::time_point deadlineB,
+                 const UpdateRate::Clock::time_point now ) noexcept
+{
+    const auto starvingA = now - deadlineA >= getSubjectPeriod( a );
+    const auto starvingB = now - deadlineB >= getSubjectPeriod( b );
+    if ( starvingA != starvingB )
+    {
+        return starvingA;
+    }
+    if ( !starvingA )
+    {
+        const auto priorityA = getSubjectPriority( a );
+        const auto priorityB = getSubjectPriority( b );
+        if ( priorityA != priorityB )
+        {
+            return priorityA > priorityB;
+        }
+    }
+    return deadlineA < deadlineB;
+}
 
-    return shouldRun;
+} // namespace
+
+void UpdateRate::initializeDeadlines( const Clock::time_point now ) noexcept
+{
+    // Everything is due right away so that all subjects get their initial
+    // update within the first few ticks.
+    m_deadlines.fill( now );
+    m_deadlinesInitialized = true;
 }
 
-bool UpdateRate::shouldSubjectNotRun( const UpdateSubject subject ) noexcept
+void UpdateRate::beginTick( const SubjectFilter mayRun ) noexcept
 {
-    return !shouldSubjectRun( subject );
+    beginTick( Clock::now(), mayRun );
 }
 
-void UpdateRate::incrementCounter() noexcept
+void UpdateRate::beginTick( const Clock::time_point now,
+                            const SubjectFilter mayRun ) noexcept
 {
-    m_counter++;
+    if ( !m_deadlinesInitialized )
+    {
+        initializeDeadlines( now );
+    }
+
+    m_runThisTick.fill( false );
+    std::array<bool, subjectCount> held{};
+
+    for ( int run = 0; run < k_maxSubjectsPerTick; )
+    {
+        auto selected = subjectCount;
+        for ( std::size_t i = 0; i < subjectCount; ++i )
+        {
+            if ( m_runThisTick[i] || held[i] || m_deadlines[i] > now )
+            {
+                continue;
+            }
+            if ( selected == subjectCount )
+            {
+                selected = i;
+                continue;
+            }
+
+            if ( runsBefore( static_cast<UpdateSubject>( i ),
+                             m_deadlines[i],
+                             static_cast<UpdateSubject>( selected ),
+                             m_deadlines[selected],
+                             now ) )
+            {
+                selected = i;
+            }
+        }
+
+        if ( selected == subjectCount )
+        {
+            return;
+        }
+
+        // A held back subject stays due, it is picked again next tick.
+        if ( mayRun && !mayRun( static_cast<UpdateSubject>( selected ) ) )
+        {
+            held[selected] = true;
+            continue;
+        }
+
+        ++run;
+        m_runThisTick[selected] = true;
+        // Rescheduling from now instead of from the old deadline avoids a
+        // burst of catch-up runs after a subject has been pushed back.
+        m_deadlines[selected]
+            = now
+              + getSubjectPeriod( static_cast<UpdateSubject>( selected ) );
+    }
+}
+
+bool UpdateRate::shouldSubjectRun( const UpdateSubject subject ) noexcept
+{
+    return m_runThisTick[static_cast<std::size_t>( subject )];
+}
+
+bool UpdateRate::shouldSubjectNotRun( const UpdateSubject subject ) noexcept
+{
+    return !shouldSubjectRun( subject );
 }
@@ -1,28 +1,65 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+
 enum class UpdateSubject
 {
+    AlarmClock,
     AudioTabController,
     ChaperoneTabController,
     SettingsTabController,
     SteamVrTabController,
     UtilitiesTabController,
     VideoDashboard,
+    // LAST_ENUMERATOR must always be set to the last value
+    LAST_ENUMERATOR = VideoDashboard,
 };
 
+/*!
+Decides which of the periodic, non-realtime subjects run on the current tick.
+
+Every subject has a period in milliseconds and a priority. Deadlines are kept
+on the steady clock, so the real period does not depend on the refresh rate of
+the headset. To keep individual ticks cheap only a limited amount of subjects
+is allowed to run per tick. When more subjects are due at the same time the
+ones with the highest priority run first and the others are pushed to the
+following ticks. A subject that is overdue by a whole period goes before the
+priorities, so every subject still runs when the ticks are slower than the
+periods.
+
+beginTick() must be called once per tick, before any subject asks whether it
+should run. All calls to shouldSubjectRun() for the same subject during one
+tick return the same value.
+
+beginTick() can be given a filter that is asked before a due subject gets the
+tick's slot. A subject the filter holds back does not run, keeps its deadline
+and the slot goes to the next due subject; the frame budget governor uses this
+to postpone work without losing it.
+*/
 class UpdateRate
 {
 public:
+    using Clock = std::chrono::steady_clock;
+    // Returns false to hold a due subject back for this tick.
+    using SubjectFilter = bool ( * )( const UpdateSubject subject );
+
     [[nodiscard]] bool shouldSubjectRun( const UpdateSubject subject ) noexcept;
     [[nodiscard]] bool
         shouldSubjectNotRun( const UpdateSubject subject ) noexcept;
-    void incrementCounter() noexcept;
+    void beginTick( const SubjectFilter mayRun = nullptr ) noexcept;
+    void beginTick( const Clock::time_point now,
+                    const SubjectFilter mayRun = nullptr ) noexcept;
 
 private:
-    // counter is deliberately set as unsigned so that the program can continue
-    // functioning if the counter should go above INT_MAX (or UINT_MAX in this
-    // case)
-    unsigned int m_counter = 0;
+    static constexpr auto subjectCount
+        = static_cast<std::size_t>( UpdateSubject::LAST_ENUMERATOR ) + 1;
+
+    void initializeDeadlines( const Clock::time_point now ) noexcept;
+
+    bool m_deadlinesInitialized = false;
+    std::array<Clock::time_point, subjectCount> m_deadlines{};
+    std::array<bool, subjectCount> m_runThisTick{};
 };
 
 extern UpdateRate updateRate;
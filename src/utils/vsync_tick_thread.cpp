@@ -0,0 +1,206 @@
+#include "vsync_tick_thread.h"
+#include "scheduling_policy.h"
+#include <easylogging++.h>
+
+namespace utils
+{
+// Wake up slightly after the predicted vsync so that the frame counter has
+// already advanced when it is read.
+constexpr auto k_vsyncWakeMargin = std::chrono::microseconds( 500 );
+// Used when vsync is late (dropped frames) and no prediction can be made.
+constexpr auto k_vsyncRetryInterval = std::chrono::milliseconds( 1 );
+// The display frequency can change at runtime (SteamVR settings), but doing
+// an IPC call every frame just to catch that is wasteful.
+constexpr auto k_displayFrequencyRefreshInterval = std::chrono::seconds( 1 );
+constexpr float k_defaultDisplayFrequency = 90.0f;
+
+VsyncTickThread::VsyncTickThread( std::function<void()> postTick )
+    : m_postTick( std::move( postTick ) )
+{
+}
+
+VsyncTickThread::~VsyncTickThread()
+{
+    stop();
+}
+
+void VsyncTickThread::start()
+{
+    if ( m_running )
+    {
+        return;
+    }
+    // The thread may have exited on its own, see exit().
+    if ( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+    m_running = true;
+    m_tickPending = false;
+    m_thread = std::thread( &VsyncTickThread::run, this );
+}
+
+void VsyncTickThread::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_sleepMutex );
+        m_running = false;
+    }
+    m_sleepCondition.notify_all();
+    if ( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+}
+
+void VsyncTickThread::exit()
+{
+    LOG( WARNING ) << "Vsync tick thread: VRSystem is gone, no more ticks.";
+    std::lock_guard<std::mutex> lock( m_sleepMutex );
+    m_running = false;
+}
+
+void VsyncTickThread::tickFinished() noexcept
+{
+    m_tickPending = false;
+}
+
+void VsyncTickThread::setVsyncDisabled( const bool value ) noexcept
+{
+    m_vsyncDisabled = value;
+}
+
+void VsyncTickThread::setCustomTickRateMs( const int value ) noexcept
+{
+    m_customTickRateMs = value;
+}
+
+void VsyncTickThread::setNonVsyncTickRateMs( const int value ) noexcept
+{
+    m_nonVsyncTickRateMs = value;
+}
+
+void VsyncTickThread::postTick()
+{
+    // Only one tick may be in flight. If the receiving thread is still busy
+    // with the previous one this frame is skipped rather than queued.
+    if ( !m_tickPending.exchange( true ) )
+    {
+        m_postTick();
+    }
+}
+
+void VsyncTickThread::refreshDisplayFrequency()
+{
+    m_lastFrequencyRefresh = Clock::now();
+
+    vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+    const auto frequency = vr::VRSystem()->GetFloatTrackedDeviceProperty(
+        vr::k_unTrackedDeviceIndex_Hmd,
+        vr::Prop_DisplayFrequency_Float,
+        &error );
+
+    if ( error != vr::TrackedProp_Success || frequency <= 0.0f )
+    {
+        m_displayFrequency = k_defaultDisplayFrequency;
+        m_sharedDisplayFrequency = m_displayFrequency;
+        return;
+    }
+
+    if ( frequency != m_displayFrequency )
+    {
+        LOG( INFO ) << "Vsync tick thread: display frequency is " << frequency
+                    << "Hz.";
+    }
+    m_displayFrequency = frequency;
+    m_sharedDisplayFrequency = m_displayFrequency;
+}
+
+bool VsyncTickThread::sleepUntil( const Clock::time_point wakeTime )
+{
+    std::unique_lock<std::mutex> lock( m_sleepMutex );
+    m_sleepCondition.wait_until(
+        lock, wakeTime, [this]() { return !m_running; } );
+    return m_running;
+}
+
+void VsyncTickThread::run()
+{
+    applyThreadRole( ThreadRole::Tick );
+    m_lastTick = Clock::now();
+    m_lastFrame = 0;
+    if ( !vr::VRSystem() )
+    {
+        exit();
+        return;
+    }
+    refreshDisplayFrequency();
+
+    while ( m_running )
+    {
+        if ( m_vsyncDisabled )
+        {
+            postTick();
+            m_lastTick = Clock::now();
+            sleepUntil( m_lastTick
+                        + std::chrono::milliseconds( m_customTickRateMs ) );
+            continue;
+        }
+
+        float secondsSinceLastVsync = 0.0f;
+        uint64_t currentFrame = 0;
+        if ( !vr::VRSystem() )
+        {
+            exit();
+            return;
+        }
+        const auto vsyncValid = vr::VRSystem()->GetTimeSinceLastVsync(
+            &secondsSinceLastVsync, &currentFrame );
+
+        const auto now = Clock::now();
+        const auto forcedTickTime
+            = m_lastTick + std::chrono::milliseconds( m_nonVsyncTickRateMs );
+
+        if ( vsyncValid && currentFrame > m_lastFrame )
+        {
+            postTick();
+            m_lastFrame = currentFrame;
+            m_lastTick = now;
+        }
+        else if ( now >= forcedTickTime )
+        {
+            postTick();
+            // m_lastFrame = currentFrame + 1 skips the next vsync frame in
+            // case it was just about to trigger, to prevent double updates
+            // faster than one frame.
+            m_lastFrame = currentFrame + 1;
+            m_lastTick = now;
+        }
+
+        if ( now - m_lastFrequencyRefresh >= k_displayFrequencyRefreshInterval )
+        {
+            refreshDisplayFrequency();
+        }
+
+        const auto framePeriod
+            = std::chrono::duration<float>( 1.0f / m_displayFrequency );
+        const auto timeToNextVsync
+            = framePeriod
+              - std::chrono::duration<float>( secondsSinceLastVsync );
+
+        auto wakeTime = now + k_vsyncRetryInterval;
+        if ( vsyncValid && timeToNextVsync.count() > 0.0f )
+        {
+            wakeTime = now
+                       + std::chrono::duration_cast<Clock::duration>(
+                           timeToNextVsync )
+                       + k_vsyncWakeMargin;
+        }
+
+        sleepUntil( std::min(
+            wakeTime,
+            m_lastTick + std::chrono::milliseconds( m_nonVsyncTickRateMs ) ) );
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <openvr.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace utils
+{
+/* Drives the main event loop from a dedicated timing thread.
+ *
+ * Instead of polling GetTimeSinceLastVsync() every 1ms the thread predicts
+ * when the next vsync will happen from the time since the last one and the
+ * display frequency, sleeps until then, and posts exactly one tick per frame.
+ * A new tick is only posted once the previous one has been handled
+ * (tickFinished()), so a busy Qt thread never accumulates a backlog of ticks.
+ *
+ * When vsync is disabled ticks are posted every customTickRateMs instead.
+ */
+class VsyncTickThread
+{
+public:
+    explicit VsyncTickThread( std::function<void()> postTick );
+    ~VsyncTickThread();
+
+    VsyncTickThread( const VsyncTickThread& ) = delete;
+    VsyncTickThread& operator=( const VsyncTickThread& ) = delete;
+
+    void start();
+    void stop();
+
+    // Must be called from the receiving thread once a posted tick has run.
+    void tickFinished() noexcept;
+
+    void setVsyncDisabled( const bool value ) noexcept;
+    void setCustomTickRateMs( const int value ) noexcept;
+    // Number of ms after which a tick is forced when vsync is late, for
+    // example because of dropped frames.
+    void setNonVsyncTickRateMs( const int value ) noexcept;
+
+    // False once stop() was called or the thread exited because VRSystem()
+    // went away.
+    [[nodiscard]] bool isRunning() const noexcept
+    {
+        return m_running;
+    }
+    // Last display frequency read by the thread, safe to call from any
+    // thread.
+    [[nodiscard]] float displayFrequency() const noexcept
+    {
+        return m_sharedDisplayFrequency.load( std::memory_order_relaxed );
+    }
+    [[nodiscard]] bool vsyncDisabled() const noexcept
+    {
+        return m_vsyncDisabled;
+    }
+    [[nodiscard]] int customTickRateMs() const noexcept
+    {
+        return m_customTickRateMs;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    // Clears m_running when run() returns on its own.
+    void exit();
+    void postTick();
+    void refreshDisplayFrequency();
+    // Returns false if stop() was called while sleeping.
+    bool sleepUntil( const Clock::time_point wakeTime );
+
+    std::function<void()> m_postTick;
+
+    std::thread m_thread;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<bool> m_running{ false };
+    std::atomic<bool> m_tickPending{ false };
+
+    std::atomic<bool> m_vsyncDisabled{ false };
+    std::atomic<int> m_customTickRateMs{ 20 };
+    std::atomic<int> m_nonVsyncTickRateMs{ 20 };
+
+    float m_displayFrequency = 90.0f;
+    std::atomic<float> m_sharedDisplayFrequency{ 90.0f };
+    Clock::time_point m_lastFrequencyRefresh{};
+    Clock::time_point m_lastTick{};
+    uint64_t m_lastFrame = 0;
+};
+
+} // namespace utils
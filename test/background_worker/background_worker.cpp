@@ -0,0 +1,164 @@
+#include <openvr.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "background_worker.h"
+#include <easylogging++.h>
+
+INITIALIZE_EASYLOGGINGPP
+
+/* Measures what the tick pays for the runtime reads that moved to the
+ * background worker: the nine SteamVR settings SteamVRTabController syncs,
+ * plus the string setting and the auto launch query of the Settings page.
+ * They run inline on the tick first, then through utils::BackgroundWorker
+ * as post() and runCompletions(), k_ticks times each with k_tickPeriod in
+ * between.
+ *
+ * The stub's latency per call stands in for the vrserver round trip, set it
+ * with OVRAS_STUB_LATENCY_US.
+ *
+ * Afterwards the idle worker is left alone for k_idleTime and its wakeups
+ * are counted as voluntary context switches of the process, minus the ones
+ * of the main thread.
+ */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int k_ticks = 2000;
+constexpr auto k_tickPeriod = std::chrono::milliseconds( 1 );
+constexpr auto k_idleTime = std::chrono::seconds( 2 );
+
+struct BoolSetting
+{
+    const char* section;
+    const char* key;
+};
+
+constexpr BoolSetting k_boolSettings[] = {
+    { vr::k_pch_Perf_Section, vr::k_pch_Perf_PerfGraphInHMD_Bool },
+    { vr::k_pch_SteamVR_Section,
+      vr::k_pch_SteamVR_ActivateMultipleDrivers_Bool },
+    { vr::k_pch_Notifications_Section,
+      vr::k_pch_Notifications_DoNotDisturb_Bool },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_DoNotFadeToGrid },
+    { vr::k_pch_Camera_Section, vr::k_pch_Camera_EnableCamera_Bool },
+    { vr::k_pch_Camera_Section, vr::k_pch_Camera_ShowOnController_Bool },
+    { vr::k_pch_Camera_Section,
+      vr::k_pch_Camera_EnableCameraForCollisionBounds_Bool },
+    { vr::k_pch_Power_Section,
+      vr::k_pch_Power_AutoLaunchSteamVROnButtonPress },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_RequireHmd_String },
+};
+
+int readSettings()
+{
+    int enabled = 0;
+    for ( const auto& setting : k_boolSettings )
+    {
+        auto error = vr::VRSettingsError_None;
+        enabled += vr::VRSettings()->GetBool(
+            setting.section, setting.key, &error );
+    }
+    char value[4096] = {};
+    auto error = vr::VRSettingsError_None;
+    vr::VRSettings()->GetString( vr::k_pch_SteamVR_Section,
+                                 vr::k_pch_SteamVR_RequireHmd_String,
+                                 value,
+                                 sizeof( value ),
+                                 &error );
+    enabled += vr::VRApplications()->GetApplicationAutoLaunch(
+        "steam.overlay.1009850" );
+    return enabled;
+}
+
+double microseconds( const Clock::duration duration )
+{
+    return std::chrono::duration<double, std::micro>( duration ).count();
+}
+
+long voluntaryContextSwitches( const int who )
+{
+    rusage usage{};
+    getrusage( who, &usage );
+    return usage.ru_nvcsw;
+}
+
+template <typename Tick> void measure( const char* name, Tick&& tick )
+{
+    std::vector<double> times;
+    times.reserve( k_ticks );
+    for ( int i = 0; i < k_ticks; ++i )
+    {
+        const auto start = Clock::now();
+        tick();
+        times.push_back( microseconds( Clock::now() - start ) );
+        std::this_thread::sleep_for( k_tickPeriod );
+    }
+    std::sort( times.begin(), times.end() );
+    const auto mean = std::accumulate( times.begin(), times.end(), 0.0 )
+                      / static_cast<double>( times.size() );
+    std::printf( "%-10s tick mean %9.1f us, p99 %9.1f us, max %9.1f us\n",
+                 name,
+                 mean,
+                 times[times.size() * 99 / 100],
+                 times.back() );
+}
+
+} // namespace
+
+int main()
+{
+    auto error = vr::VRInitError_None;
+    vr::VR_Init( &error, vr::VRApplication_Overlay );
+    if ( error != vr::VRInitError_None )
+    {
+        std::fprintf( stderr,
+                      "VR_Init failed: %s\n",
+                      vr::VR_GetVRInitErrorAsEnglishDescription( error ) );
+        return 2;
+    }
+    const auto latency = std::getenv( "OVRAS_STUB_LATENCY_US" );
+    std::printf( "stub latency %s us per call\n", latency ? latency : "0" );
+
+    int sink = 0;
+    measure( "inline", [&sink] { sink += readSettings(); } );
+
+    auto& worker = utils::backgroundWorker;
+    worker.start();
+    measure( "offloaded",
+             [&sink, &worker]
+             {
+                 worker.post(
+                     [&sink]() -> utils::BackgroundWorker::Completion
+                     {
+                         const auto enabled = readSettings();
+                         return [&sink, enabled] { sink += enabled; };
+                     } );
+                 worker.runCompletions();
+             } );
+    const auto statistics = worker.statistics();
+    std::printf( "worker     %llu jobs, %llu dropped, longest %llu us\n",
+                 static_cast<unsigned long long>( statistics.jobsRun ),
+                 static_cast<unsigned long long>( statistics.jobsDropped ),
+                 static_cast<unsigned long long>( statistics.maxJobUs ) );
+
+    const auto processBefore = voluntaryContextSwitches( RUSAGE_SELF );
+    const auto mainBefore = voluntaryContextSwitches( RUSAGE_THREAD );
+    std::this_thread::sleep_for( k_idleTime );
+    const auto workerWakeups
+        = ( voluntaryContextSwitches( RUSAGE_SELF ) - processBefore )
+          - ( voluntaryContextSwitches( RUSAGE_THREAD ) - mainBefore );
+    std::printf( "idle       %.1f worker wakeups per second\n",
+                 static_cast<double>( workerWakeups )
+                     / std::chrono::duration<double>( k_idleTime ).count() );
+
+    worker.stop();
+    vr::VR_Shutdown();
+    return sink < 0 ? 1 : 0;
+}
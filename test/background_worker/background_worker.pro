@@ -0,0 +1,26 @@
+# Tick time of the SteamVR and auto start reads inline and through
+# utils::BackgroundWorker, and wakeups of the idle worker.
+# Runs against the OpenVR stub, build test/openvr_stub first.
+TEMPLATE = app
+TARGET = background_worker
+
+CONFIG += c++1z warn_on console release
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../../third-party/openvr/headers ../../src/utils
+INCLUDEPATH += ../../third-party/easylogging++
+DEFINES += ELPP_THREAD_SAFE ELPP_NO_DEFAULT_LOG_FILE
+
+LIBS += -L$$OUT_PWD/../openvr_stub -lopenvr_api -lpthread
+QMAKE_RPATHDIR += $$OUT_PWD/../openvr_stub
+
+SOURCES += \
+    background_worker.cpp \
+    ../../src/utils/background_worker.cpp \
+    ../../src/utils/scheduling_policy.cpp \
+    ../../third-party/easylogging++/easylogging++.cc
+
+HEADERS += \
+    ../../src/utils/background_worker.h \
+    ../../src/utils/scheduling_policy.h \
+    ../../src/utils/spsc_queue.h
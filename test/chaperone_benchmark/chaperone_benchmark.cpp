@@ -0,0 +1,432 @@
+#include <benchmark/benchmark.h>
+#include <openvr.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "chaperone_segments.h"
+#include "chaperone_segment_tree.h"
+
+namespace
+{
+constexpr std::size_t k_pointCount = 256;
+constexpr std::size_t k_pathLength = 1024;
+// HMD, two controllers and five trackers.
+constexpr std::size_t k_deviceCount = 8;
+
+struct LegacyQuad
+{
+    float distance;
+    vr::HmdVector3_t nearestPoint;
+    vr::HmdVector3_t corners[2];
+};
+
+/* ChaperoneUtils::_getDistancesToChaperone before the structure of arrays
+ * kernel, the baseline the kernel is compared against.
+ */
+std::vector<LegacyQuad> legacyDistances( const vr::HmdVector3_t* corners,
+                                         const uint32_t quadsCount,
+                                         const vr::HmdVector3_t& x )
+{
+    std::vector<LegacyQuad> result;
+    for ( uint32_t i = 0; i < quadsCount; i++ )
+    {
+        uint32_t i2 = ( i + 1 ) % quadsCount;
+        const vr::HmdVector3_t& r0 = corners[i];
+        const vr::HmdVector3_t& r1 = corners[i2];
+        float u_x = r1.v[0] - r0.v[0];
+        float u_z = r1.v[2] - r0.v[2];
+        float r = ( ( x.v[0] - r0.v[0] ) * u_x + ( x.v[2] - r0.v[2] ) * u_z )
+                  / ( u_x * u_x + u_z * u_z );
+        float d;
+        float x1_x;
+        float x1_z;
+        if ( r < 0.0f || r > 1.0f )
+        {
+            float d_x = r0.v[0] - x.v[0];
+            float d_z = r0.v[2] - x.v[2];
+            float d1 = static_cast<float>(
+                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
+            d_x = r1.v[0] - x.v[0];
+            d_z = r1.v[2] - x.v[2];
+            float d2 = static_cast<float>(
+                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
+            if ( d1 < d2 )
+            {
+                d = d1;
+                x1_x = r0.v[0];
+                x1_z = r0.v[2];
+            }
+            else
+            {
+                d = d2;
+                x1_x = r1.v[0];
+                x1_z = r1.v[2];
+            }
+        }
+        else
+        {
+            x1_x = r0.v[0] + r * u_x;
+            x1_z = r0.v[2] + r * u_z;
+            float d_x = x1_x - x.v[0];
+            float d_z = x1_z - x.v[2];
+            d = static_cast<float>(
+                sqrt( static_cast<double>( d_x * d_x + d_z * d_z ) ) );
+        }
+        LegacyQuad computedQuad;
+        computedQuad.distance = d;
+        computedQuad.nearestPoint = { x1_x, x.v[1], x1_z };
+        computedQuad.corners[0] = r0;
+        computedQuad.corners[1] = r1;
+        result.push_back( computedQuad );
+    }
+    return result;
+}
+
+LegacyQuad legacyNearest( const vr::HmdVector3_t* corners,
+                          const uint32_t quadsCount,
+                          const vr::HmdVector3_t& x )
+{
+    auto distances = legacyDistances( corners, quadsCount, x );
+    return *std::min_element(
+        distances.begin(),
+        distances.end(),
+        []( const LegacyQuad& quadA, const LegacyQuad& quadB ) {
+            return std::isnan( quadA.distance )
+                   || ( quadA.distance < quadB.distance );
+        } );
+}
+
+// A slightly irregular loop around the origin, 2 to 3 m out, the way
+// SteamVR's room setup traces a room.
+std::vector<vr::HmdVector3_t> boundary( const std::size_t segments )
+{
+    std::mt19937 random( 42 );
+    std::uniform_real_distribution<float> radius( 2.0f, 3.0f );
+    std::vector<vr::HmdVector3_t> corners;
+    for ( std::size_t i = 0; i < segments; ++i )
+    {
+        const auto angle = static_cast<float>( 2.0 * M_PI * i / segments );
+        const auto r = radius( random );
+        corners.push_back( { r * std::cos( angle ), 0.0f,
+                             r * std::sin( angle ) } );
+    }
+    return corners;
+}
+
+std::vector<vr::HmdVector3_t> trackedPoints()
+{
+    std::mt19937 random( 7 );
+    std::uniform_real_distribution<float> position( -2.5f, 2.5f );
+    std::uniform_real_distribution<float> height( 0.5f, 1.8f );
+    std::vector<vr::HmdVector3_t> points;
+    for ( std::size_t i = 0; i < k_pointCount; ++i )
+    {
+        points.push_back(
+            { position( random ), height( random ), position( random ) } );
+    }
+    return points;
+}
+
+// A closed Lissajous path through the play area, about 1.5 m/s when sampled
+// at 90 Hz, for the frame to frame coherence a tracked device has.
+std::vector<vr::HmdVector3_t> trackedPath()
+{
+    std::vector<vr::HmdVector3_t> points;
+    for ( std::size_t i = 0; i < k_pathLength; ++i )
+    {
+        const auto t = static_cast<float>( 2.0 * M_PI * i / k_pathLength );
+        points.push_back( { 1.8f * std::sin( 3.0f * t ),
+                            1.2f,
+                            1.8f * std::sin( 2.0f * t ) } );
+    }
+    return points;
+}
+
+std::size_t segmentCount( const benchmark::State& state )
+{
+    return static_cast<std::size_t>( state.range( 0 ) );
+}
+
+bool kernelMatchesLegacy( const std::vector<vr::HmdVector3_t>& corners,
+                          const utils::ChaperoneSegments& segments,
+                          const std::vector<vr::HmdVector3_t>& points )
+{
+    std::vector<float> squaredDistances;
+    std::vector<float> along;
+    for ( const auto& point : points )
+    {
+        const auto expected = legacyNearest(
+            corners.data(), static_cast<uint32_t>( corners.size() ), point );
+        const auto actual = segments.nearest(
+            point.v[0], point.v[2], squaredDistances, along );
+        if ( std::abs( expected.distance - actual.distance ) > 1e-4f )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BM_LegacyNearest( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(
+            legacyNearest( corners.data(),
+                           static_cast<uint32_t>( corners.size() ),
+                           points[i++ % points.size()] ) );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+void BM_SegmentsNearest( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    if ( !kernelMatchesLegacy( corners, segments, points ) )
+    {
+        state.SkipWithError( "kernel disagrees with the legacy path" );
+        return;
+    }
+    std::vector<float> squaredDistances;
+    std::vector<float> along;
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        const auto& point = points[i++ % points.size()];
+        benchmark::DoNotOptimize( segments.nearest(
+            point.v[0], point.v[2], squaredDistances, along ) );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+bool treeMatchesLinear( const utils::ChaperoneSegments& segments,
+                        const utils::ChaperoneSegmentTree& tree,
+                        const std::vector<vr::HmdVector3_t>& points )
+{
+    std::vector<float> squaredDistances;
+    std::vector<float> along;
+    auto hint = utils::ChaperoneSegmentTree::k_noHint;
+    for ( const auto& point : points )
+    {
+        const auto expected = segments.nearest(
+            point.v[0], point.v[2], squaredDistances, along );
+        const auto actual
+            = tree.nearest( segments, point.v[0], point.v[2], hint );
+        hint = actual.segment;
+        if ( std::abs( expected.distance - actual.distance ) > 1e-5f )
+        {
+            return false;
+        }
+    }
+    // A device without a valid pose, with nothing to start from.
+    const auto invalid = tree.nearest( segments,
+                                       NAN,
+                                       NAN,
+                                       utils::ChaperoneSegmentTree::k_noHint );
+    return std::isnan( invalid.distance )
+           && invalid.segment == segments.size();
+}
+
+void BM_TreeNearest( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    utils::ChaperoneSegmentTree tree;
+    tree.build( segments );
+    if ( !treeMatchesLinear( segments, tree, points ) )
+    {
+        state.SkipWithError( "tree disagrees with the linear search" );
+        return;
+    }
+    std::size_t tested = 0;
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        const auto& point = points[i++ % points.size()];
+        std::size_t segmentsTested = 0;
+        benchmark::DoNotOptimize(
+            tree.nearest( segments,
+                          point.v[0],
+                          point.v[2],
+                          utils::ChaperoneSegmentTree::k_noHint,
+                          &segmentsTested ) );
+        tested += segmentsTested;
+    }
+    state.counters["segments_tested"] = benchmark::Counter(
+        static_cast<double>( tested ), benchmark::Counter::kAvgIterations );
+}
+
+void BM_TreeNearestCoherent( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto path = trackedPath();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    utils::ChaperoneSegmentTree tree;
+    tree.build( segments );
+    if ( !treeMatchesLinear( segments, tree, path ) )
+    {
+        state.SkipWithError( "tree disagrees with the linear search" );
+        return;
+    }
+    auto hint = utils::ChaperoneSegmentTree::k_noHint;
+    std::size_t tested = 0;
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        const auto& point = path[i++ % path.size()];
+        std::size_t segmentsTested = 0;
+        const auto nearest = tree.nearest(
+            segments, point.v[0], point.v[2], hint, &segmentsTested );
+        hint = nearest.segment;
+        tested += segmentsTested;
+        benchmark::DoNotOptimize( nearest );
+    }
+    state.counters["segments_tested"] = benchmark::Counter(
+        static_cast<double>( tested ), benchmark::Counter::kAvgIterations );
+}
+
+void BM_TreeBuild( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    utils::ChaperoneSegmentTree tree;
+    for ( auto _ : state )
+    {
+        tree.build( segments );
+        benchmark::ClobberMemory();
+    }
+}
+
+bool batchMatchesSingle( const utils::ChaperoneSegments& segments,
+                         const std::vector<vr::HmdVector3_t>& points )
+{
+    std::vector<float> squaredDistances;
+    std::vector<float> along;
+    std::vector<utils::NearestSegment> results( points.size() );
+    segments.nearest(
+        points.data(), points.size(), results.data(), squaredDistances );
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        const auto expected = segments.nearest(
+            points[i].v[0], points[i].v[2], squaredDistances, along );
+        if ( expected.segment != results[i].segment
+             || expected.distance != results[i].distance )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BM_DevicesSingle( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    std::vector<float> squaredDistances;
+    std::vector<float> along;
+    std::size_t frame = 0;
+    for ( auto _ : state )
+    {
+        const auto first = ( frame++ * k_deviceCount ) % points.size();
+        for ( std::size_t i = first; i < first + k_deviceCount; ++i )
+        {
+            benchmark::DoNotOptimize( segments.nearest(
+                points[i].v[0], points[i].v[2], squaredDistances, along ) );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * k_deviceCount );
+}
+
+void BM_DevicesBatched( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    if ( !batchMatchesSingle( segments, points ) )
+    {
+        state.SkipWithError( "batch disagrees with single point queries" );
+        return;
+    }
+    std::vector<float> scratch;
+    std::vector<utils::NearestSegment> results( k_deviceCount );
+    std::size_t frame = 0;
+    for ( auto _ : state )
+    {
+        const auto first = ( frame++ * k_deviceCount ) % points.size();
+        segments.nearest(
+            &points[first], k_deviceCount, results.data(), scratch );
+        benchmark::DoNotOptimize( results.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * k_deviceCount );
+}
+
+void BM_LegacyAllDistances( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        auto distances
+            = legacyDistances( corners.data(),
+                               static_cast<uint32_t>( corners.size() ),
+                               points[i++ % points.size()] );
+        benchmark::DoNotOptimize( distances.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+void BM_SegmentsAllDistances( benchmark::State& state )
+{
+    const auto corners = boundary( segmentCount( state ) );
+    const auto points = trackedPoints();
+    utils::ChaperoneSegments segments;
+    segments.assign( corners.data(), corners.size() );
+    std::vector<float> distances;
+    std::vector<float> nearestX;
+    std::vector<float> nearestZ;
+    std::size_t i = 0;
+    for ( auto _ : state )
+    {
+        const auto& point = points[i++ % points.size()];
+        segments.distances(
+            point.v[0], point.v[2], distances, nearestX, nearestZ );
+        benchmark::DoNotOptimize( distances.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+} // namespace
+
+BENCHMARK( BM_LegacyNearest )->Arg( 4 )->Arg( 64 )->Arg( 2000 );
+BENCHMARK( BM_SegmentsNearest )
+    ->Arg( 4 )
+    ->RangeMultiplier( 4 )
+    ->Range( 16, 4096 )
+    ->Arg( 2000 );
+BENCHMARK( BM_TreeNearest )->Arg( 4 )->RangeMultiplier( 4 )->Range( 16, 4096 );
+BENCHMARK( BM_TreeNearestCoherent )
+    ->Arg( 4 )
+    ->RangeMultiplier( 4 )
+    ->Range( 16, 4096 );
+BENCHMARK( BM_DevicesSingle )->Arg( 4 )->Arg( 16 )->Arg( 63 );
+BENCHMARK( BM_DevicesBatched )->Arg( 4 )->Arg( 16 )->Arg( 63 );
+BENCHMARK( BM_TreeBuild )->Arg( 64 )->Arg( 4096 );
+BENCHMARK( BM_LegacyAllDistances )->Arg( 4 )->Arg( 64 )->Arg( 2000 );
+BENCHMARK( BM_SegmentsAllDistances )->Arg( 4 )->Arg( 64 )->Arg( 2000 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,19 @@
+# Google Benchmark of the chaperone distance queries, needs libbenchmark.
+TEMPLATE = app
+TARGET = chaperone_benchmark
+
+CONFIG += c++1z warn_on console release
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../../third-party/openvr/headers ../../src/utils
+
+LIBS += -lbenchmark -lpthread
+
+SOURCES += \
+    chaperone_benchmark.cpp \
+    ../../src/utils/chaperone_segments.cpp \
+    ../../src/utils/chaperone_segment_tree.cpp
+
+HEADERS += \
+    ../../src/utils/chaperone_segments.h \
+    ../../src/utils/chaperone_segment_tree.h
@@ -0,0 +1,253 @@
+#include <openvr.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ChaperoneUtils.h"
+#include <easylogging++.h>
+
+INITIALIZE_EASYLOGGINGPP
+
+/* Two readers query ChaperoneUtils the way the tick and a background thread
+ * do, while a writer reloads the bounds back to back. The OpenVR stub delays
+ * every GetLiveCollisionBoundsInfo call by k_ipcLatency to stand in for the
+ * IPC.
+ *
+ * A reader that has to wait for anything gives up the CPU, which the kernel
+ * counts as a voluntary context switch of that thread; the query loop makes
+ * no other blocking calls. The test fails if a reader had any.
+ *
+ * Call times are printed as p50, p99, p99.9 and the longest. On machines
+ * with few cores the tail is the readers being preempted by each other and
+ * the writer, not waiting: every call longer than k_slowCall is checked for
+ * an involuntary context switch of its thread. Calls that were slow without
+ * one are counted; on a virtual machine that is usually stolen time, so
+ * they are reported rather than failing the test. --no-reload runs the
+ * readers without the writer, which shows the tail readers cause alone.
+ *
+ * --locked takes one mutex around every query and reload, the way the
+ * recursive mutex ChaperoneUtils used to have did, for comparison.
+ */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto k_ipcLatency = std::chrono::milliseconds( 20 );
+constexpr auto k_runTime = std::chrono::seconds( 3 );
+constexpr std::size_t k_deviceCount = 8;
+constexpr auto k_slowCall = std::chrono::milliseconds( 1 );
+
+struct ReaderStats
+{
+    std::size_t calls = 0;
+    std::size_t invalid = 0;
+    long waits = 0;
+    long preemptions = 0;
+    std::size_t slow = 0;
+    std::size_t slowNotPreempted = 0;
+    std::vector<Clock::duration> durations;
+};
+
+rusage threadUsage()
+{
+    rusage usage{};
+    getrusage( RUSAGE_THREAD, &usage );
+    return usage;
+}
+
+std::atomic<bool> g_running{ true };
+std::mutex g_lock;
+bool g_locked = false;
+bool g_reload = true;
+
+template <typename Query> ReaderStats readLoop( Query query )
+{
+    ReaderStats stats;
+    // Once, so the scratch buffers have grown before counting.
+    query();
+    stats.durations.reserve( 1 << 20 );
+    const auto usageBefore = threadUsage();
+    auto preemptedBefore = usageBefore.ru_nivcsw;
+    while ( g_running.load( std::memory_order_relaxed ) )
+    {
+        const auto start = Clock::now();
+        bool valid = false;
+        if ( g_locked )
+        {
+            std::lock_guard<std::mutex> lock( g_lock );
+            valid = query();
+        }
+        else
+        {
+            valid = query();
+        }
+        const auto duration = Clock::now() - start;
+        const auto preempted = threadUsage().ru_nivcsw;
+        ++stats.calls;
+        stats.durations.push_back( duration );
+        if ( duration >= k_slowCall )
+        {
+            ++stats.slow;
+            if ( preempted == preemptedBefore )
+            {
+                ++stats.slowNotPreempted;
+            }
+        }
+        preemptedBefore = preempted;
+        if ( !valid )
+        {
+            ++stats.invalid;
+        }
+    }
+    const auto usageAfter = threadUsage();
+    stats.waits = usageAfter.ru_nvcsw - usageBefore.ru_nvcsw;
+    stats.preemptions = usageAfter.ru_nivcsw - usageBefore.ru_nivcsw;
+    std::sort( stats.durations.begin(), stats.durations.end() );
+    return stats;
+}
+
+double milliseconds( const Clock::duration duration )
+{
+    return std::chrono::duration<double, std::milli>( duration ).count();
+}
+
+double percentile( const ReaderStats& stats, const double p )
+{
+    if ( stats.durations.empty() )
+    {
+        return 0.0;
+    }
+    const auto last = stats.durations.size() - 1;
+    return milliseconds(
+        stats.durations[static_cast<std::size_t>( p * last )] );
+}
+
+void print( const char* name, const ReaderStats& stats )
+{
+    std::printf( "%-10s %8zu calls, %ld waits, %zu invalid\n",
+                 name,
+                 stats.calls,
+                 stats.waits,
+                 stats.invalid );
+    std::printf( "           p50 %.4f ms, p99 %.4f ms, p99.9 %.4f ms, "
+                 "longest %.3f ms\n",
+                 percentile( stats, 0.5 ),
+                 percentile( stats, 0.99 ),
+                 percentile( stats, 0.999 ),
+                 percentile( stats, 1.0 ) );
+    std::printf( "           %ld preemptions, %zu calls over %lld ms, %zu of "
+                 "them not preempted\n",
+                 stats.preemptions,
+                 stats.slow,
+                 static_cast<long long>( k_slowCall.count() ),
+                 stats.slowNotPreempted );
+}
+
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        g_locked = g_locked || std::strcmp( argv[i], "--locked" ) == 0;
+        g_reload = g_reload && std::strcmp( argv[i], "--no-reload" ) != 0;
+    }
+    const auto latency = "GetLiveCollisionBoundsInfo="
+                         + std::to_string( std::chrono::microseconds(
+                                               k_ipcLatency )
+                                               .count() );
+    setenv( "OVRAS_STUB_CALL_LATENCY", latency.c_str(), 0 );
+    setenv( "OVRAS_STUB_BOUNDS_QUADS", "128", 0 );
+
+    auto error = vr::VRInitError_None;
+    vr::VR_Init( &error, vr::VRApplication_Overlay );
+    if ( error != vr::VRInitError_None )
+    {
+        std::fprintf( stderr,
+                      "VR_Init failed: %s\n",
+                      vr::VR_GetVRInitErrorAsEnglishDescription( error ) );
+        return 2;
+    }
+
+    utils::ChaperoneUtils chaperone;
+    chaperone.loadChaperoneData();
+
+    std::vector<vr::HmdVector3_t> devices;
+    for ( std::size_t i = 0; i < k_deviceCount; ++i )
+    {
+        const auto angle = static_cast<float>( 2.0 * M_PI * i / k_deviceCount );
+        devices.push_back(
+            { 0.8f * std::cos( angle ), 1.2f, 0.8f * std::sin( angle ) } );
+    }
+
+    std::size_t reloads = 0;
+    std::thread writer(
+        [&chaperone, &reloads]
+        {
+            while ( g_reload && g_running.load( std::memory_order_relaxed ) )
+            {
+                if ( g_locked )
+                {
+                    std::lock_guard<std::mutex> lock( g_lock );
+                    chaperone.loadChaperoneData();
+                }
+                else
+                {
+                    chaperone.loadChaperoneData();
+                }
+                ++reloads;
+            }
+        } );
+
+    ReaderStats tickStats;
+    std::thread tick(
+        [&]
+        {
+            std::vector<utils::NearestSegment> results( k_deviceCount );
+            tickStats = readLoop(
+                [&]
+                {
+                    chaperone.queryChaperone(
+                        devices.data(), devices.size(), results.data() );
+                    return !std::isnan( results[0].distance );
+                } );
+        } );
+
+    ReaderStats backgroundStats;
+    std::thread background(
+        [&]
+        {
+            std::vector<utils::ChaperoneQuadData> quads;
+            backgroundStats = readLoop(
+                [&]
+                {
+                    chaperone.getDistancesToChaperone( devices[0], quads );
+                    return !quads.empty();
+                } );
+        } );
+
+    std::this_thread::sleep_for( k_runTime );
+    g_running = false;
+    writer.join();
+    tick.join();
+    background.join();
+    vr::VR_Shutdown();
+
+    std::printf( "%s, %zu reloads, %u CPUs\n",
+                 g_locked ? "locked" : "snapshots",
+                 reloads,
+                 std::thread::hardware_concurrency() );
+    print( "tick", tickStats );
+    print( "background", backgroundStats );
+
+    const auto failed = tickStats.waits + backgroundStats.waits > 0
+                        || tickStats.invalid + backgroundStats.invalid > 0;
+    return failed && !g_locked ? 1 : 0;
+}
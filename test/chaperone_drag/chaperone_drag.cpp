@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include <openvr.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "ChaperoneUtils.h"
+#include <easylogging++.h>
+
+INITIALIZE_EASYLOGGINGPP
+
+/* What a tick costs while the space is dragged: the part of
+ * MoveCenterTabController::updateSpace that talks to the chaperone, followed
+ * by the query FrameContext::updateChaperone makes for every device.
+ *
+ * BM_DragTickReload fetches the working collision bounds again after every
+ * move, the way updateSpace used to. BM_DragTickCached keeps the geometry
+ * ChaperoneUtils already has, which is what updateSpace does now. Moving the
+ * standing zero pose doesn't change the bounds, they are stored relative to
+ * it; that is checked against a fresh reload before timing.
+ *
+ * The stub delays every GetWorkingCollisionBoundsInfo call by 50 us to stand
+ * in for the IPC, OVRAS_STUB_CALL_LATENCY overrides it.
+ */
+namespace
+{
+// HMD, two controllers and five trackers.
+constexpr std::size_t k_deviceCount = 8;
+// A drag moves the space a few millimetres per tick.
+constexpr float k_stepPerTick = 0.004f;
+constexpr std::size_t k_ticksPerSweep = 500;
+
+std::vector<vr::HmdVector3_t> devicePositions()
+{
+    std::vector<vr::HmdVector3_t> devices;
+    for ( std::size_t i = 0; i < k_deviceCount; ++i )
+    {
+        const auto angle = static_cast<float>( 2.0 * M_PI * i / k_deviceCount );
+        devices.push_back(
+            { 0.8f * std::cos( angle ), 1.2f, 0.8f * std::sin( angle ) } );
+    }
+    return devices;
+}
+
+void moveSpace( const vr::HmdMatrix34_t& origin, const std::size_t tick )
+{
+    auto pose = origin;
+    const auto step = static_cast<float>( tick % k_ticksPerSweep );
+    pose.m[0][3] += k_stepPerTick * step;
+    vr::VRChaperoneSetup()->SetWorkingStandingZeroPoseToRawTrackingPose(
+        &pose );
+    vr::VRChaperoneSetup()->ShowWorkingSetPreview();
+}
+
+bool cachedMatchesReload( const utils::ChaperoneUtils& cached,
+                          const vr::HmdMatrix34_t& origin,
+                          const std::vector<vr::HmdVector3_t>& devices )
+{
+    moveSpace( origin, k_ticksPerSweep / 2 );
+    utils::ChaperoneUtils reloaded;
+    reloaded.loadChaperoneData( false );
+    std::vector<utils::NearestSegment> expected( devices.size() );
+    std::vector<utils::NearestSegment> results( devices.size() );
+    reloaded.queryChaperone( devices.data(), devices.size(), expected.data() );
+    cached.queryChaperone( devices.data(), devices.size(), results.data() );
+    vr::VRChaperoneSetup()->SetWorkingStandingZeroPoseToRawTrackingPose(
+        &origin );
+    for ( std::size_t i = 0; i < devices.size(); ++i )
+    {
+        if ( expected[i].segment != results[i].segment
+             || expected[i].distance != results[i].distance )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void dragTick( benchmark::State& state, const bool reload )
+{
+    utils::ChaperoneUtils chaperone;
+    chaperone.loadChaperoneData( false );
+    const auto devices = devicePositions();
+    vr::HmdMatrix34_t origin;
+    vr::VRChaperoneSetup()->GetWorkingStandingZeroPoseToRawTrackingPose(
+        &origin );
+    if ( !cachedMatchesReload( chaperone, origin, devices ) )
+    {
+        state.SkipWithError( "cached geometry disagrees with a reload" );
+        return;
+    }
+    std::vector<utils::NearestSegment> results( devices.size() );
+    std::size_t tick = 0;
+    for ( auto _ : state )
+    {
+        moveSpace( origin, tick++ );
+        if ( reload )
+        {
+            chaperone.loadChaperoneData( false );
+        }
+        chaperone.queryChaperone(
+            devices.data(), devices.size(), results.data() );
+        benchmark::DoNotOptimize( results.data() );
+    }
+    vr::VRChaperoneSetup()->SetWorkingStandingZeroPoseToRawTrackingPose(
+        &origin );
+    state.counters["segments"] = static_cast<double>( chaperone.quadsCount() );
+}
+
+void BM_DragTickReload( benchmark::State& state )
+{
+    dragTick( state, true );
+}
+
+void BM_DragTickCached( benchmark::State& state )
+{
+    dragTick( state, false );
+}
+
+} // namespace
+
+BENCHMARK( BM_DragTickReload )->Unit( benchmark::kMicrosecond );
+BENCHMARK( BM_DragTickCached )->Unit( benchmark::kMicrosecond );
+
+int main( int argc, char* argv[] )
+{
+    setenv( "OVRAS_STUB_CALL_LATENCY", "GetWorkingCollisionBoundsInfo=50", 0 );
+    setenv( "OVRAS_STUB_BOUNDS_QUADS", "64", 0 );
+
+    benchmark::Initialize( &argc, argv );
+    if ( benchmark::ReportUnrecognizedArguments( argc, argv ) )
+    {
+        return 1;
+    }
+
+    auto error = vr::VRInitError_None;
+    vr::VR_Init( &error, vr::VRApplication_Overlay );
+    if ( error != vr::VRInitError_None )
+    {
+        std::fprintf( stderr,
+                      "VR_Init failed: %s\n",
+                      vr::VR_GetVRInitErrorAsEnglishDescription( error ) );
+        return 2;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    vr::VR_Shutdown();
+    return 0;
+}
@@ -0,0 +1,30 @@
+# Google Benchmark of a space drag tick, needs libbenchmark.
+# Runs against the OpenVR stub, build test/openvr_stub first.
+TEMPLATE = app
+TARGET = chaperone_drag
+
+CONFIG += c++1z warn_on console release
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../../third-party/openvr/headers ../../src/utils
+INCLUDEPATH += ../../third-party/easylogging++
+DEFINES += ELPP_THREAD_SAFE ELPP_NO_DEFAULT_LOG_FILE
+
+LIBS += -L$$OUT_PWD/../openvr_stub -lopenvr_api -lbenchmark -lpthread
+QMAKE_RPATHDIR += $$OUT_PWD/../openvr_stub
+
+SOURCES += \
+    chaperone_drag.cpp \
+    ../../src/utils/ChaperoneUtils.cpp \
+    ../../src/utils/chaperone_segments.cpp \
+    ../../src/utils/chaperone_segment_tree.cpp \
+    ../../src/utils/tick_recording.cpp \
+    ../../src/openvr/ovr_recorded_queries.cpp \
+    ../../third-party/easylogging++/easylogging++.cc
+
+HEADERS += \
+    ../../src/utils/ChaperoneUtils.h \
+    ../../src/utils/chaperone_segments.h \
+    ../../src/utils/chaperone_segment_tree.h \
+    ../../src/utils/tick_recording.h \
+    ../../src/openvr/ovr_recorded_queries.h
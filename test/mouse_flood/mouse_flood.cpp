@@ -0,0 +1,175 @@
+#include <openvr.h>
+#include <QByteArray>
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "mouse_move_coalescer.h"
+
+/* Drains the dashboard overlay's event queue the way
+ * OverlayController::mainEventLoop does, with the OpenVR stub delivering
+ * OVRAS_STUB_MOUSE_MOVES moves per drain (default 64), and sends the moves to
+ * a Qt Quick scene of hoverable items standing in for a dashboard page.
+ *
+ * By default the moves go through utils::MouseMoveCoalescer like in the
+ * overlay; --every-move sends each of them to Qt, as the overlay did before.
+ * The time per drain includes polling the stub and Qt's hover handling; the
+ * render requests the overlay makes per sent move are counted, not made.
+ *
+ * Needs a Qt platform plugin, QT_QPA_PLATFORM=offscreen works without a
+ * display.
+ */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int k_drains = 2000;
+constexpr auto k_scene = R"(
+import QtQuick 2.7
+Item {
+    width: 1200
+    height: 800
+    Grid {
+        columns: 12
+        Repeater {
+            model: 96
+            Rectangle {
+                width: 100
+                height: 100
+                color: area.containsMouse ? "#445566" : "#223344"
+                MouseArea {
+                    id: area
+                    anchors.fill: parent
+                    hoverEnabled: true
+                }
+            }
+        }
+    }
+}
+)";
+
+double milliseconds( const Clock::duration duration )
+{
+    return std::chrono::duration<double, std::milli>( duration ).count();
+}
+
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+    const bool everyMove
+        = argc > 1 && std::strcmp( argv[1], "--every-move" ) == 0;
+    setenv( "OVRAS_STUB_MOUSE_MOVES", "64", 0 );
+
+    QGuiApplication application( argc, argv );
+    QQmlEngine engine;
+    QQmlComponent component( &engine );
+    component.setData( QByteArray( k_scene ), QUrl() );
+    std::unique_ptr<QQuickItem> root(
+        qobject_cast<QQuickItem*>( component.create() ) );
+    if ( !root )
+    {
+        std::fprintf( stderr,
+                      "Could not create the scene: %s\n",
+                      qPrintable( component.errorString() ) );
+        return 2;
+    }
+    QQuickWindow window;
+    root->setParentItem( window.contentItem() );
+    window.setGeometry( 0,
+                        0,
+                        static_cast<int>( root->width() ),
+                        static_cast<int>( root->height() ) );
+
+    auto error = vr::VRInitError_None;
+    vr::VR_Init( &error, vr::VRApplication_Overlay );
+    if ( error != vr::VRInitError_None )
+    {
+        std::fprintf( stderr,
+                      "VR_Init failed: %s\n",
+                      vr::VR_GetVRInitErrorAsEnglishDescription( error ) );
+        return 2;
+    }
+    vr::VROverlayHandle_t overlay = vr::k_ulOverlayHandleInvalid;
+    vr::VROverlayHandle_t thumbnail = vr::k_ulOverlayHandleInvalid;
+    vr::VROverlay()->CreateDashboardOverlay(
+        "mouse_flood", "mouse_flood", &overlay, &thumbnail );
+    vr::HmdVector2_t mouseScale = { static_cast<float>( root->width() ),
+                                    static_cast<float>( root->height() ) };
+    vr::VROverlay()->SetOverlayMouseScale( overlay, &mouseScale );
+
+    utils::MouseMoveCoalescer<QPoint> mouseMoves;
+    QPoint lastSent;
+    uint64_t renderRequests = 0;
+    const auto send = [&]
+    {
+        const auto position = mouseMoves.take( lastSent );
+        if ( !position )
+        {
+            return;
+        }
+        QMouseEvent event( QEvent::MouseMove,
+                           *position,
+                           window.mapToGlobal( *position ),
+                           Qt::NoButton,
+                           Qt::NoButton,
+                           Qt::NoModifier );
+        lastSent = *position;
+        QCoreApplication::sendEvent( &window, &event );
+        ++renderRequests;
+    };
+
+    std::vector<double> drainTimes;
+    drainTimes.reserve( k_drains );
+    for ( int drain = 0; drain < k_drains; ++drain )
+    {
+        const auto start = Clock::now();
+        vr::VREvent_t event{};
+        while ( vr::VROverlay()->PollNextOverlayEvent(
+            overlay, &event, sizeof( event ) ) )
+        {
+            if ( event.eventType != vr::VREvent_MouseMove )
+            {
+                continue;
+            }
+            mouseMoves.move(
+                QPoint( static_cast<int>( event.data.mouse.x ),
+                        static_cast<int>( event.data.mouse.y ) ) );
+            if ( everyMove )
+            {
+                send();
+            }
+        }
+        send();
+        drainTimes.push_back( milliseconds( Clock::now() - start ) );
+    }
+    vr::VR_Shutdown();
+
+    std::sort( drainTimes.begin(), drainTimes.end() );
+    const auto mean
+        = std::accumulate( drainTimes.begin(), drainTimes.end(), 0.0 )
+          / static_cast<double>( drainTimes.size() );
+    std::printf( "%s, %d drains\n",
+                 everyMove ? "every move" : "coalesced",
+                 k_drains );
+    std::printf( "moves %llu received, %llu sent, %llu render requests\n",
+                 static_cast<unsigned long long>( mouseMoves.receivedCount() ),
+                 static_cast<unsigned long long>( mouseMoves.sentCount() ),
+                 static_cast<unsigned long long>( renderRequests ) );
+    std::printf( "drain mean %8.3f ms, p99 %8.3f ms, max %8.3f ms\n",
+                 mean,
+                 drainTimes[drainTimes.size() * 99 / 100],
+                 drainTimes.back() );
+    return 0;
+}
@@ -0,0 +1,19 @@
+# Cost of a mouse move flood in the overlay's event drain, with and without
+# coalescing. Runs against the OpenVR stub, build test/openvr_stub first.
+TEMPLATE = app
+TARGET = mouse_flood
+
+QT += quick
+CONFIG += c++1z warn_on console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../third-party/openvr/headers ../../src/utils
+
+LIBS += -L$$OUT_PWD/../openvr_stub -lopenvr_api
+QMAKE_RPATHDIR += $$OUT_PWD/../openvr_stub
+
+SOURCES += \
+    mouse_flood.cpp
+
+HEADERS += \
+    ../../src/utils/mouse_move_coalescer.h
@@ -0,0 +1,24 @@
+# Stand-in for libopenvr_api, see stub_runtime.h.
+TEMPLATE = lib
+TARGET = openvr_api
+
+CONFIG += c++1z warn_on shared
+CONFIG -= qt app_bundle
+
+DEFINES += VR_API_EXPORT
+unix:QMAKE_CXXFLAGS += -fvisibility=hidden
+
+INCLUDEPATH += ../../third-party/openvr/headers
+
+SOURCES += \
+    stub_runtime.cpp \
+    stub_system.cpp \
+    stub_applications.cpp \
+    stub_settings.cpp \
+    stub_chaperone.cpp \
+    stub_compositor.cpp \
+    stub_overlay.cpp \
+    stub_input.cpp
+
+HEADERS += \
+    stub_runtime.h
@@ -0,0 +1,247 @@
+#include "stub_runtime.h"
+
+namespace stub
+{
+using namespace vr;
+
+class StubApplications : public vr::IVRApplications
+{
+public:
+    static constexpr auto k_interfaceName = "IVRApplications";
+
+    EVRApplicationError AddApplicationManifest( const char*, bool ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRApplicationError RemoveApplicationManifest( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool IsApplicationInstalled( const char* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    uint32_t GetApplicationCount() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRApplicationError
+        GetApplicationKeyByIndex( uint32_t,
+                                  char* pchAppKeyBuffer,
+                                  uint32_t unAppKeyBufferLen ) override
+    {
+        STUB_CALL();
+        copyString( "", pchAppKeyBuffer, unAppKeyBufferLen );
+        return VRApplicationError_InvalidIndex;
+    }
+
+    EVRApplicationError
+        GetApplicationKeyByProcessId( uint32_t,
+                                      char* pchAppKeyBuffer,
+                                      uint32_t unAppKeyBufferLen ) override
+    {
+        STUB_CALL();
+        copyString( "", pchAppKeyBuffer, unAppKeyBufferLen );
+        return VRApplicationError_UnknownApplication;
+    }
+
+    EVRApplicationError LaunchApplication( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRApplicationError LaunchTemplateApplication( const char*,
+                                                   const char*,
+                                                   const AppOverrideKeys_t*,
+                                                   uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    vr::EVRApplicationError
+        LaunchApplicationFromMimeType( const char*,
+                                       const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRApplicationError LaunchDashboardOverlay( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool CancelApplicationLaunch( const char* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVRApplicationError IdentifyApplication( uint32_t, const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    uint32_t GetApplicationProcessId( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    const char*
+        GetApplicationsErrorNameFromEnum( EVRApplicationError error ) override
+    {
+        STUB_CALL();
+        return error == VRApplicationError_None ? "VRApplicationError_None"
+                                                : "VRApplicationError_Stub";
+    }
+
+    uint32_t
+        GetApplicationPropertyString( const char*,
+                                      EVRApplicationProperty,
+                                      char* pchPropertyValueBuffer,
+                                      uint32_t unPropertyValueBufferLen,
+                                      EVRApplicationError* peError ) override
+    {
+        STUB_CALL();
+        copyString( "", pchPropertyValueBuffer, unPropertyValueBufferLen );
+        setError( peError, VRApplicationError_UnknownApplication );
+        return 0;
+    }
+
+    bool GetApplicationPropertyBool( const char*,
+                                     EVRApplicationProperty,
+                                     EVRApplicationError* peError ) override
+    {
+        STUB_CALL();
+        setError( peError, VRApplicationError_UnknownApplication );
+        return false;
+    }
+
+    uint64_t
+        GetApplicationPropertyUint64( const char*,
+                                      EVRApplicationProperty,
+                                      EVRApplicationError* peError ) override
+    {
+        STUB_CALL();
+        setError( peError, VRApplicationError_UnknownApplication );
+        return 0;
+    }
+
+    EVRApplicationError SetApplicationAutoLaunch( const char*, bool ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool GetApplicationAutoLaunch( const char* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVRApplicationError SetDefaultApplicationForMimeType( const char*,
+                                                          const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool GetDefaultApplicationForMimeType( const char*,
+                                           char* pchAppKeyBuffer,
+                                           uint32_t unAppKeyBufferLen ) override
+    {
+        STUB_CALL();
+        copyString( "", pchAppKeyBuffer, unAppKeyBufferLen );
+        return false;
+    }
+
+    bool GetApplicationSupportedMimeTypes( const char*,
+                                           char* pchMimeTypesBuffer,
+                                           uint32_t unMimeTypesBuffer ) override
+    {
+        STUB_CALL();
+        copyString( "", pchMimeTypesBuffer, unMimeTypesBuffer );
+        return false;
+    }
+
+    uint32_t GetApplicationsThatSupportMimeType(
+        const char*,
+        char* pchAppKeysThatSupportBuffer,
+        uint32_t unAppKeysThatSupportBuffer ) override
+    {
+        STUB_CALL();
+        return copyString(
+            "", pchAppKeysThatSupportBuffer, unAppKeysThatSupportBuffer );
+    }
+
+    uint32_t GetApplicationLaunchArguments( uint32_t,
+                                            char* pchArgs,
+                                            uint32_t unArgs ) override
+    {
+        STUB_CALL();
+        return copyString( "", pchArgs, unArgs );
+    }
+
+    EVRApplicationError
+        GetStartingApplication( char* pchAppKeyBuffer,
+                                uint32_t unAppKeyBufferLen ) override
+    {
+        STUB_CALL();
+        copyString( "", pchAppKeyBuffer, unAppKeyBufferLen );
+        return VRApplicationError_NoApplication;
+    }
+
+    EVRSceneApplicationState GetSceneApplicationState() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRApplicationError PerformApplicationPrelaunchCheck( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    const char* GetSceneApplicationStateNameFromEnum(
+        EVRSceneApplicationState ) override
+    {
+        STUB_CALL();
+        return "EVRSceneApplicationState_None";
+    }
+
+    EVRApplicationError LaunchInternalProcess( const char*,
+                                               const char*,
+                                               const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    uint32_t GetCurrentSceneProcessId() override
+    {
+        STUB_CALL();
+        return {};
+    }
+};
+
+vr::IVRApplications* applicationsInterface()
+{
+    static StubApplications instance;
+    return &instance;
+}
+
+} // namespace stub
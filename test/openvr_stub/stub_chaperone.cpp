@@ -0,0 +1,378 @@
+#include "stub_runtime.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace stub
+{
+using namespace vr;
+
+namespace
+{
+    struct ChaperoneData
+    {
+        std::vector<HmdQuad_t> collisionBounds;
+        float playAreaX = 0.0f;
+        float playAreaZ = 0.0f;
+        HmdMatrix34_t standingZeroPose = {};
+        HmdMatrix34_t seatedZeroPose = {};
+    };
+
+    constexpr float k_wallHeight = 2.43f;
+
+    HmdVector3_t floorPoint( const float x, const float z )
+    {
+        return { { x, 0.0f, z } };
+    }
+
+    // Walls of a rectangle for four quads, of a regular polygon inscribed in
+    // the play area otherwise.
+    std::vector<HmdQuad_t> initialBounds()
+    {
+        const auto quads = config().boundsQuads;
+        const auto halfX = config().playAreaX / 2.0f;
+        const auto halfZ = config().playAreaZ / 2.0f;
+
+        std::vector<HmdVector3_t> floor;
+        if ( quads == 4 )
+        {
+            floor = { floorPoint( -halfX, -halfZ ),
+                      floorPoint( halfX, -halfZ ),
+                      floorPoint( halfX, halfZ ),
+                      floorPoint( -halfX, halfZ ) };
+        }
+        else
+        {
+            for ( uint32_t i = 0; i < quads; ++i )
+            {
+                const auto angle = 2.0 * 3.14159265358979323846 * i / quads;
+                const auto x = halfX * static_cast<float>( std::cos( angle ) );
+                const auto z = halfZ * static_cast<float>( std::sin( angle ) );
+                floor.push_back( floorPoint( x, z ) );
+            }
+        }
+
+        std::vector<HmdQuad_t> bounds( floor.size() );
+        for ( std::size_t i = 0; i < floor.size(); ++i )
+        {
+            const auto& start = floor[i];
+            const auto& end = floor[( i + 1 ) % floor.size()];
+            auto& corners = bounds[i].vCorners;
+            corners[0] = start;
+            corners[1] = start;
+            corners[1].v[1] = k_wallHeight;
+            corners[2] = end;
+            corners[2].v[1] = k_wallHeight;
+            corners[3] = end;
+        }
+        return bounds;
+    }
+
+    // Shared by IVRChaperone and IVRChaperoneSetup.
+    struct ChaperoneState
+    {
+        ChaperoneState()
+        {
+            live.collisionBounds = initialBounds();
+            live.playAreaX = config().playAreaX;
+            live.playAreaZ = config().playAreaZ;
+            for ( int i = 0; i < 3; ++i )
+            {
+                live.standingZeroPose.m[i][i] = 1.0f;
+                live.seatedZeroPose.m[i][i] = 1.0f;
+            }
+            working = live;
+        }
+
+        std::mutex mutex;
+        ChaperoneData live;
+        ChaperoneData working;
+        bool boundsForcedVisible = false;
+    };
+
+    ChaperoneState& chaperoneState()
+    {
+        static ChaperoneState state;
+        return state;
+    }
+
+    HmdQuad_t playAreaRect( const ChaperoneData& data )
+    {
+        const auto halfX = data.playAreaX / 2.0f;
+        const auto halfZ = data.playAreaZ / 2.0f;
+        HmdQuad_t rect;
+        rect.vCorners[0] = floorPoint( -halfX, -halfZ );
+        rect.vCorners[1] = floorPoint( halfX, -halfZ );
+        rect.vCorners[2] = floorPoint( halfX, halfZ );
+        rect.vCorners[3] = floorPoint( -halfX, halfZ );
+        return rect;
+    }
+
+    bool copyBounds( const ChaperoneData& data,
+                     HmdQuad_t* buffer,
+                     uint32_t* count )
+    {
+        const auto available
+            = static_cast<uint32_t>( data.collisionBounds.size() );
+        if ( !buffer || *count < available )
+        {
+            *count = available;
+            return false;
+        }
+        std::copy(
+            data.collisionBounds.begin(), data.collisionBounds.end(), buffer );
+        *count = available;
+        return true;
+    }
+} // namespace
+
+class StubChaperone : public vr::IVRChaperone
+{
+public:
+    static constexpr auto k_interfaceName = "IVRChaperone";
+
+    ChaperoneCalibrationState GetCalibrationState() override
+    {
+        STUB_CALL();
+        return ChaperoneCalibrationState_OK;
+    }
+
+    bool GetPlayAreaSize( float* pSizeX, float* pSizeZ ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *pSizeX = state.live.playAreaX;
+        *pSizeZ = state.live.playAreaZ;
+        return true;
+    }
+
+    bool GetPlayAreaRect( HmdQuad_t* rect ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *rect = playAreaRect( state.live );
+        return true;
+    }
+
+    void ReloadInfo() override
+    {
+        STUB_CALL();
+    }
+
+    void SetSceneColor( HmdColor_t ) override
+    {
+        STUB_CALL();
+    }
+
+    void GetBoundsColor( HmdColor_t*, int, float, HmdColor_t* ) override
+    {
+        STUB_CALL();
+    }
+
+    bool AreBoundsVisible() override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        return state.boundsForcedVisible;
+    }
+
+    void ForceBoundsVisible( bool bForce ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.boundsForcedVisible = bForce;
+    }
+
+    void ResetZeroPose( ETrackingUniverseOrigin ) override
+    {
+        STUB_CALL();
+    }
+};
+
+class StubChaperoneSetup : public vr::IVRChaperoneSetup
+{
+public:
+    static constexpr auto k_interfaceName = "IVRChaperoneSetup";
+
+    bool CommitWorkingCopy( EChaperoneConfigFile ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.live = state.working;
+        return true;
+    }
+
+    void RevertWorkingCopy() override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working = state.live;
+    }
+
+    bool GetWorkingPlayAreaSize( float* pSizeX, float* pSizeZ ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *pSizeX = state.working.playAreaX;
+        *pSizeZ = state.working.playAreaZ;
+        return true;
+    }
+
+    bool GetWorkingPlayAreaRect( HmdQuad_t* rect ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *rect = playAreaRect( state.working );
+        return true;
+    }
+
+    bool GetWorkingCollisionBoundsInfo( HmdQuad_t* pQuadsBuffer,
+                                        uint32_t* punQuadsCount ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        return copyBounds( state.working, pQuadsBuffer, punQuadsCount );
+    }
+
+    bool GetLiveCollisionBoundsInfo( HmdQuad_t* pQuadsBuffer,
+                                     uint32_t* punQuadsCount ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        return copyBounds( state.live, pQuadsBuffer, punQuadsCount );
+    }
+
+    bool GetWorkingSeatedZeroPoseToRawTrackingPose(
+        HmdMatrix34_t* pmatSeatedZeroPoseToRawTrackingPose ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *pmatSeatedZeroPoseToRawTrackingPose = state.working.seatedZeroPose;
+        return true;
+    }
+
+    bool GetWorkingStandingZeroPoseToRawTrackingPose(
+        HmdMatrix34_t* pmatStandingZeroPoseToRawTrackingPose ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *pmatStandingZeroPoseToRawTrackingPose = state.working.standingZeroPose;
+        return true;
+    }
+
+    void SetWorkingPlayAreaSize( float sizeX, float sizeZ ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working.playAreaX = sizeX;
+        state.working.playAreaZ = sizeZ;
+    }
+
+    void SetWorkingCollisionBoundsInfo( HmdQuad_t* pQuadsBuffer,
+                                        uint32_t unQuadsCount ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working.collisionBounds.assign( pQuadsBuffer,
+                                              pQuadsBuffer + unQuadsCount );
+    }
+
+    void SetWorkingPerimeter( HmdVector2_t*, uint32_t ) override
+    {
+        STUB_CALL();
+    }
+
+    void SetWorkingSeatedZeroPoseToRawTrackingPose(
+        const HmdMatrix34_t* pMatSeatedZeroPoseToRawTrackingPose ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working.seatedZeroPose = *pMatSeatedZeroPoseToRawTrackingPose;
+    }
+
+    void SetWorkingStandingZeroPoseToRawTrackingPose(
+        const HmdMatrix34_t* pMatStandingZeroPoseToRawTrackingPose ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working.standingZeroPose = *pMatStandingZeroPoseToRawTrackingPose;
+    }
+
+    void ReloadFromDisk( EChaperoneConfigFile ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        state.working = state.live;
+    }
+
+    bool GetLiveSeatedZeroPoseToRawTrackingPose(
+        HmdMatrix34_t* pmatSeatedZeroPoseToRawTrackingPose ) override
+    {
+        STUB_CALL();
+        auto& state = chaperoneState();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        *pmatSeatedZeroPoseToRawTrackingPose = state.live.seatedZeroPose;
+        return true;
+    }
+
+    bool ExportLiveToBuffer( char* pBuffer, uint32_t* pnBufferLength ) override
+    {
+        STUB_CALL();
+        // Nothing to export, the stub has no chaperone file.
+        *pnBufferLength = copyString( "", pBuffer, *pnBufferLength );
+        return true;
+    }
+
+    bool ImportFromBufferToWorking( const char*, uint32_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void ShowWorkingSetPreview() override
+    {
+        STUB_CALL();
+    }
+
+    void HideWorkingSetPreview() override
+    {
+        STUB_CALL();
+    }
+
+    void RoomSetupStarting() override
+    {
+        STUB_CALL();
+    }
+};
+
+vr::IVRChaperone* chaperoneInterface()
+{
+    static StubChaperone instance;
+    return &instance;
+}
+
+vr::IVRChaperoneSetup* chaperoneSetupInterface()
+{
+    static StubChaperoneSetup instance;
+    return &instance;
+}
+
+} // namespace stub
@@ -0,0 +1,352 @@
+#include "stub_runtime.h"
+#include <cmath>
+#include <cstring>
+
+namespace stub
+{
+using namespace vr;
+
+class StubCompositor : public vr::IVRCompositor
+{
+public:
+    static constexpr auto k_interfaceName = "IVRCompositor";
+
+    void SetTrackingSpace( ETrackingUniverseOrigin eOrigin ) override
+    {
+        STUB_CALL();
+        m_trackingSpace = eOrigin;
+    }
+
+    ETrackingUniverseOrigin GetTrackingSpace() override
+    {
+        STUB_CALL();
+        return m_trackingSpace;
+    }
+
+    EVRCompositorError WaitGetPoses( TrackedDevicePose_t*,
+                                     uint32_t,
+                                     TrackedDevicePose_t*,
+                                     uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRCompositorError GetLastPoses( TrackedDevicePose_t*,
+                                     uint32_t,
+                                     TrackedDevicePose_t*,
+                                     uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRCompositorError
+        GetLastPoseForTrackedDeviceIndex( TrackedDeviceIndex_t,
+                                          TrackedDevicePose_t*,
+                                          TrackedDevicePose_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRCompositorError Submit( EVREye,
+                               const Texture_t*,
+                               const VRTextureBounds_t*,
+                               EVRSubmitFlags ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void ClearLastSubmittedFrame() override
+    {
+        STUB_CALL();
+    }
+
+    void PostPresentHandoff() override
+    {
+        STUB_CALL();
+    }
+
+    bool GetFrameTiming( Compositor_FrameTiming* pTiming, uint32_t ) override
+    {
+        STUB_CALL();
+        if ( pTiming->m_nSize != sizeof( Compositor_FrameTiming ) )
+        {
+            return false;
+        }
+        *pTiming = {};
+        pTiming->m_nSize = sizeof( Compositor_FrameTiming );
+        pTiming->m_nNumFramePresents = 1;
+        return true;
+    }
+
+    uint32_t GetFrameTimings( Compositor_FrameTiming*, uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    float GetFrameTimeRemaining() override
+    {
+        STUB_CALL();
+        const auto frameTime = 1.0 / config().displayFrequency;
+        return static_cast<float>( frameTime
+                                   - std::fmod( now(), frameTime ) );
+    }
+
+    void GetCumulativeStats( Compositor_CumulativeStats* pStats,
+                             uint32_t nStatsSizeInBytes ) override
+    {
+        STUB_CALL();
+        std::memset( pStats, 0, nStatsSizeInBytes );
+    }
+
+    void FadeToColor( float, float, float, float, float, bool ) override
+    {
+        STUB_CALL();
+    }
+
+    HmdColor_t GetCurrentFadeColor( bool ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void FadeGrid( float, bool ) override
+    {
+        STUB_CALL();
+    }
+
+    float GetCurrentGridAlpha() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRCompositorError SetSkyboxOverride( const Texture_t*, uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void ClearSkyboxOverride() override
+    {
+        STUB_CALL();
+    }
+
+    void CompositorBringToFront() override
+    {
+        STUB_CALL();
+    }
+
+    void CompositorGoToBack() override
+    {
+        STUB_CALL();
+    }
+
+    void CompositorQuit() override
+    {
+        STUB_CALL();
+    }
+
+    bool IsFullscreen() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    uint32_t GetCurrentSceneFocusProcess() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    uint32_t GetLastFrameRenderer() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool CanRenderScene() override
+    {
+        STUB_CALL();
+        return true;
+    }
+
+    void ShowMirrorWindow() override
+    {
+        STUB_CALL();
+    }
+
+    void HideMirrorWindow() override
+    {
+        STUB_CALL();
+    }
+
+    bool IsMirrorWindowVisible() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void CompositorDumpImages() override
+    {
+        STUB_CALL();
+    }
+
+    bool ShouldAppRenderWithLowResources() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void ForceInterleavedReprojectionOn( bool ) override
+    {
+        STUB_CALL();
+    }
+
+    void ForceReconnectProcess() override
+    {
+        STUB_CALL();
+    }
+
+    void SuspendRendering( bool ) override
+    {
+        STUB_CALL();
+    }
+
+    vr::EVRCompositorError GetMirrorTextureD3D11( vr::EVREye,
+                                                  void*,
+                                                  void** ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void ReleaseMirrorTextureD3D11( void* ) override
+    {
+        STUB_CALL();
+    }
+
+    vr::EVRCompositorError
+        GetMirrorTextureGL( vr::EVREye,
+                            vr::glUInt_t*,
+                            vr::glSharedTextureHandle_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool ReleaseSharedGLTexture( vr::glUInt_t,
+                                 vr::glSharedTextureHandle_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void LockGLSharedTextureForAccess( vr::glSharedTextureHandle_t ) override
+    {
+        STUB_CALL();
+    }
+
+    void UnlockGLSharedTextureForAccess( vr::glSharedTextureHandle_t ) override
+    {
+        STUB_CALL();
+    }
+
+    uint32_t
+        GetVulkanInstanceExtensionsRequired( char* pchValue,
+                                             uint32_t unBufferSize ) override
+    {
+        STUB_CALL();
+        return copyString( "", pchValue, unBufferSize );
+    }
+
+    uint32_t GetVulkanDeviceExtensionsRequired( VkPhysicalDevice_T*,
+                                                char* pchValue,
+                                                uint32_t unBufferSize ) override
+    {
+        STUB_CALL();
+        return copyString( "", pchValue, unBufferSize );
+    }
+
+    void SetExplicitTimingMode( EVRCompositorTimingMode ) override
+    {
+        STUB_CALL();
+    }
+
+    EVRCompositorError SubmitExplicitTimingData() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool IsMotionSmoothingEnabled() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool IsMotionSmoothingSupported() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool IsCurrentSceneFocusAppLoading() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVRCompositorError
+        SetStageOverride_Async( const char*,
+                                const HmdMatrix34_t*,
+                                const Compositor_StageRenderSettings*,
+                                uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void ClearStageOverride() override
+    {
+        STUB_CALL();
+    }
+
+    bool GetCompositorBenchmarkResults( Compositor_BenchmarkResults*,
+                                        uint32_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVRCompositorError GetLastPosePredictionIDs( uint32_t*, uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRCompositorError GetPosesForFrame( uint32_t,
+                                         TrackedDevicePose_t*,
+                                         uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+private:
+    std::atomic<ETrackingUniverseOrigin> m_trackingSpace{
+        TrackingUniverseStanding
+    };
+};
+
+vr::IVRCompositor* compositorInterface()
+{
+    static StubCompositor instance;
+    return &instance;
+}
+
+} // namespace stub
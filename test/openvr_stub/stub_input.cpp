@@ -0,0 +1,318 @@
+#include "stub_runtime.h"
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace stub
+{
+using namespace vr;
+
+class StubInput : public vr::IVRInput
+{
+public:
+    static constexpr auto k_interfaceName = "IVRInput";
+
+    EVRInputError SetActionManifestPath( const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetActionSetHandle( const char* pchActionSetName,
+                                      VRActionSetHandle_t* pHandle ) override
+    {
+        STUB_CALL();
+        *pHandle = handleFor( pchActionSetName );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetActionHandle( const char* pchActionName,
+                                   VRActionHandle_t* pHandle ) override
+    {
+        STUB_CALL();
+        *pHandle = handleFor( pchActionName );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetInputSourceHandle( const char* pchInputSourcePath,
+                                        VRInputValueHandle_t* pHandle ) override
+    {
+        STUB_CALL();
+        *pHandle = handleFor( pchInputSourcePath );
+        return VRInputError_None;
+    }
+
+    EVRInputError UpdateActionState( VRActiveActionSet_t*,
+                                     uint32_t,
+                                     uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetDigitalActionData( VRActionHandle_t,
+                                        InputDigitalActionData_t* pActionData,
+                                        uint32_t unActionDataSize,
+                                        VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        // No buttons are ever pressed.
+        std::memset( pActionData, 0, unActionDataSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetAnalogActionData( VRActionHandle_t,
+                                       InputAnalogActionData_t* pActionData,
+                                       uint32_t unActionDataSize,
+                                       VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        std::memset( pActionData, 0, unActionDataSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError
+        GetPoseActionDataRelativeToNow( VRActionHandle_t,
+                                        ETrackingUniverseOrigin,
+                                        float,
+                                        InputPoseActionData_t* pActionData,
+                                        uint32_t unActionDataSize,
+                                        VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        std::memset( pActionData, 0, unActionDataSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError
+        GetPoseActionDataForNextFrame( VRActionHandle_t,
+                                       ETrackingUniverseOrigin,
+                                       InputPoseActionData_t* pActionData,
+                                       uint32_t unActionDataSize,
+                                       VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        std::memset( pActionData, 0, unActionDataSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetSkeletalActionData( VRActionHandle_t,
+                                         InputSkeletalActionData_t* pActionData,
+                                         uint32_t unActionDataSize ) override
+    {
+        STUB_CALL();
+        std::memset( pActionData, 0, unActionDataSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetDominantHand( ETrackedControllerRole* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError SetDominantHand( ETrackedControllerRole ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetBoneCount( VRActionHandle_t, uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetBoneHierarchy( VRActionHandle_t,
+                                    BoneIndex_t*,
+                                    uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetBoneName( VRActionHandle_t,
+                               BoneIndex_t,
+                               char* pchBoneName,
+                               uint32_t unNameBufferSize ) override
+    {
+        STUB_CALL();
+        copyString( "", pchBoneName, unNameBufferSize );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetSkeletalReferenceTransforms( VRActionHandle_t,
+                                                  EVRSkeletalTransformSpace,
+                                                  EVRSkeletalReferencePose,
+                                                  VRBoneTransform_t*,
+                                                  uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetSkeletalTrackingLevel( VRActionHandle_t,
+                                            EVRSkeletalTrackingLevel* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetSkeletalBoneData( VRActionHandle_t,
+                                       EVRSkeletalTransformSpace,
+                                       EVRSkeletalMotionRange,
+                                       VRBoneTransform_t*,
+                                       uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetSkeletalSummaryData( VRActionHandle_t,
+                                          EVRSummaryType,
+                                          VRSkeletalSummaryData_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetSkeletalBoneDataCompressed( VRActionHandle_t,
+                                                 EVRSkeletalMotionRange,
+                                                 void*,
+                                                 uint32_t,
+                                                 uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError DecompressSkeletalBoneData( const void*,
+                                              uint32_t,
+                                              EVRSkeletalTransformSpace,
+                                              VRBoneTransform_t*,
+                                              uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError TriggerHapticVibrationAction( VRActionHandle_t,
+                                                float,
+                                                float,
+                                                float,
+                                                float,
+                                                VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetActionOrigins( VRActionSetHandle_t,
+                                    VRActionHandle_t,
+                                    VRInputValueHandle_t*,
+                                    uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetOriginLocalizedName( VRInputValueHandle_t,
+                                          char* pchNameArray,
+                                          uint32_t unNameArraySize,
+                                          int32_t ) override
+    {
+        STUB_CALL();
+        copyString( "", pchNameArray, unNameArraySize );
+        return VRInputError_None;
+    }
+
+    EVRInputError GetOriginTrackedDeviceInfo( VRInputValueHandle_t,
+                                              InputOriginInfo_t*,
+                                              uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetActionBindingInfo( VRActionHandle_t,
+                                        InputBindingInfo_t*,
+                                        uint32_t,
+                                        uint32_t,
+                                        uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError ShowActionOrigins( VRActionSetHandle_t,
+                                     VRActionHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError ShowBindingsForActionSet( VRActiveActionSet_t*,
+                                            uint32_t,
+                                            uint32_t,
+                                            VRInputValueHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetComponentStateForBinding(
+        const char*,
+        const char*,
+        const InputBindingInfo_t*,
+        uint32_t,
+        uint32_t,
+        vr::RenderModel_ComponentState_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool IsUsingLegacyInput() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVRInputError OpenBindingUI( const char*,
+                                 VRActionSetHandle_t,
+                                 VRInputValueHandle_t,
+                                 bool ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVRInputError GetBindingVariant( vr::VRInputValueHandle_t,
+                                     char* pchVariantArray,
+                                     uint32_t unVariantArraySize ) override
+    {
+        STUB_CALL();
+        copyString( "", pchVariantArray, unVariantArraySize );
+        return VRInputError_None;
+    }
+
+private:
+    uint64_t handleFor( const char* name )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto handle
+            = m_handles.emplace( name, m_handles.size() + 1 ).first;
+        return handle->second;
+    }
+
+    std::mutex m_mutex;
+    std::map<std::string, uint64_t> m_handles;
+};
+
+vr::IVRInput* inputInterface()
+{
+    static StubInput instance;
+    return &instance;
+}
+
+} // namespace stub
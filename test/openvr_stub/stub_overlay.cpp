@@ -0,0 +1,815 @@
+#include "stub_runtime.h"
+#include <array>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace stub
+{
+using namespace vr;
+
+namespace
+{
+    struct OverlayState
+    {
+        std::string key;
+        std::string name;
+        bool isDashboard = false;
+        bool visible = false;
+        uint32_t flags = 0;
+        std::array<float, 3> color{ 1.0f, 1.0f, 1.0f };
+        float alpha = 1.0f;
+        float widthInMeters = 1.0f;
+        uint32_t sortOrder = 0;
+        VROverlayInputMethod inputMethod = VROverlayInputMethod_None;
+        HmdVector2_t mouseScale{ { 1.0f, 1.0f } };
+        uint32_t pendingMouseMoves = 0;
+    };
+} // namespace
+
+class StubOverlay : public vr::IVROverlay
+{
+public:
+    static constexpr auto k_interfaceName = "IVROverlay";
+
+    EVROverlayError FindOverlay( const char* pchOverlayKey,
+                                 VROverlayHandle_t* pOverlayHandle ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        for ( const auto& [handle, overlay] : m_overlays )
+        {
+            if ( overlay.key == pchOverlayKey )
+            {
+                *pOverlayHandle = handle;
+                return VROverlayError_None;
+            }
+        }
+        *pOverlayHandle = k_ulOverlayHandleInvalid;
+        return VROverlayError_UnknownOverlay;
+    }
+
+    EVROverlayError CreateOverlay( const char* pchOverlayKey,
+                                   const char* pchOverlayName,
+                                   VROverlayHandle_t* pOverlayHandle ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return create( pchOverlayKey, pchOverlayName, false, pOverlayHandle );
+    }
+
+    EVROverlayError DestroyOverlay( VROverlayHandle_t ulOverlayHandle ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_overlays.erase( ulOverlayHandle ) > 0
+                   ? VROverlayError_None
+                   : VROverlayError_InvalidHandle;
+    }
+
+    uint32_t GetOverlayKey( VROverlayHandle_t ulOverlayHandle,
+                            char* pchValue,
+                            uint32_t unBufferSize,
+                            EVROverlayError* pError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto overlay = find( ulOverlayHandle );
+        setError( pError,
+                  overlay ? VROverlayError_None
+                          : VROverlayError_InvalidHandle );
+        return copyString(
+            overlay ? overlay->key : std::string{}, pchValue, unBufferSize );
+    }
+
+    uint32_t GetOverlayName( VROverlayHandle_t ulOverlayHandle,
+                             char* pchValue,
+                             uint32_t unBufferSize,
+                             EVROverlayError* pError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto overlay = find( ulOverlayHandle );
+        setError( pError,
+                  overlay ? VROverlayError_None
+                          : VROverlayError_InvalidHandle );
+        return copyString(
+            overlay ? overlay->name : std::string{}, pchValue, unBufferSize );
+    }
+
+    EVROverlayError SetOverlayName( VROverlayHandle_t ulOverlayHandle,
+                                    const char* pchName ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       [&]( OverlayState& o ) { o.name = pchName; } );
+    }
+
+    EVROverlayError GetOverlayImageData( VROverlayHandle_t,
+                                         void*,
+                                         uint32_t,
+                                         uint32_t*,
+                                         uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    const char* GetOverlayErrorNameFromEnum( EVROverlayError error ) override
+    {
+        STUB_CALL();
+        switch ( error )
+        {
+        case VROverlayError_None:
+            return "VROverlayError_None";
+        case VROverlayError_UnknownOverlay:
+            return "VROverlayError_UnknownOverlay";
+        case VROverlayError_InvalidHandle:
+            return "VROverlayError_InvalidHandle";
+        case VROverlayError_KeyInUse:
+            return "VROverlayError_KeyInUse";
+        default:
+            return "VROverlayError_Stub";
+        }
+    }
+
+    EVROverlayError SetOverlayRenderingPid( VROverlayHandle_t,
+                                            uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    uint32_t GetOverlayRenderingPid( VROverlayHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayFlag( VROverlayHandle_t ulOverlayHandle,
+                                    VROverlayFlags eOverlayFlag,
+                                    bool bEnabled ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            if ( bEnabled )
+            {
+                o.flags |= eOverlayFlag;
+            }
+            else
+            {
+                o.flags &= ~static_cast<uint32_t>( eOverlayFlag );
+            }
+        } );
+    }
+
+    EVROverlayError GetOverlayFlag( VROverlayHandle_t ulOverlayHandle,
+                                    VROverlayFlags eOverlayFlag,
+                                    bool* pbEnabled ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *pbEnabled = ( o.flags & eOverlayFlag ) != 0;
+        } );
+    }
+
+    EVROverlayError GetOverlayFlags( VROverlayHandle_t ulOverlayHandle,
+                                     uint32_t* pFlags ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       [&]( OverlayState& o ) { *pFlags = o.flags; } );
+    }
+
+    EVROverlayError SetOverlayColor( VROverlayHandle_t ulOverlayHandle,
+                                     float fRed,
+                                     float fGreen,
+                                     float fBlue ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            o.color = { fRed, fGreen, fBlue };
+        } );
+    }
+
+    EVROverlayError GetOverlayColor( VROverlayHandle_t ulOverlayHandle,
+                                     float* pfRed,
+                                     float* pfGreen,
+                                     float* pfBlue ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *pfRed = o.color[0];
+            *pfGreen = o.color[1];
+            *pfBlue = o.color[2];
+        } );
+    }
+
+    EVROverlayError SetOverlayAlpha( VROverlayHandle_t ulOverlayHandle,
+                                     float fAlpha ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       [&]( OverlayState& o ) { o.alpha = fAlpha; } );
+    }
+
+    EVROverlayError GetOverlayAlpha( VROverlayHandle_t ulOverlayHandle,
+                                     float* pfAlpha ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       [&]( OverlayState& o ) { *pfAlpha = o.alpha; } );
+    }
+
+    EVROverlayError SetOverlayTexelAspect( VROverlayHandle_t, float ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTexelAspect( VROverlayHandle_t, float* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlaySortOrder( VROverlayHandle_t ulOverlayHandle,
+                                         uint32_t unSortOrder ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       [&]( OverlayState& o ) { o.sortOrder = unSortOrder; } );
+    }
+
+    EVROverlayError GetOverlaySortOrder( VROverlayHandle_t ulOverlayHandle,
+                                         uint32_t* punSortOrder ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *punSortOrder = o.sortOrder;
+        } );
+    }
+
+    EVROverlayError SetOverlayWidthInMeters( VROverlayHandle_t ulOverlayHandle,
+                                             float fWidthInMeters ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            o.widthInMeters = fWidthInMeters;
+        } );
+    }
+
+    EVROverlayError GetOverlayWidthInMeters( VROverlayHandle_t ulOverlayHandle,
+                                             float* pfWidthInMeters ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *pfWidthInMeters = o.widthInMeters;
+        } );
+    }
+
+    EVROverlayError SetOverlayCurvature( VROverlayHandle_t, float ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayCurvature( VROverlayHandle_t, float* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayPreCurvePitch( VROverlayHandle_t, float ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayPreCurvePitch( VROverlayHandle_t,
+                                             float* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayTextureColorSpace( VROverlayHandle_t,
+                                                 EColorSpace ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTextureColorSpace( VROverlayHandle_t,
+                                                 EColorSpace* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayTextureBounds( VROverlayHandle_t,
+                                             const VRTextureBounds_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTextureBounds( VROverlayHandle_t,
+                                             VRTextureBounds_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTransformType( VROverlayHandle_t,
+                                             VROverlayTransformType* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError
+        SetOverlayTransformAbsolute( VROverlayHandle_t ulOverlayHandle,
+                                     ETrackingUniverseOrigin,
+                                     const HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError GetOverlayTransformAbsolute( VROverlayHandle_t,
+                                                 ETrackingUniverseOrigin*,
+                                                 HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayTransformTrackedDeviceRelative(
+        VROverlayHandle_t ulOverlayHandle,
+        TrackedDeviceIndex_t,
+        const HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError
+        GetOverlayTransformTrackedDeviceRelative( VROverlayHandle_t,
+                                                  TrackedDeviceIndex_t*,
+                                                  HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError
+        SetOverlayTransformTrackedDeviceComponent( VROverlayHandle_t,
+                                                   TrackedDeviceIndex_t,
+                                                   const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTransformTrackedDeviceComponent(
+        VROverlayHandle_t ulOverlayHandle,
+        TrackedDeviceIndex_t* punDeviceIndex,
+        char* pchComponentName,
+        uint32_t unComponentNameSize ) override
+    {
+        STUB_CALL();
+        *punDeviceIndex = k_unTrackedDeviceIndexInvalid;
+        copyString( "", pchComponentName, unComponentNameSize );
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError SetOverlayTransformCursor( VROverlayHandle_t,
+                                               const HmdVector2_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    vr::EVROverlayError GetOverlayTransformCursor( VROverlayHandle_t,
+                                                   HmdVector2_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    vr::EVROverlayError
+        SetOverlayTransformProjection( VROverlayHandle_t,
+                                       ETrackingUniverseOrigin,
+                                       const HmdMatrix34_t*,
+                                       const VROverlayProjection_t*,
+                                       vr::EVREye ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError ShowOverlay( VROverlayHandle_t ulOverlayHandle ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       []( OverlayState& o ) { o.visible = true; } );
+    }
+
+    EVROverlayError HideOverlay( VROverlayHandle_t ulOverlayHandle ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle,
+                       []( OverlayState& o ) { o.visible = false; } );
+    }
+
+    bool IsOverlayVisible( VROverlayHandle_t ulOverlayHandle ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto overlay = find( ulOverlayHandle );
+        if ( overlay && overlay->isDashboard )
+        {
+            return config().dashboardVisible;
+        }
+        return overlay && overlay->visible;
+    }
+
+    EVROverlayError GetTransformForOverlayCoordinates( VROverlayHandle_t,
+                                                       ETrackingUniverseOrigin,
+                                                       HmdVector2_t,
+                                                       HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError WaitFrameSync( uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool PollNextOverlayEvent( VROverlayHandle_t ulOverlayHandle,
+                               VREvent_t* pEvent,
+                               uint32_t ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto overlay = find( ulOverlayHandle );
+        if ( !overlay || !overlay->isDashboard )
+        {
+            return false;
+        }
+
+        // Every drain of the queue ends with a false, the next drain sees
+        // a fresh batch of mouse moves.
+        if ( overlay->pendingMouseMoves == 0 )
+        {
+            overlay->pendingMouseMoves = config().mouseMovesPerDrain;
+            return false;
+        }
+        --overlay->pendingMouseMoves;
+
+        ++m_mouseStep;
+        *pEvent = {};
+        pEvent->eventType = VREvent_MouseMove;
+        pEvent->trackedDeviceIndex = 1;
+        pEvent->data.mouse.x = std::fmod( m_mouseStep * 7.0f,
+                                          overlay->mouseScale.v[0] );
+        pEvent->data.mouse.y = std::fmod( m_mouseStep * 3.0f,
+                                          overlay->mouseScale.v[1] );
+        return true;
+    }
+
+    EVROverlayError
+        GetOverlayInputMethod( VROverlayHandle_t ulOverlayHandle,
+                               VROverlayInputMethod* peInputMethod ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *peInputMethod = o.inputMethod;
+        } );
+    }
+
+    EVROverlayError
+        SetOverlayInputMethod( VROverlayHandle_t ulOverlayHandle,
+                               VROverlayInputMethod eInputMethod ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            o.inputMethod = eInputMethod;
+        } );
+    }
+
+    EVROverlayError
+        GetOverlayMouseScale( VROverlayHandle_t ulOverlayHandle,
+                              HmdVector2_t* pvecMouseScale ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            *pvecMouseScale = o.mouseScale;
+        } );
+    }
+
+    EVROverlayError
+        SetOverlayMouseScale( VROverlayHandle_t ulOverlayHandle,
+                              const HmdVector2_t* pvecMouseScale ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, [&]( OverlayState& o ) {
+            o.mouseScale = *pvecMouseScale;
+        } );
+    }
+
+    bool ComputeOverlayIntersection( VROverlayHandle_t,
+                                     const VROverlayIntersectionParams_t*,
+                                     VROverlayIntersectionResults_t* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool IsHoverTargetOverlay( VROverlayHandle_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVROverlayError
+        SetOverlayIntersectionMask( VROverlayHandle_t,
+                                    VROverlayIntersectionMaskPrimitive_t*,
+                                    uint32_t,
+                                    uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError TriggerLaserMouseHapticVibration( VROverlayHandle_t,
+                                                      float,
+                                                      float,
+                                                      float ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayCursor( VROverlayHandle_t,
+                                      VROverlayHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError
+        SetOverlayCursorPositionOverride( VROverlayHandle_t,
+                                          const HmdVector2_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError
+        ClearOverlayCursorPositionOverride( VROverlayHandle_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError SetOverlayTexture( VROverlayHandle_t ulOverlayHandle,
+                                       const Texture_t* ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError
+        ClearOverlayTexture( VROverlayHandle_t ulOverlayHandle ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError SetOverlayRaw( VROverlayHandle_t ulOverlayHandle,
+                                   void*,
+                                   uint32_t,
+                                   uint32_t,
+                                   uint32_t ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError SetOverlayFromFile( VROverlayHandle_t ulOverlayHandle,
+                                        const char* ) override
+    {
+        STUB_CALL();
+        return update( ulOverlayHandle, []( OverlayState& ) {} );
+    }
+
+    EVROverlayError GetOverlayTexture( VROverlayHandle_t,
+                                       void**,
+                                       void*,
+                                       uint32_t*,
+                                       uint32_t*,
+                                       uint32_t*,
+                                       ETextureType*,
+                                       EColorSpace*,
+                                       VRTextureBounds_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError ReleaseNativeOverlayHandle( VROverlayHandle_t,
+                                                void* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetOverlayTextureSize( VROverlayHandle_t,
+                                           uint32_t*,
+                                           uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError
+        CreateDashboardOverlay( const char* pchOverlayKey,
+                                const char* pchOverlayFriendlyName,
+                                VROverlayHandle_t* pMainHandle,
+                                VROverlayHandle_t* pThumbnailHandle ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto error = create(
+            pchOverlayKey, pchOverlayFriendlyName, true, pMainHandle );
+        if ( error != VROverlayError_None )
+        {
+            return error;
+        }
+        return create( std::string( pchOverlayKey ) + ".thumbnail",
+                       pchOverlayFriendlyName,
+                       false,
+                       pThumbnailHandle );
+    }
+
+    bool IsDashboardVisible() override
+    {
+        STUB_CALL();
+        return config().dashboardVisible;
+    }
+
+    bool IsActiveDashboardOverlay( VROverlayHandle_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    EVROverlayError SetDashboardOverlaySceneProcess( VROverlayHandle_t,
+                                                     uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError GetDashboardOverlaySceneProcess( VROverlayHandle_t,
+                                                     uint32_t* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void ShowDashboard( const char* ) override
+    {
+        STUB_CALL();
+    }
+
+    vr::TrackedDeviceIndex_t GetPrimaryDashboardDevice() override
+    {
+        STUB_CALL();
+        return k_unTrackedDeviceIndexInvalid;
+    }
+
+    EVROverlayError ShowKeyboard( EGamepadTextInputMode,
+                                  EGamepadTextInputLineMode,
+                                  uint32_t,
+                                  const char*,
+                                  uint32_t,
+                                  const char*,
+                                  uint64_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    EVROverlayError ShowKeyboardForOverlay( VROverlayHandle_t,
+                                            EGamepadTextInputMode,
+                                            EGamepadTextInputLineMode,
+                                            uint32_t,
+                                            const char*,
+                                            uint32_t,
+                                            const char*,
+                                            uint64_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    uint32_t GetKeyboardText( char* pchText, uint32_t cchText ) override
+    {
+        STUB_CALL();
+        return copyString( "", pchText, cchText );
+    }
+
+    void HideKeyboard() override
+    {
+        STUB_CALL();
+    }
+
+    void SetKeyboardTransformAbsolute( ETrackingUniverseOrigin,
+                                       const HmdMatrix34_t* ) override
+    {
+        STUB_CALL();
+    }
+
+    void SetKeyboardPositionForOverlay( VROverlayHandle_t, HmdRect2_t ) override
+    {
+        STUB_CALL();
+    }
+
+    VRMessageOverlayResponse ShowMessageOverlay( const char*,
+                                                 const char*,
+                                                 const char*,
+                                                 const char*,
+                                                 const char*,
+                                                 const char* ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void CloseMessageOverlay() override
+    {
+        STUB_CALL();
+    }
+
+private:
+    OverlayState* find( const VROverlayHandle_t handle )
+    {
+        const auto overlay = m_overlays.find( handle );
+        return overlay != m_overlays.end() ? &overlay->second : nullptr;
+    }
+
+    EVROverlayError create( const std::string& key,
+                            const std::string& name,
+                            const bool isDashboard,
+                            VROverlayHandle_t* handle )
+    {
+        for ( const auto& existing : m_overlays )
+        {
+            if ( existing.second.key == key )
+            {
+                return VROverlayError_KeyInUse;
+            }
+        }
+        OverlayState overlay;
+        overlay.key = key;
+        overlay.name = name;
+        overlay.isDashboard = isDashboard;
+        overlay.pendingMouseMoves = config().mouseMovesPerDrain;
+        *handle = m_nextHandle++;
+        m_overlays.emplace( *handle, std::move( overlay ) );
+        return VROverlayError_None;
+    }
+
+    // Runs change on the overlay, or reports an invalid handle.
+    template <typename Change>
+    EVROverlayError update( const VROverlayHandle_t handle, Change change )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto overlay = find( handle );
+        if ( !overlay )
+        {
+            return VROverlayError_InvalidHandle;
+        }
+        change( *overlay );
+        return VROverlayError_None;
+    }
+
+    std::mutex m_mutex;
+    std::map<VROverlayHandle_t, OverlayState> m_overlays;
+    VROverlayHandle_t m_nextHandle = 1;
+    uint32_t m_mouseStep = 0;
+};
+
+vr::IVROverlay* overlayInterface()
+{
+    static StubOverlay instance;
+    return &instance;
+}
+
+} // namespace stub
@@ -0,0 +1,560 @@
+#include "stub_runtime.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace stub
+{
+namespace
+{
+    constexpr double k_pi = 3.14159265358979323846;
+
+    const char* environment( const char* name )
+    {
+        const auto value = std::getenv( name );
+        return ( value && *value ) ? value : nullptr;
+    }
+
+    Config loadConfig()
+    {
+        Config c;
+        if ( const auto v = environment( "OVRAS_STUB_LATENCY_US" ) )
+        {
+            c.defaultLatency = std::chrono::microseconds( std::atoll( v ) );
+        }
+        if ( const auto v = environment( "OVRAS_STUB_CALL_LATENCY" ) )
+        {
+            c.callLatencies = v;
+        }
+        if ( const auto v = environment( "OVRAS_STUB_MOTION" ) )
+        {
+            c.motionScript = v;
+        }
+        if ( const auto v = environment( "OVRAS_STUB_TIME_STEP_US" ) )
+        {
+            c.timeStep = std::chrono::microseconds( std::atoll( v ) );
+        }
+        if ( const auto v = environment( "OVRAS_STUB_DISPLAY_HZ" ) )
+        {
+            c.displayFrequency = std::strtof( v, nullptr );
+        }
+        if ( const auto v = environment( "OVRAS_STUB_BOUNDS_QUADS" ) )
+        {
+            c.boundsQuads
+                = std::max( 3u, static_cast<uint32_t>( std::atoi( v ) ) );
+        }
+        if ( const auto v = environment( "OVRAS_STUB_PLAY_AREA" ) )
+        {
+            std::sscanf( v, "%fx%f", &c.playAreaX, &c.playAreaZ );
+        }
+        c.dashboardVisible = environment( "OVRAS_STUB_DASHBOARD_HIDDEN" )
+                             == nullptr;
+        if ( const auto v = environment( "OVRAS_STUB_MOUSE_MOVES" ) )
+        {
+            c.mouseMovesPerDrain = static_cast<uint32_t>( std::atoi( v ) );
+        }
+        if ( const auto v = environment( "OVRAS_STUB_CALL_LOG" ) )
+        {
+            c.callLog = v;
+        }
+        return c;
+    }
+
+    std::chrono::nanoseconds latencyFor( const std::string& interfaceName,
+                                         const std::string& functionName )
+    {
+        // "IVRSystem::PollNextEvent=20,GetTrackingSpace=5"
+        std::istringstream entries( config().callLatencies );
+        std::string entry;
+        auto latency = config().defaultLatency;
+        while ( std::getline( entries, entry, ',' ) )
+        {
+            const auto separator = entry.find( '=' );
+            if ( separator == std::string::npos )
+            {
+                continue;
+            }
+            const auto name = entry.substr( 0, separator );
+            const auto us = std::chrono::microseconds(
+                std::atoll( entry.c_str() + separator + 1 ) );
+            if ( name == interfaceName + "::" + functionName )
+            {
+                // Fully qualified names win over bare function names.
+                return us;
+            }
+            if ( name == functionName )
+            {
+                latency = us;
+            }
+        }
+        return latency;
+    }
+
+    struct CallRegistry
+    {
+        std::mutex mutex;
+        std::vector<CallSite*> sites;
+    };
+
+    CallRegistry& callRegistry()
+    {
+        static CallRegistry registry;
+        return registry;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point g_startTime = Clock::now();
+    std::atomic<int64_t> g_steppedNanoseconds{ 0 };
+
+    MotionModel defaultMotionModel()
+    {
+        MotionModel model{};
+        model[0] = { vr::TrackedDeviceClass_HMD,
+                     vr::TrackedControllerRole_Invalid,
+                     { 0.0f, 1.7f, 0.0f },
+                     { 0.3f, 0.02f, 0.3f },
+                     0.25f,
+                     20.0f };
+        model[1] = { vr::TrackedDeviceClass_Controller,
+                     vr::TrackedControllerRole_LeftHand,
+                     { -0.2f, 1.1f, -0.3f },
+                     { 0.3f, 0.1f, 0.3f },
+                     0.5f,
+                     0.0f };
+        model[2] = { vr::TrackedDeviceClass_Controller,
+                     vr::TrackedControllerRole_RightHand,
+                     { 0.2f, 1.1f, -0.3f },
+                     { 0.3f, 0.1f, 0.3f },
+                     0.5f,
+                     0.0f };
+        return model;
+    }
+
+    vr::ETrackedDeviceClass parseDeviceClass( const std::string& name )
+    {
+        if ( name == "hmd" )
+            return vr::TrackedDeviceClass_HMD;
+        if ( name == "controller" )
+            return vr::TrackedDeviceClass_Controller;
+        if ( name == "tracker" )
+            return vr::TrackedDeviceClass_GenericTracker;
+        if ( name == "reference" )
+            return vr::TrackedDeviceClass_TrackingReference;
+        return vr::TrackedDeviceClass_Invalid;
+    }
+
+    vr::ETrackedControllerRole parseRole( const std::string& name )
+    {
+        if ( name == "left" )
+            return vr::TrackedControllerRole_LeftHand;
+        if ( name == "right" )
+            return vr::TrackedControllerRole_RightHand;
+        return vr::TrackedControllerRole_Invalid;
+    }
+
+    MotionModel loadMotionModel()
+    {
+        if ( config().motionScript.empty() )
+        {
+            return defaultMotionModel();
+        }
+
+        std::ifstream script( config().motionScript );
+        if ( !script )
+        {
+            std::cerr << "openvr stub: could not open motion script '"
+                      << config().motionScript << "', using the default.\n";
+            return defaultMotionModel();
+        }
+
+        MotionModel model{};
+        std::string line;
+        while ( std::getline( script, line ) )
+        {
+            const auto comment = line.find( '#' );
+            if ( comment != std::string::npos )
+            {
+                line.erase( comment );
+            }
+
+            std::istringstream fields( line );
+            uint32_t index = 0;
+            std::string deviceClass;
+            std::string role;
+            DeviceMotion motion;
+            if ( !( fields >> index >> deviceClass >> role ) )
+            {
+                continue;
+            }
+            fields >> motion.base[0] >> motion.base[1] >> motion.base[2]
+                >> motion.amplitude[0] >> motion.amplitude[1]
+                >> motion.amplitude[2] >> motion.frequency
+                >> motion.yawDegreesPerSecond;
+            if ( !fields || index >= vr::k_unMaxTrackedDeviceCount )
+            {
+                std::cerr << "openvr stub: ignoring motion line '" << line
+                          << "'.\n";
+                continue;
+            }
+            motion.deviceClass = parseDeviceClass( deviceClass );
+            motion.role = parseRole( role );
+            model[index] = motion;
+        }
+        return model;
+    }
+} // namespace
+
+const Config& config()
+{
+    static const Config c = loadConfig();
+    return c;
+}
+
+CallSite::CallSite( const char* interfaceName, const char* functionName )
+    : m_name( std::string( interfaceName ) + "::" + functionName ),
+      m_latency( latencyFor( interfaceName, functionName ) )
+{
+    auto& registry = callRegistry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    registry.sites.push_back( this );
+}
+
+void CallSite::spinFor( const std::chrono::nanoseconds duration ) noexcept
+{
+    // Long latencies stand in for a blocking IPC round trip, so they sleep
+    // for most of it instead of taking a CPU away from other threads.
+    constexpr auto spinTail = std::chrono::microseconds( 200 );
+    const auto end = Clock::now() + duration;
+    if ( duration > std::chrono::milliseconds( 1 ) )
+    {
+        std::this_thread::sleep_until( end - spinTail );
+    }
+    while ( Clock::now() < end )
+    {
+    }
+}
+
+uint64_t callCount( const std::string& name )
+{
+    auto& registry = callRegistry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    uint64_t calls = 0;
+    for ( const auto site : registry.sites )
+    {
+        // Bare function names add up the calls of all interfaces.
+        const auto& siteName = site->name();
+        if ( siteName == name
+             || ( siteName.size() > name.size() + 2
+                  && siteName.compare(
+                         siteName.size() - name.size(), name.size(), name )
+                         == 0
+                  && siteName[siteName.size() - name.size() - 1] == ':' ) )
+        {
+            calls += site->calls();
+        }
+    }
+    return calls;
+}
+
+void resetCallCounts()
+{
+    auto& registry = callRegistry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    for ( const auto site : registry.sites )
+    {
+        site->resetCalls();
+    }
+}
+
+bool writeCallCounts( const std::string& filePath )
+{
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    {
+        auto& registry = callRegistry();
+        std::lock_guard<std::mutex> lock( registry.mutex );
+        for ( const auto site : registry.sites )
+        {
+            counts.emplace_back( site->name(), site->calls() );
+        }
+    }
+    std::sort( counts.begin(), counts.end(), []( auto& a, auto& b ) {
+        return a.second > b.second;
+    } );
+
+    std::ofstream file;
+    if ( !filePath.empty() )
+    {
+        file.open( filePath );
+        if ( !file )
+        {
+            return false;
+        }
+    }
+    std::ostream& out = filePath.empty() ? std::cerr : file;
+
+    out << "call,count\n";
+    for ( const auto& [name, calls] : counts )
+    {
+        out << name << ',' << calls << '\n';
+    }
+    return static_cast<bool>( out );
+}
+
+double now()
+{
+    if ( config().timeStep.count() > 0 )
+    {
+        return static_cast<double>( g_steppedNanoseconds.load() ) * 1e-9;
+    }
+    return std::chrono::duration<double>( Clock::now() - g_startTime )
+        .count();
+}
+
+void advanceTime()
+{
+    if ( config().timeStep.count() > 0 )
+    {
+        g_steppedNanoseconds.fetch_add( config().timeStep.count() );
+    }
+}
+
+const MotionModel& motionModel()
+{
+    static const MotionModel model = loadMotionModel();
+    return model;
+}
+
+vr::TrackedDevicePose_t devicePose( const vr::TrackedDeviceIndex_t index,
+                                    const double time )
+{
+    vr::TrackedDevicePose_t pose = {};
+    if ( index >= vr::k_unMaxTrackedDeviceCount )
+    {
+        return pose;
+    }
+    const auto& motion = motionModel()[index];
+    if ( motion.deviceClass == vr::TrackedDeviceClass_Invalid )
+    {
+        return pose;
+    }
+
+    const auto w = 2.0 * k_pi * motion.frequency;
+    const auto yawRate = motion.yawDegreesPerSecond * k_pi / 180.0;
+    const auto yaw = yawRate * time;
+    const auto c = static_cast<float>( std::cos( yaw ) );
+    const auto s = static_cast<float>( std::sin( yaw ) );
+
+    auto& m = pose.mDeviceToAbsoluteTracking.m;
+    m[0][0] = c;
+    m[0][2] = s;
+    m[1][1] = 1.0f;
+    m[2][0] = -s;
+    m[2][2] = c;
+    m[0][3] = motion.base[0]
+              + motion.amplitude[0]
+                    * static_cast<float>( std::sin( w * time ) );
+    m[1][3] = motion.base[1]
+              + motion.amplitude[1]
+                    * static_cast<float>( std::sin( 2.0 * w * time ) );
+    m[2][3] = motion.base[2]
+              + motion.amplitude[2]
+                    * static_cast<float>( std::cos( w * time ) );
+
+    pose.vVelocity.v[0] = static_cast<float>(
+        motion.amplitude[0] * w * std::cos( w * time ) );
+    pose.vVelocity.v[1] = static_cast<float>(
+        motion.amplitude[1] * 2.0 * w * std::cos( 2.0 * w * time ) );
+    pose.vVelocity.v[2] = static_cast<float>(
+        -motion.amplitude[2] * w * std::sin( w * time ) );
+    pose.vAngularVelocity.v[1] = static_cast<float>( yawRate );
+
+    pose.eTrackingResult = vr::TrackingResult_Running_OK;
+    pose.bPoseIsValid = true;
+    pose.bDeviceIsConnected = true;
+    return pose;
+}
+
+uint32_t copyString( const std::string& value,
+                     char* buffer,
+                     const uint32_t bufferSize )
+{
+    const auto required = static_cast<uint32_t>( value.size() + 1 );
+    if ( buffer && bufferSize > 0 )
+    {
+        const auto length = std::min( bufferSize - 1,
+                                      static_cast<uint32_t>( value.size() ) );
+        std::memcpy( buffer, value.data(), length );
+        buffer[length] = '\0';
+    }
+    return required;
+}
+
+} // namespace stub
+
+namespace
+{
+uint32_t g_initToken = 1;
+bool g_initialized = false;
+
+struct InterfaceEntry
+{
+    const char* version;
+    void* ( *get )();
+};
+
+template <typename T, T* ( *F )()> void* erased()
+{
+    return F();
+}
+
+const InterfaceEntry k_interfaces[] = {
+    { vr::IVRSystem_Version, erased<vr::IVRSystem, stub::systemInterface> },
+    { vr::IVRApplications_Version,
+      erased<vr::IVRApplications, stub::applicationsInterface> },
+    { vr::IVRSettings_Version,
+      erased<vr::IVRSettings, stub::settingsInterface> },
+    { vr::IVRChaperone_Version,
+      erased<vr::IVRChaperone, stub::chaperoneInterface> },
+    { vr::IVRChaperoneSetup_Version,
+      erased<vr::IVRChaperoneSetup, stub::chaperoneSetupInterface> },
+    { vr::IVRCompositor_Version,
+      erased<vr::IVRCompositor, stub::compositorInterface> },
+    { vr::IVROverlay_Version, erased<vr::IVROverlay, stub::overlayInterface> },
+    { vr::IVRInput_Version, erased<vr::IVRInput, stub::inputInterface> },
+};
+
+const InterfaceEntry* findInterface( const char* version )
+{
+    if ( !version )
+    {
+        return nullptr;
+    }
+    for ( const auto& entry : k_interfaces )
+    {
+        if ( std::strcmp( entry.version, version ) == 0 )
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+// The entry points are declared inside namespace vr by openvr.h.
+namespace vr
+{
+VR_INTERFACE bool VR_CALLTYPE VR_IsHmdPresent()
+{
+    return true;
+}
+
+VR_INTERFACE bool VR_CALLTYPE VR_IsRuntimeInstalled()
+{
+    return true;
+}
+
+VR_INTERFACE bool VR_GetRuntimePath( char* pchPathBuffer,
+                                     uint32_t unBufferSize,
+                                     uint32_t* punRequiredBufferSize )
+{
+    const auto required
+        = stub::copyString( "openvr_stub", pchPathBuffer, unBufferSize );
+    if ( punRequiredBufferSize )
+    {
+        *punRequiredBufferSize = required;
+    }
+    return required <= unBufferSize;
+}
+
+VR_INTERFACE const char* VR_CALLTYPE
+    VR_GetVRInitErrorAsSymbol( vr::EVRInitError error )
+{
+    return error == vr::VRInitError_None ? "VRInitError_None"
+                                         : "VRInitError_Stub";
+}
+
+VR_INTERFACE const char* VR_CALLTYPE
+    VR_GetVRInitErrorAsEnglishDescription( vr::EVRInitError error )
+{
+    return error == vr::VRInitError_None
+               ? "No Error (0)"
+               : "Interface not provided by the openvr stub";
+}
+
+VR_INTERFACE void* VR_CALLTYPE
+    VR_GetGenericInterface( const char* pchInterfaceVersion,
+                            vr::EVRInitError* peError )
+{
+    const auto entry = findInterface( pchInterfaceVersion );
+    if ( peError )
+    {
+        *peError = !g_initialized ? vr::VRInitError_Init_NotInitialized
+                   : entry        ? vr::VRInitError_None
+                                  : vr::VRInitError_Init_InterfaceNotFound;
+    }
+    return ( g_initialized && entry ) ? entry->get() : nullptr;
+}
+
+VR_INTERFACE bool VR_CALLTYPE
+    VR_IsInterfaceVersionValid( const char* pchInterfaceVersion )
+{
+    return findInterface( pchInterfaceVersion ) != nullptr;
+}
+
+VR_INTERFACE uint32_t VR_CALLTYPE VR_GetInitToken()
+{
+    return g_initToken;
+}
+
+VR_INTERFACE uint32_t VR_CALLTYPE
+    VR_InitInternal2( vr::EVRInitError* peError,
+                      vr::EVRApplicationType /*eApplicationType*/,
+                      const char* /*pStartupInfo*/ )
+{
+    // Reading the config here makes a broken motion script show up at
+    // startup rather than on the first pose query.
+    stub::motionModel();
+    g_initialized = true;
+    ++g_initToken;
+    if ( peError )
+    {
+        *peError = vr::VRInitError_None;
+    }
+    return g_initToken;
+}
+
+VR_INTERFACE void VR_CALLTYPE VR_ShutdownInternal()
+{
+    if ( !g_initialized )
+    {
+        return;
+    }
+    g_initialized = false;
+    ++g_initToken;
+    stub::writeCallCounts( stub::config().callLog );
+}
+} // namespace vr
+
+VR_INTERFACE uint64_t OvrasStub_GetCallCount( const char* name )
+{
+    return name ? stub::callCount( name ) : 0;
+}
+
+VR_INTERFACE void OvrasStub_ResetCallCounts()
+{
+    stub::resetCallCounts();
+}
+
+VR_INTERFACE bool OvrasStub_WriteCallCounts( const char* filePath )
+{
+    return stub::writeCallCounts( filePath ? filePath : "" );
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <openvr.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/*
+ * Stand-in for libopenvr_api that lets AdvancedSettings run without SteamVR.
+ *
+ * The library implements the interfaces the application uses (IVRSystem,
+ * IVRApplications, IVRSettings, IVRChaperone, IVRChaperoneSetup,
+ * IVRCompositor, IVROverlay and IVRInput) with in-process state. Put the
+ * directory containing the built libopenvr_api.so in front of
+ * LD_LIBRARY_PATH to use it instead of the real runtime.
+ *
+ * Behaviour is configured through environment variables:
+ *
+ *     OVRAS_STUB_LATENCY_US        Latency added to every call, in
+ *                                  microseconds. Busy waits so that short
+ *                                  latencies are reproduced accurately,
+ *                                  latencies over 1 ms sleep for all but
+ *                                  the last 200 us.
+ *     OVRAS_STUB_CALL_LATENCY      Per call overrides, comma separated
+ *                                  "Function=us" or "IVRxxx::Function=us".
+ *     OVRAS_STUB_MOTION            Motion script, see MotionModel.
+ *     OVRAS_STUB_TIME_STEP_US      If set, time advances by this amount on
+ *                                  every GetDeviceToAbsoluteTrackingPose
+ *                                  call instead of following the wall clock.
+ *                                  Makes runs deterministic.
+ *     OVRAS_STUB_DISPLAY_HZ        Reported display frequency, default 90.
+ *     OVRAS_STUB_BOUNDS_QUADS      Number of chaperone wall quads, default
+ *                                  4 (a rectangle). Other values produce a
+ *                                  regular polygon.
+ *     OVRAS_STUB_PLAY_AREA         Play area size "XxZ" in meters, default
+ *                                  "3x2.5".
+ *     OVRAS_STUB_DASHBOARD_HIDDEN  If set, IsDashboardVisible() is false.
+ *     OVRAS_STUB_MOUSE_MOVES       Number of MouseMove events delivered to
+ *                                  the dashboard overlay per event drain.
+ *     OVRAS_STUB_CALL_LOG          File the call counts are written to on
+ *                                  VR_Shutdown, default stderr.
+ */
+namespace stub
+{
+struct Config
+{
+    std::chrono::nanoseconds defaultLatency{ 0 };
+    std::string callLatencies;
+    std::string motionScript;
+    std::chrono::nanoseconds timeStep{ 0 };
+    float displayFrequency = 90.0f;
+    uint32_t boundsQuads = 4;
+    float playAreaX = 3.0f;
+    float playAreaZ = 2.5f;
+    bool dashboardVisible = true;
+    uint32_t mouseMovesPerDrain = 0;
+    std::string callLog;
+};
+
+const Config& config();
+
+/*!
+One instrumented stub function. Counts calls and applies the configured
+latency. Instances are function local statics created by STUB_CALL(), so
+every function registers itself on its first call.
+*/
+class CallSite
+{
+public:
+    CallSite( const char* interfaceName, const char* functionName );
+
+    void enter() noexcept
+    {
+        m_calls.fetch_add( 1, std::memory_order_relaxed );
+        if ( m_latency.count() > 0 )
+        {
+            spinFor( m_latency );
+        }
+    }
+
+    [[nodiscard]] const std::string& name() const noexcept
+    {
+        return m_name;
+    }
+    [[nodiscard]] uint64_t calls() const noexcept
+    {
+        return m_calls.load( std::memory_order_relaxed );
+    }
+    void resetCalls() noexcept
+    {
+        m_calls.store( 0, std::memory_order_relaxed );
+    }
+
+private:
+    static void spinFor( const std::chrono::nanoseconds duration ) noexcept;
+
+    std::string m_name;
+    std::chrono::nanoseconds m_latency{ 0 };
+    std::atomic<uint64_t> m_calls{ 0 };
+};
+
+// Every stub class declares a static k_interfaceName.
+#define STUB_CALL()                                                            \
+    static ::stub::CallSite s_callSite( k_interfaceName, __func__ );           \
+    s_callSite.enter()
+
+uint64_t callCount( const std::string& name );
+void resetCallCounts();
+bool writeCallCounts( const std::string& filePath );
+
+/*
+ * Time as seen by the stub, in seconds since VR_Init. Follows the wall clock
+ * unless OVRAS_STUB_TIME_STEP_US is set.
+ */
+double now();
+void advanceTime();
+
+/*!
+Scripted motion of the tracked devices.
+
+Each non comment line of the script describes one device:
+
+    # index class      role  x    y    z     ax   ay   az   hz   yaw_deg_s
+    0       hmd        none  0    1.7  0     0.3  0.02 0.3  0.25 20
+    1       controller left  -0.2 1.1  -0.3  0.3  0.1  0.3  0.5  0
+
+class is hmd, controller, tracker or reference, role is none, left or right.
+The device moves on
+
+    x = x0 + ax * sin( w t )
+    y = y0 + ay * sin( 2 w t )
+    z = z0 + az * cos( w t )
+
+with w = 2 pi hz, and turns around the y axis at yaw_deg_s. The default
+script contains the HMD and two controllers.
+*/
+struct DeviceMotion
+{
+    vr::ETrackedDeviceClass deviceClass = vr::TrackedDeviceClass_Invalid;
+    vr::ETrackedControllerRole role = vr::TrackedControllerRole_Invalid;
+    std::array<float, 3> base{};
+    std::array<float, 3> amplitude{};
+    float frequency = 0.0f;
+    float yawDegreesPerSecond = 0.0f;
+};
+
+using MotionModel
+    = std::array<DeviceMotion, vr::k_unMaxTrackedDeviceCount>;
+
+const MotionModel& motionModel();
+vr::TrackedDevicePose_t devicePose( const vr::TrackedDeviceIndex_t index,
+                                    const double time );
+
+vr::IVRSystem* systemInterface();
+vr::IVRApplications* applicationsInterface();
+vr::IVRSettings* settingsInterface();
+vr::IVRChaperone* chaperoneInterface();
+vr::IVRChaperoneSetup* chaperoneSetupInterface();
+vr::IVRCompositor* compositorInterface();
+vr::IVROverlay* overlayInterface();
+vr::IVRInput* inputInterface();
+
+template <typename Error> void setError( Error* error, const Error value )
+{
+    if ( error )
+    {
+        *error = value;
+    }
+}
+
+// Copies a string into a runtime style output buffer and returns the
+// required size including the terminator.
+uint32_t copyString( const std::string& value,
+                     char* buffer,
+                     const uint32_t bufferSize );
+
+} // namespace stub
+
+// Exported for benchmark drivers that link the stub directly.
+VR_INTERFACE uint64_t OvrasStub_GetCallCount( const char* name );
+VR_INTERFACE void OvrasStub_ResetCallCounts();
+VR_INTERFACE bool OvrasStub_WriteCallCounts( const char* filePath );
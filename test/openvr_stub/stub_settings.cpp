@@ -0,0 +1,173 @@
+#include "stub_runtime.h"
+#include <map>
+#include <mutex>
+
+namespace stub
+{
+using namespace vr;
+
+namespace
+{
+    // Settings are kept per key in every type, the way they are read back
+    // depends on the getter used.
+    struct SettingValue
+    {
+        bool b = false;
+        int32_t i = 0;
+        float f = 0.0f;
+        std::string s;
+    };
+
+    std::string key( const char* section, const char* settingsKey )
+    {
+        return std::string( section ) + '/' + settingsKey;
+    }
+} // namespace
+
+class StubSettings : public vr::IVRSettings
+{
+public:
+    static constexpr auto k_interfaceName = "IVRSettings";
+
+    const char* GetSettingsErrorNameFromEnum( EVRSettingsError eError ) override
+    {
+        STUB_CALL();
+        return eError == VRSettingsError_None ? "VRSettingsError_None"
+                                              : "VRSettingsError_Stub";
+    }
+
+    void SetBool( const char* pchSection,
+                  const char* pchSettingsKey,
+                  bool bValue,
+                  EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_values[key( pchSection, pchSettingsKey )].b = bValue;
+        setError( peError, VRSettingsError_None );
+    }
+
+    void SetInt32( const char* pchSection,
+                   const char* pchSettingsKey,
+                   int32_t nValue,
+                   EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_values[key( pchSection, pchSettingsKey )].i = nValue;
+        setError( peError, VRSettingsError_None );
+    }
+
+    void SetFloat( const char* pchSection,
+                   const char* pchSettingsKey,
+                   float flValue,
+                   EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_values[key( pchSection, pchSettingsKey )].f = flValue;
+        setError( peError, VRSettingsError_None );
+    }
+
+    void SetString( const char* pchSection,
+                    const char* pchSettingsKey,
+                    const char* pchValue,
+                    EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_values[key( pchSection, pchSettingsKey )].s = pchValue;
+        setError( peError, VRSettingsError_None );
+    }
+
+    bool GetBool( const char* pchSection,
+                  const char* pchSettingsKey,
+                  EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        setError( peError, VRSettingsError_None );
+        // Unset keys read as zero, like a settings file full of defaults.
+        const auto value = m_values.find( key( pchSection, pchSettingsKey ) );
+        return value != m_values.end() ? value->second.b : bool{};
+    }
+
+    int32_t GetInt32( const char* pchSection,
+                      const char* pchSettingsKey,
+                      EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        setError( peError, VRSettingsError_None );
+        // Unset keys read as zero, like a settings file full of defaults.
+        const auto value = m_values.find( key( pchSection, pchSettingsKey ) );
+        return value != m_values.end() ? value->second.i : int32_t{};
+    }
+
+    float GetFloat( const char* pchSection,
+                    const char* pchSettingsKey,
+                    EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        setError( peError, VRSettingsError_None );
+        // Unset keys read as zero, like a settings file full of defaults.
+        const auto value = m_values.find( key( pchSection, pchSettingsKey ) );
+        return value != m_values.end() ? value->second.f : float{};
+    }
+
+    void GetString( const char* pchSection,
+                    const char* pchSettingsKey,
+                    char* pchValue,
+                    uint32_t unValueLen,
+                    EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto value = m_values.find( key( pchSection, pchSettingsKey ) );
+        const auto required = copyString(
+            value != m_values.end() ? value->second.s : std::string{},
+            pchValue,
+            unValueLen );
+        setError( peError,
+                  required > unValueLen ? VRSettingsError_ReadFailed
+                                        : VRSettingsError_None );
+    }
+
+    void RemoveSection( const char* pchSection,
+                        EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        const auto prefix = key( pchSection, "" );
+        auto it = m_values.lower_bound( prefix );
+        while ( it != m_values.end()
+                && it->first.compare( 0, prefix.size(), prefix ) == 0 )
+        {
+            it = m_values.erase( it );
+        }
+        setError( peError, VRSettingsError_None );
+    }
+
+    void RemoveKeyInSection( const char* pchSection,
+                             const char* pchSettingsKey,
+                             EVRSettingsError* peError ) override
+    {
+        STUB_CALL();
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_values.erase( key( pchSection, pchSettingsKey ) );
+        setError( peError, VRSettingsError_None );
+    }
+
+private:
+    std::mutex m_mutex;
+    std::map<std::string, SettingValue> m_values;
+};
+
+vr::IVRSettings* settingsInterface()
+{
+    static StubSettings instance;
+    return &instance;
+}
+
+} // namespace stub
@@ -0,0 +1,506 @@
+#include "stub_runtime.h"
+#include <cmath>
+
+namespace stub
+{
+using namespace vr;
+
+namespace
+{
+    HmdMatrix34_t identity()
+    {
+        HmdMatrix34_t matrix = {};
+        matrix.m[0][0] = 1.0f;
+        matrix.m[1][1] = 1.0f;
+        matrix.m[2][2] = 1.0f;
+        return matrix;
+    }
+
+    bool isValid( const TrackedDeviceIndex_t index )
+    {
+        return index < k_unMaxTrackedDeviceCount;
+    }
+
+    bool isConnected( const TrackedDeviceIndex_t index )
+    {
+        return isValid( index )
+               && motionModel()[index].deviceClass
+                      != TrackedDeviceClass_Invalid;
+    }
+
+    bool isController( const TrackedDeviceIndex_t index )
+    {
+        return isValid( index )
+               && motionModel()[index].deviceClass
+                      == TrackedDeviceClass_Controller;
+    }
+
+    ETrackedPropertyError propertyMissing( const TrackedDeviceIndex_t index )
+    {
+        if ( !isValid( index ) )
+        {
+            return TrackedProp_InvalidDevice;
+        }
+        if ( !isConnected( index ) )
+        {
+            return TrackedProp_WrongDeviceClass;
+        }
+        return TrackedProp_UnknownProperty;
+    }
+} // namespace
+
+class StubSystem : public vr::IVRSystem
+{
+public:
+    static constexpr auto k_interfaceName = "IVRSystem";
+
+    void GetRecommendedRenderTargetSize( uint32_t* pnWidth,
+                                         uint32_t* pnHeight ) override
+    {
+        STUB_CALL();
+        *pnWidth = 2016;
+        *pnHeight = 2240;
+    }
+
+    HmdMatrix44_t GetProjectionMatrix( EVREye, float, float ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void GetProjectionRaw( EVREye, float*, float*, float*, float* ) override
+    {
+        STUB_CALL();
+    }
+
+    bool ComputeDistortion( EVREye,
+                            float,
+                            float,
+                            DistortionCoordinates_t* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    HmdMatrix34_t GetEyeToHeadTransform( EVREye ) override
+    {
+        STUB_CALL();
+        return identity();
+    }
+
+    bool GetTimeSinceLastVsync( float* pfSecondsSinceLastVsync,
+                                uint64_t* pulFrameCounter ) override
+    {
+        STUB_CALL();
+        // Vsync always follows the wall clock, the tick thread sleeps on it.
+        const auto seconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - m_start )
+                                 .count();
+        const auto frame = seconds * config().displayFrequency;
+        *pfSecondsSinceLastVsync = static_cast<float>(
+            ( frame - std::floor( frame ) ) / config().displayFrequency );
+        *pulFrameCounter = static_cast<uint64_t>( frame );
+        return true;
+    }
+
+    int32_t GetD3D9AdapterIndex() override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void GetDXGIOutputInfo( int32_t* ) override
+    {
+        STUB_CALL();
+    }
+
+    void GetOutputDevice( uint64_t*, ETextureType, VkInstance_T* ) override
+    {
+        STUB_CALL();
+    }
+
+    bool IsDisplayOnDesktop() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool SetDisplayVisibility( bool ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void GetDeviceToAbsoluteTrackingPose(
+        ETrackingUniverseOrigin,
+        float fPredictedSecondsToPhotonsFromNow,
+        TrackedDevicePose_t* pTrackedDevicePoseArray,
+        uint32_t unTrackedDevicePoseArrayCount ) override
+    {
+        STUB_CALL();
+        advanceTime();
+        // Standing, seated and raw space are the same in the stub.
+        const auto time = now() + fPredictedSecondsToPhotonsFromNow;
+        for ( uint32_t i = 0; i < unTrackedDevicePoseArrayCount; ++i )
+        {
+            pTrackedDevicePoseArray[i] = devicePose( i, time );
+        }
+    }
+
+    HmdMatrix34_t GetSeatedZeroPoseToStandingAbsoluteTrackingPose() override
+    {
+        STUB_CALL();
+        return identity();
+    }
+
+    HmdMatrix34_t GetRawZeroPoseToStandingAbsoluteTrackingPose() override
+    {
+        STUB_CALL();
+        return identity();
+    }
+
+    uint32_t GetSortedTrackedDeviceIndicesOfClass(
+        ETrackedDeviceClass eTrackedDeviceClass,
+        vr::TrackedDeviceIndex_t* punTrackedDeviceIndexArray,
+        uint32_t unTrackedDeviceIndexArrayCount,
+        vr::TrackedDeviceIndex_t ) override
+    {
+        STUB_CALL();
+        uint32_t count = 0;
+        for ( uint32_t i = 0; i < k_unMaxTrackedDeviceCount; ++i )
+        {
+            if ( motionModel()[i].deviceClass != eTrackedDeviceClass )
+            {
+                continue;
+            }
+            if ( punTrackedDeviceIndexArray
+                 && count < unTrackedDeviceIndexArrayCount )
+            {
+                punTrackedDeviceIndexArray[count] = i;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    EDeviceActivityLevel
+        GetTrackedDeviceActivityLevel( vr::TrackedDeviceIndex_t ) override
+    {
+        STUB_CALL();
+        return k_EDeviceActivityLevel_UserInteraction;
+    }
+
+    void ApplyTransform( TrackedDevicePose_t* pOutputPose,
+                         const TrackedDevicePose_t* pTrackedDevicePose,
+                         const HmdMatrix34_t* pTransform ) override
+    {
+        STUB_CALL();
+        const auto& a = pTransform->m;
+        const auto& b = pTrackedDevicePose->mDeviceToAbsoluteTracking.m;
+        HmdMatrix34_t result = {};
+        for ( int row = 0; row < 3; ++row )
+        {
+            for ( int column = 0; column < 4; ++column )
+            {
+                result.m[row][column] = a[row][0] * b[0][column]
+                                        + a[row][1] * b[1][column]
+                                        + a[row][2] * b[2][column]
+                                        + ( column == 3 ? a[row][3] : 0.0f );
+            }
+        }
+        *pOutputPose = *pTrackedDevicePose;
+        pOutputPose->mDeviceToAbsoluteTracking = result;
+    }
+
+    vr::TrackedDeviceIndex_t GetTrackedDeviceIndexForControllerRole(
+        vr::ETrackedControllerRole unDeviceType ) override
+    {
+        STUB_CALL();
+        for ( uint32_t i = 0; i < k_unMaxTrackedDeviceCount; ++i )
+        {
+            if ( motionModel()[i].role == unDeviceType )
+            {
+                return i;
+            }
+        }
+        return k_unTrackedDeviceIndexInvalid;
+    }
+
+    vr::ETrackedControllerRole GetControllerRoleForTrackedDeviceIndex(
+        vr::TrackedDeviceIndex_t unDeviceIndex ) override
+    {
+        STUB_CALL();
+        return isValid( unDeviceIndex ) ? motionModel()[unDeviceIndex].role
+                                        : TrackedControllerRole_Invalid;
+    }
+
+    ETrackedDeviceClass
+        GetTrackedDeviceClass( vr::TrackedDeviceIndex_t unDeviceIndex ) override
+    {
+        STUB_CALL();
+        return isValid( unDeviceIndex )
+                   ? motionModel()[unDeviceIndex].deviceClass
+                   : TrackedDeviceClass_Invalid;
+    }
+
+    bool IsTrackedDeviceConnected(
+        vr::TrackedDeviceIndex_t unDeviceIndex ) override
+    {
+        STUB_CALL();
+        return isConnected( unDeviceIndex );
+    }
+
+    bool GetBoolTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                       ETrackedDeviceProperty prop,
+                                       ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        if ( prop == Prop_DeviceProvidesBatteryStatus_Bool
+             && isController( unDeviceIndex ) )
+        {
+            setError( pError, TrackedProp_Success );
+            return true;
+        }
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return false;
+    }
+
+    float
+        GetFloatTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                       ETrackedDeviceProperty prop,
+                                       ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        if ( prop == Prop_DisplayFrequency_Float
+             && unDeviceIndex == k_unTrackedDeviceIndex_Hmd )
+        {
+            setError( pError, TrackedProp_Success );
+            return config().displayFrequency;
+        }
+        if ( prop == Prop_DeviceBatteryPercentage_Float
+             && isController( unDeviceIndex ) )
+        {
+            setError( pError, TrackedProp_Success );
+            return 0.8f;
+        }
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return 0.0f;
+    }
+
+    int32_t
+        GetInt32TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                       ETrackedDeviceProperty prop,
+                                       ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        if ( prop == Prop_ControllerRoleHint_Int32
+             && isConnected( unDeviceIndex ) )
+        {
+            setError( pError, TrackedProp_Success );
+            return motionModel()[unDeviceIndex].role;
+        }
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return 0;
+    }
+
+    uint64_t
+        GetUint64TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                        ETrackedDeviceProperty,
+                                        ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return 0;
+    }
+
+    HmdMatrix34_t GetMatrix34TrackedDeviceProperty(
+        vr::TrackedDeviceIndex_t unDeviceIndex,
+        ETrackedDeviceProperty,
+        ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return {};
+    }
+
+    uint32_t
+        GetArrayTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                       ETrackedDeviceProperty,
+                                       PropertyTypeTag_t,
+                                       void*,
+                                       uint32_t,
+                                       ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        setError( pError, propertyMissing( unDeviceIndex ) );
+        return 0;
+    }
+
+    uint32_t
+        GetStringTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex,
+                                        ETrackedDeviceProperty prop,
+                                        char* pchValue,
+                                        uint32_t unBufferSize,
+                                        ETrackedPropertyError* pError ) override
+    {
+        STUB_CALL();
+        if ( !isConnected( unDeviceIndex ) )
+        {
+            setError( pError, propertyMissing( unDeviceIndex ) );
+            return 0;
+        }
+
+        std::string value;
+        switch ( prop )
+        {
+        case Prop_SerialNumber_String:
+            value = "STUB-" + std::to_string( unDeviceIndex );
+            break;
+        case Prop_ControllerType_String:
+        case Prop_RenderModelName_String:
+            value = "openvr_stub";
+            break;
+        default:
+            setError( pError, TrackedProp_UnknownProperty );
+            return 0;
+        }
+
+        const auto required = copyString( value, pchValue, unBufferSize );
+        setError( pError,
+                  required > unBufferSize ? TrackedProp_BufferTooSmall
+                                          : TrackedProp_Success );
+        return required;
+    }
+
+    const char* GetPropErrorNameFromEnum( ETrackedPropertyError error ) override
+    {
+        STUB_CALL();
+        return error == TrackedProp_Success ? "TrackedProp_Success"
+                                            : "TrackedProp_Error";
+    }
+
+    bool PollNextEvent( VREvent_t*, uint32_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool PollNextEventWithPose( ETrackingUniverseOrigin,
+                                VREvent_t*,
+                                uint32_t,
+                                vr::TrackedDevicePose_t* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    const char* GetEventTypeNameFromEnum( EVREventType ) override
+    {
+        STUB_CALL();
+        return "VREvent";
+    }
+
+    HiddenAreaMesh_t GetHiddenAreaMesh( EVREye, EHiddenAreaMeshType ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    bool GetControllerState( vr::TrackedDeviceIndex_t,
+                             vr::VRControllerState_t*,
+                             uint32_t ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool GetControllerStateWithPose( ETrackingUniverseOrigin,
+                                     vr::TrackedDeviceIndex_t,
+                                     vr::VRControllerState_t*,
+                                     uint32_t,
+                                     TrackedDevicePose_t* ) override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    void TriggerHapticPulse( vr::TrackedDeviceIndex_t,
+                             uint32_t,
+                             unsigned short ) override
+    {
+        STUB_CALL();
+    }
+
+    const char* GetButtonIdNameFromEnum( EVRButtonId ) override
+    {
+        STUB_CALL();
+        return "";
+    }
+
+    const char*
+        GetControllerAxisTypeNameFromEnum( EVRControllerAxisType ) override
+    {
+        STUB_CALL();
+        return "";
+    }
+
+    bool IsInputAvailable() override
+    {
+        STUB_CALL();
+        return true;
+    }
+
+    bool IsSteamVRDrawingControllers() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool ShouldApplicationPause() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    bool ShouldApplicationReduceRenderingWork() override
+    {
+        STUB_CALL();
+        return false;
+    }
+
+    vr::EVRFirmwareError
+        PerformFirmwareUpdate( vr::TrackedDeviceIndex_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    void AcknowledgeQuit_Exiting() override
+    {
+        STUB_CALL();
+    }
+
+    uint32_t GetAppContainerFilePaths( char*, uint32_t ) override
+    {
+        STUB_CALL();
+        return {};
+    }
+
+    const char* GetRuntimeVersion() override
+    {
+        STUB_CALL();
+        return "openvr_stub";
+    }
+
+private:
+    const std::chrono::steady_clock::time_point m_start
+        = std::chrono::steady_clock::now();
+};
+
+IVRSystem* systemInterface()
+{
+    static StubSystem instance;
+    return &instance;
+}
+
+} // namespace stub
@@ -0,0 +1,254 @@
+#include <openvr.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "tick_recording.h"
+#include "../../src/openvr/ovr_recorded_queries.h"
+#include "../openvr_stub/stub_runtime.h"
+#include <easylogging++.h>
+
+INITIALIZE_EASYLOGGINGPP
+
+/* Record -> replay round trip of utils::TickRecording against the OpenVR
+ * stub.
+ *
+ * k_ticks ticks are recorded the way mainEventLoop makes them: the tick
+ * poses, the dashboard overlay's events and a set of runtime queries through
+ * ovr_recorded_queries. While recording a setting is toggled every few ticks
+ * so the answers change over the run. Every answer of a tick is appended to
+ * a byte string.
+ *
+ * Afterwards the runtime state is changed so a live query would answer
+ * differently, the stub's call counts are reset and the recording is
+ * replayed. The replay has to produce the same byte string for every tick,
+ * the same number of ticks and must not call the runtime at all.
+ */
+namespace
+{
+constexpr int k_ticks = 200;
+constexpr uint32_t k_devices = 4;
+const auto k_toggleSection = vr::k_pch_SteamVR_Section;
+const auto k_toggleKey = vr::k_pch_SteamVR_DoNotFadeToGrid;
+
+template <typename T> void append( std::string& answers, const T& value )
+{
+    answers.append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+void append( std::string& answers, const std::string& value )
+{
+    append( answers, value.size() );
+    answers += value;
+}
+
+template <typename T>
+void append( std::string& answers, const std::vector<T>& value )
+{
+    append( answers, value.size() );
+    answers.append( reinterpret_cast<const char*>( value.data() ),
+                    value.size() * sizeof( T ) );
+}
+
+// One tick as mainEventLoop would make it, returns everything it saw.
+std::string runTick( const vr::VROverlayHandle_t dashboard )
+{
+    namespace q = ovr_recorded_queries;
+    auto& recording = utils::tickRecording;
+    std::string answers;
+
+    const auto universe = recording.isReplaying() ? recording.replayUniverse()
+                                                  : q::trackingSpace();
+    append( answers, universe );
+    vr::TrackedDevicePose_t poses[vr::k_unMaxTrackedDeviceCount] = {};
+    if ( recording.isReplaying() )
+    {
+        recording.replayPoses( poses );
+    }
+    else
+    {
+        const auto live = q::devicePoses( universe );
+        std::copy( live.begin(), live.end(), poses );
+        recording.recordPoses( universe, poses );
+    }
+    for ( uint32_t i = 0; i < k_devices; ++i )
+    {
+        if ( poses[i].bDeviceIsConnected )
+        {
+            append( answers, poses[i] );
+        }
+    }
+
+    vr::VREvent_t event{};
+    while ( recording.pollEvent(
+        utils::EventQueue::Overlay,
+        event,
+        [dashboard]( vr::VREvent_t& e ) {
+            return vr::VROverlay()->PollNextOverlayEvent(
+                dashboard, &e, sizeof( e ) );
+        } ) )
+    {
+        append( answers, event.eventType );
+        append( answers, event.data.mouse );
+    }
+
+    append( answers, q::dashboardVisible() );
+    for ( uint32_t i = 0; i < k_devices; ++i )
+    {
+        append( answers, q::deviceConnected( i ) );
+        append( answers, q::deviceClass( i ) );
+        append( answers, q::deviceActivityLevel( i ) );
+    }
+    const auto left
+        = q::indexForControllerRole( vr::TrackedControllerRole_LeftHand );
+    append( answers, left );
+    append( answers, q::controllerState( left ) );
+    vr::ETrackedPropertyError propertyError = vr::TrackedProp_Success;
+    append( answers,
+            q::stringProperty( vr::k_unTrackedDeviceIndex_Hmd,
+                               vr::Prop_TrackingSystemName_String,
+                               &propertyError ) );
+    append( answers, propertyError );
+    append( answers,
+            q::floatProperty( vr::k_unTrackedDeviceIndex_Hmd,
+                              vr::Prop_DisplayFrequency_Float ) );
+
+    vr::EVRSettingsError settingError = vr::VRSettingsError_None;
+    append( answers, q::settingBool( k_toggleSection, k_toggleKey ) );
+    append( answers,
+            q::settingFloat( vr::k_pch_SteamVR_Section,
+                             vr::k_pch_SteamVR_SupersampleScale_Float,
+                             &settingError ) );
+    append( answers, settingError );
+    append( answers,
+            q::settingString( vr::k_pch_SteamVR_Section,
+                              vr::k_pch_SteamVR_RequireHmd_String,
+                              &settingError ) );
+    append( answers, settingError );
+
+    append( answers, q::calibrationState() );
+    append( answers, q::workingStandingZeroPose() );
+    append( answers, q::workingCollisionBounds() );
+    append( answers, q::liveCollisionBounds() );
+    return answers;
+}
+
+uint64_t totalRuntimeCalls( const std::string& countsPath )
+{
+    if ( !OvrasStub_WriteCallCounts( countsPath.c_str() ) )
+    {
+        return ~0ull;
+    }
+    std::ifstream file( countsPath );
+    std::string line;
+    std::getline( file, line ); // header
+    uint64_t total = 0;
+    while ( std::getline( file, line ) )
+    {
+        const auto comma = line.rfind( ',' );
+        total += std::strtoull( line.c_str() + comma + 1, nullptr, 10 );
+    }
+    return total;
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const std::string recordingPath
+        = argc > 1 ? argv[1] : "tick_recording_test.ovrasrec";
+    const std::string countsPath = recordingPath + ".calls.csv";
+
+    // Deterministic stub: time steps per pose query, a few mouse moves per
+    // event drain. The call counts go to a file instead of stderr.
+    setenv( "OVRAS_STUB_TIME_STEP_US", "11111", 0 );
+    setenv( "OVRAS_STUB_MOUSE_MOVES", "3", 0 );
+    setenv( "OVRAS_STUB_CALL_LOG", countsPath.c_str(), 1 );
+
+    auto initError = vr::VRInitError_None;
+    vr::VR_Init( &initError, vr::VRApplication_Overlay );
+    if ( initError != vr::VRInitError_None )
+    {
+        std::fprintf( stderr, "VR_Init failed: %d\n", initError );
+        return 1;
+    }
+    vr::VROverlayHandle_t dashboard = vr::k_ulOverlayHandleInvalid;
+    vr::VROverlayHandle_t thumbnail = vr::k_ulOverlayHandleInvalid;
+    vr::VROverlay()->CreateDashboardOverlay(
+        "tick_recording_test", "Tick recording", &dashboard, &thumbnail );
+
+    std::vector<std::string> recorded;
+    if ( !utils::tickRecording.startRecording( recordingPath ) )
+    {
+        return 1;
+    }
+    for ( int tick = 0; tick < k_ticks; ++tick )
+    {
+        if ( tick % 16 == 0 )
+        {
+            vr::VRSettings()->SetBool(
+                k_toggleSection, k_toggleKey, ( tick / 16 ) % 2 == 0 );
+        }
+        utils::tickRecording.beginTick();
+        recorded.push_back( runTick( dashboard ) );
+        utils::tickRecording.endTick();
+    }
+    utils::tickRecording.stop();
+    const auto recordCalls = totalRuntimeCalls( countsPath );
+
+    // Whatever the runtime answers now differs from the recording.
+    vr::VRSettings()->SetBool( k_toggleSection, k_toggleKey, true );
+    vr::VRSettings()->SetFloat(
+        vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_SupersampleScale_Float,
+        2.5f );
+    vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(
+        vr::TrackingUniverseStanding, 0.0f, nullptr, 0 );
+    OvrasStub_ResetCallCounts();
+
+    if ( !utils::tickRecording.startReplay( recordingPath ) )
+    {
+        return 1;
+    }
+    std::size_t replayed = 0;
+    std::size_t mismatches = 0;
+    while ( utils::tickRecording.beginTick() )
+    {
+        const auto answers = runTick( dashboard );
+        if ( replayed >= recorded.size() || answers != recorded[replayed] )
+        {
+            if ( mismatches == 0 )
+            {
+                std::printf( "first mismatch at tick %zu\n", replayed );
+            }
+            ++mismatches;
+        }
+        ++replayed;
+        utils::tickRecording.endTick();
+    }
+    utils::tickRecording.stop();
+    const auto replayCalls = totalRuntimeCalls( countsPath );
+
+    // A live tick has to see the changed state, otherwise the comparison
+    // above proves nothing.
+    const auto liveDiffers = runTick( dashboard ) != recorded.back();
+
+    std::printf( "recorded ticks     %zu\n", recorded.size() );
+    std::printf( "replayed ticks     %zu\n", replayed );
+    std::printf( "bytes per tick     %zu\n", recorded.front().size() );
+    std::printf( "mismatched ticks   %zu\n", mismatches );
+    std::printf( "live tick differs  %s\n", liveDiffers ? "yes" : "no" );
+    std::printf( "runtime calls      record %llu, replay %llu\n",
+                 static_cast<unsigned long long>( recordCalls ),
+                 static_cast<unsigned long long>( replayCalls ) );
+
+    vr::VR_Shutdown();
+    std::remove( countsPath.c_str() );
+    std::remove( recordingPath.c_str() );
+
+    const auto failed = replayed != recorded.size() || mismatches != 0
+                        || replayCalls != 0 || !liveDiffers;
+    std::printf( "%s\n", failed ? "FAIL" : "PASS" );
+    return failed ? 1 : 0;
+}
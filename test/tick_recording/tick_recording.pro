@@ -0,0 +1,24 @@
+# Record -> replay round trip of utils::TickRecording and the recorded
+# runtime queries. Runs against the OpenVR stub, build test/openvr_stub first.
+TEMPLATE = app
+TARGET = tick_recording
+
+CONFIG += c++1z warn_on console testcase
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../../third-party/openvr/headers ../../src/utils
+INCLUDEPATH += ../../third-party/easylogging++
+DEFINES += ELPP_THREAD_SAFE ELPP_NO_DEFAULT_LOG_FILE
+
+LIBS += -L$$OUT_PWD/../openvr_stub -lopenvr_api -lpthread
+QMAKE_RPATHDIR += $$OUT_PWD/../openvr_stub
+
+SOURCES += \
+    tick_recording.cpp \
+    ../../src/utils/tick_recording.cpp \
+    ../../src/openvr/ovr_recorded_queries.cpp \
+    ../../third-party/easylogging++/easylogging++.cc
+
+HEADERS += \
+    ../../src/utils/tick_recording.h \
+    ../../src/openvr/ovr_recorded_queries.h
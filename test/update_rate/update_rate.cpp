@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include "frame_budget_governor.h"
+#include "update_rate.h"
+
+/* Runs UpdateRate on simulated ticks and checks that every subject keeps
+ * running, from 90 Hz down to the slowest custom tick rate, and with the
+ * frame budget governor deferring work on every tick.
+ *
+ * A subject may wait one period until it is due and one more until it is
+ * starving; after that the subjects that are due ahead of it get a tick each
+ * at most. When the governor holds a subject back it runs anyway once
+ * k_maxConsecutiveDeferrals ticks in a row were deferred.
+ */
+namespace
+{
+using Clock = UpdateRate::Clock;
+using std::chrono::milliseconds;
+
+constexpr auto k_subjectCount
+    = static_cast<std::size_t>( UpdateSubject::LAST_ENUMERATOR ) + 1;
+constexpr auto k_simulatedTime = std::chrono::minutes( 5 );
+// The longest period any subject has, from update_rate.cpp.
+constexpr auto k_longestPeriod = milliseconds( 1750 );
+
+const char* subjectName( const std::size_t subject )
+{
+    static constexpr std::array<const char*, k_subjectCount> names
+        = { "Alarm",   "Audio",     "Chaperone", "Settings",
+            "SteamVR", "Utilities", "Video" };
+    return names[subject];
+}
+
+// beforeTick and afterTick run around UpdateRate::beginTick.
+template <typename BeforeTick, typename AfterTick>
+bool runTicks( const char* name,
+               const milliseconds tickPeriod,
+               const Clock::duration allowedGap,
+               const UpdateRate::SubjectFilter mayRun,
+               BeforeTick&& beforeTick,
+               AfterTick&& afterTick )
+{
+    UpdateRate rate;
+    const auto start = Clock::now();
+    std::array<std::size_t, k_subjectCount> runs{};
+    std::array<Clock::time_point, k_subjectCount> lastRun;
+    lastRun.fill( start );
+    std::array<Clock::duration, k_subjectCount> longestGap{};
+
+    for ( auto now = start; now < start + k_simulatedTime; now += tickPeriod )
+    {
+        beforeTick( now );
+        rate.beginTick( now, mayRun );
+        for ( std::size_t i = 0; i < k_subjectCount; ++i )
+        {
+            if ( rate.shouldSubjectRun( static_cast<UpdateSubject>( i ) ) )
+            {
+                ++runs[i];
+                longestGap[i] = std::max( longestGap[i], now - lastRun[i] );
+                lastRun[i] = now;
+            }
+        }
+        afterTick( now );
+    }
+
+    bool passed = true;
+    std::printf( "%-10s %4lld ms ticks:",
+                 name,
+                 static_cast<long long>( tickPeriod.count() ) );
+    for ( std::size_t i = 0; i < k_subjectCount; ++i )
+    {
+        const auto gapMs
+            = std::chrono::duration_cast<milliseconds>( longestGap[i] );
+        std::printf( " %s %zu (%lld ms)",
+                     subjectName( i ),
+                     runs[i],
+                     static_cast<long long>( gapMs.count() ) );
+        if ( runs[i] == 0 || longestGap[i] > allowedGap )
+        {
+            passed = false;
+        }
+    }
+    std::printf( "%s\n", passed ? "" : " FAILED" );
+    return passed;
+}
+
+bool runUnloaded( const milliseconds tickPeriod )
+{
+    const auto allowedGap
+        = 2 * k_longestPeriod
+          + static_cast<int>( k_subjectCount + 1 ) * tickPeriod;
+    return runTicks(
+        "unloaded",
+        tickPeriod,
+        allowedGap,
+        nullptr,
+        []( Clock::time_point ) {},
+        []( Clock::time_point ) {} );
+}
+
+// Every tick takes twice the frame budget, so the governor defers every
+// deferrable subject it is asked about.
+bool runOverloaded( const milliseconds tickPeriod )
+{
+    auto& governor = utils::frameBudgetGovernor;
+    governor.resetCounters();
+    governor.setFramePeriod( tickPeriod / 2 );
+    const auto forcedEvery = static_cast<int>(
+        utils::FrameBudgetGovernor::k_maxConsecutiveDeferrals + 1 );
+    const auto allowedGap
+        = 2 * k_longestPeriod
+          + static_cast<int>( k_subjectCount + 1 ) * forcedEvery * tickPeriod;
+    const auto passed = runTicks(
+        "overloaded",
+        tickPeriod,
+        allowedGap,
+        utils::withinBudget,
+        [&governor]( const Clock::time_point now )
+        { governor.beginTick( now ); },
+        [&governor, tickPeriod]( const Clock::time_point now )
+        { governor.endTick( now + tickPeriod ); } );
+    const auto& counters = governor.counters();
+    return passed && counters.ticksOverBudget == counters.ticks;
+}
+
+} // namespace
+
+int main()
+{
+    bool passed = true;
+    for ( const auto tickPeriod : { 11, 50, 200, 500, 999 } )
+    {
+        passed = runUnloaded( milliseconds( tickPeriod ) ) && passed;
+    }
+    for ( const auto tickPeriod : { 11, 20, 50 } )
+    {
+        passed = runOverloaded( milliseconds( tickPeriod ) ) && passed;
+    }
+    return passed ? 0 : 1;
+}
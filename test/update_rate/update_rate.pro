@@ -0,0 +1,18 @@
+# Scheduling of the periodic subjects by UpdateRate on simulated ticks, with
+# and without the frame budget governor deferring work.
+TEMPLATE = app
+TARGET = update_rate
+
+CONFIG += c++1z warn_on console testcase
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../../src/utils
+
+SOURCES += \
+    update_rate.cpp \
+    ../../src/utils/update_rate.cpp \
+    ../../src/utils/frame_budget_governor.cpp
+
+HEADERS += \
+    ../../src/utils/update_rate.h \
+    ../../src/utils/frame_budget_governor.h